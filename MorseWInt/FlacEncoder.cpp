@@ -0,0 +1,730 @@
+#include "flacencoder.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+/**
+* C++ FlacEncoder Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+// subframe types
+static const uint32_t SUBFRAME_CONSTANT = 0;
+static const uint32_t SUBFRAME_VERBATIM = 1;
+static const uint32_t SUBFRAME_FIXED = 8;  // 001xxx, xxx = order
+static const uint32_t SUBFRAME_LPC = 32;   // 1xxxxx, xxxxx = order - 1
+
+// channel assignments
+static const uint32_t CHANNELS_MONO = 0;
+static const uint32_t CHANNELS_STEREO = 1;
+static const uint32_t CHANNELS_LEFT_SIDE = 8;
+
+/**
+* Constructor
+*
+* @param out
+* @param channels
+* @param samples_per_second
+* @param total_frames
+*/
+FlacEncoder::FlacEncoder(ostream& out, int channels, uint32_t samples_per_second, uint64_t total_frames)
+    : Out(out)
+{
+    NumChannels = (channels == 2) ? 2 : 1;
+    Sps = samples_per_second;
+    TotalFrames = total_frames;
+    pending.reserve(BLOCK_SIZE * NumChannels);
+    channel[0].resize(BLOCK_SIZE);
+    channel[1].resize(BLOCK_SIZE);
+    residual.resize(BLOCK_SIZE);
+    folded.resize(BLOCK_SIZE);
+
+    Start = Out.tellp();
+    Out.write("fLaC", 4);
+    uint8_t nomd5[16] = { 0 };
+    WriteStreamInfo(nomd5);
+}
+
+/**
+* Write the STREAMINFO metadata block (the only and last one)
+*
+* @param md5sum
+*/
+void FlacEncoder::WriteStreamInfo(const uint8_t md5sum[16])
+{
+    BitWriter w;
+    w.Put(1, 1);     // last metadata block
+    w.Put(0, 7);     // STREAMINFO
+    w.Put(34, 24);   // block length
+    w.Put(BLOCK_SIZE, 16);
+    w.Put(BLOCK_SIZE, 16);
+    w.Put(MaxFrameBytes ? MinFrameBytes : 0, 24);
+    w.Put(MaxFrameBytes, 24);
+    w.Put(Sps, 20);
+    w.Put(NumChannels - 1, 3);
+    w.Put(16 - 1, 5);
+    w.Put(static_cast<uint32_t>(TotalFrames >> 32) & 0xF, 4);
+    w.Put(static_cast<uint32_t>(TotalFrames & 0xFFFFFFFF), 32);
+    for (int i = 0; i < 16; ++i) w.Put(md5sum[i], 8);
+    Out.write(reinterpret_cast<const char*>(w.bytes.data()), w.bytes.size());
+}
+
+/**
+* Encode interleaved 16 bit samples
+*
+* @param pcm
+* @param frames
+*/
+void FlacEncoder::Write(const int16_t* pcm, size_t frames)
+{
+    md5.Update(reinterpret_cast<const uint8_t*>(pcm), frames * NumChannels * sizeof(int16_t));
+    const size_t block = BLOCK_SIZE * NumChannels;
+    size_t count = frames * NumChannels;
+
+    // complete a started block first
+    if (!pending.empty())
+    {
+        size_t take = min(count, block - pending.size());
+        pending.insert(pending.end(), pcm, pcm + take);
+        pcm += take;
+        count -= take;
+        if (pending.size() < block) return;
+        EncodeFrame(pending.data(), BLOCK_SIZE);
+        pending.clear();
+    }
+    // whole blocks straight from the input
+    while (count >= block)
+    {
+        EncodeFrame(pcm, BLOCK_SIZE);
+        pcm += block;
+        count -= block;
+    }
+    pending.insert(pending.end(), pcm, pcm + count);
+}
+
+/**
+* Encode the last partial block and rewrite STREAMINFO with sizes and MD5
+*/
+void FlacEncoder::Finish()
+{
+    if (!pending.empty())
+    {
+        EncodeFrame(pending.data(), static_cast<uint32_t>(pending.size() / NumChannels));
+        pending.clear();
+    }
+    uint8_t digest[16];
+    md5.Final(digest);
+    TotalFrames = Samples;
+
+    streampos end = Out.tellp();
+    Out.seekp(Start + streamoff(4));
+    WriteStreamInfo(digest);
+    Out.seekp(end);
+    Out.flush();
+    if (!Out) throw runtime_error("Error writing FLAC stream");
+}
+
+/**
+* Encode one frame of n samples per channel
+*
+* @param pcm
+* @param n
+*/
+void FlacEncoder::EncodeFrame(const int16_t* pcm, uint32_t n)
+{
+    // split channels, identical channels (our stereo) give an all zero side channel
+    uint32_t assignment = CHANNELS_MONO;
+    if (NumChannels == 2)
+    {
+        bool same = true;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            channel[0][i] = pcm[i * 2];
+            channel[1][i] = pcm[i * 2 + 1];
+            same &= (pcm[i * 2] == pcm[i * 2 + 1]);
+        }
+        assignment = CHANNELS_STEREO;
+        if (same)
+        {
+            assignment = CHANNELS_LEFT_SIDE;
+            fill(channel[1].begin(), channel[1].begin() + n, 0);
+        }
+    }
+    else
+    {
+        for (uint32_t i = 0; i < n; ++i) channel[0][i] = pcm[i];
+    }
+
+    // frame header
+    frame.Clear();
+    frame.Put(0x3FFE, 14);                    // sync code
+    frame.Put(0, 1);                          // reserved
+    frame.Put(0, 1);                          // fixed block size
+    frame.Put(n == BLOCK_SIZE ? 10 : 7, 4);   // 1024 or 16 bit size at end of header
+    frame.Put(Sps <= 0xFFFF ? 13 : 0, 4);     // 16 bit rate in Hz at end of header
+    frame.Put(assignment, 4);
+    frame.Put(4, 3);                          // 16 bits per sample
+    frame.Put(0, 1);                          // reserved
+
+    // frame number, utf-8 style coded
+    uint32_t num = static_cast<uint32_t>(FrameNumber);
+    if (num < 0x80)
+    {
+        frame.Put(num, 8);
+    }
+    else
+    {
+        int extra = (num < 0x800) ? 1 : (num < 0x10000) ? 2 : (num < 0x200000) ? 3 : (num < 0x4000000) ? 4 : 5;
+        uint32_t lead = (0xFF00u >> (extra + 1)) & 0xFF;
+        frame.Put(lead | (num >> (6 * extra)), 8);
+        for (int i = extra - 1; i >= 0; --i) frame.Put(0x80 | ((num >> (6 * i)) & 0x3F), 8);
+    }
+    if (n != BLOCK_SIZE) frame.Put(n - 1, 16);
+    if (Sps <= 0xFFFF) frame.Put(Sps, 16);
+    frame.Put(Crc8(frame.bytes.data(), frame.bytes.size()), 8);
+
+    // subframes
+    EncodeSubframe(channel[0].data(), n, 16);
+    if (NumChannels == 2)
+    {
+        EncodeSubframe(channel[1].data(), n, assignment == CHANNELS_LEFT_SIDE ? 17 : 16);
+    }
+
+    // footer
+    frame.Align();
+    uint16_t crc = Crc16(frame.bytes.data(), frame.bytes.size());
+    frame.Put(crc, 16);
+
+    Out.write(reinterpret_cast<const char*>(frame.bytes.data()), frame.bytes.size());
+    uint32_t size = static_cast<uint32_t>(frame.bytes.size());
+    MinFrameBytes = min(MinFrameBytes, size);
+    MaxFrameBytes = max(MaxFrameBytes, size);
+    FrameNumber++;
+    Samples += n;
+}
+
+/**
+* Encode one subframe with the cheapest of constant, fixed, lpc and verbatim
+*
+* @param x
+* @param n
+* @param bps
+*/
+void FlacEncoder::EncodeSubframe(const int32_t* x, uint32_t n, int bps)
+{
+    // constant: silence
+    bool constant = true;
+    for (uint32_t i = 1; i < n && constant; ++i) constant = (x[i] == x[0]);
+    if (constant)
+    {
+        frame.Put(0, 1);
+        frame.Put(SUBFRAME_CONSTANT, 6);
+        frame.Put(0, 1);
+        frame.PutSigned(x[0], bps);
+        return;
+    }
+
+    uint64_t bestBits = static_cast<uint64_t>(n) * bps;
+    uint32_t bestType = SUBFRAME_VERBATIM;
+    int bestOrder = 0;
+    int bestPartition = 0;
+    int partition = 0;
+
+    // fixed polynomial predictors
+    for (int order = 0; order <= 4 && static_cast<uint32_t>(order) < n; ++order)
+    {
+        if (!FixedResidual(x, n, order)) continue;
+        uint64_t bits = static_cast<uint64_t>(order) * bps + ResidualBits(residual.data(), n, order, partition);
+        if (bits < bestBits)
+        {
+            bestBits = bits;
+            bestType = SUBFRAME_FIXED;
+            bestOrder = order;
+            bestPartition = partition;
+        }
+    }
+
+    // lpc predictors, order 2 fits a pure tone
+    double lpc[MAX_LPC_ORDER][MAX_LPC_ORDER];
+    int32_t qlp[MAX_LPC_ORDER];
+    int32_t bestQlp[MAX_LPC_ORDER];
+    int bestShift = 0;
+    int maxOrder = (n > static_cast<uint32_t>(MAX_LPC_ORDER) * 2) ? Levinson(x, n, lpc) : 0;
+    for (int order = 1; order <= maxOrder; order *= 2)
+    {
+        int shift;
+        Quantize(lpc[order - 1], order, qlp, shift);
+        if (shift < 0 || !LpcResidual(x, n, order, qlp, shift)) continue;
+        uint64_t bits = static_cast<uint64_t>(order) * (bps + QLP_PRECISION) + 9 + ResidualBits(residual.data(), n, order, partition);
+        if (bits < bestBits)
+        {
+            bestBits = bits;
+            bestType = SUBFRAME_LPC;
+            bestOrder = order;
+            bestPartition = partition;
+            bestShift = shift;
+            copy(qlp, qlp + order, bestQlp);
+        }
+    }
+
+    frame.Put(0, 1);
+    if (bestType == SUBFRAME_VERBATIM)
+    {
+        frame.Put(SUBFRAME_VERBATIM, 6);
+        frame.Put(0, 1);
+        for (uint32_t i = 0; i < n; ++i) frame.PutSigned(x[i], bps);
+        return;
+    }
+    if (bestType == SUBFRAME_FIXED)
+    {
+        frame.Put(SUBFRAME_FIXED | bestOrder, 6);
+        frame.Put(0, 1);
+        for (int i = 0; i < bestOrder; ++i) frame.PutSigned(x[i], bps);
+        FixedResidual(x, n, bestOrder);
+    }
+    else
+    {
+        frame.Put(SUBFRAME_LPC | (bestOrder - 1), 6);
+        frame.Put(0, 1);
+        for (int i = 0; i < bestOrder; ++i) frame.PutSigned(x[i], bps);
+        frame.Put(QLP_PRECISION - 1, 4);
+        frame.PutSigned(bestShift, 5);
+        for (int i = 0; i < bestOrder; ++i) frame.PutSigned(bestQlp[i], QLP_PRECISION);
+        LpcResidual(x, n, bestOrder, bestQlp, bestShift);
+    }
+    WriteResidual(residual.data(), n, bestOrder, bestPartition);
+}
+
+/**
+* Residual of a fixed polynomial predictor
+*
+* @param x
+* @param n
+* @param order
+* @return bool
+*/
+bool FlacEncoder::FixedResidual(const int32_t* x, uint32_t n, int order)
+{
+    int32_t* r = residual.data();
+    switch (order)
+    {
+    case 0: for (uint32_t i = 0; i < n; ++i) r[i] = x[i]; break;
+    case 1: for (uint32_t i = 1; i < n; ++i) r[i] = x[i] - x[i - 1]; break;
+    case 2: for (uint32_t i = 2; i < n; ++i) r[i] = x[i] - 2 * x[i - 1] + x[i - 2]; break;
+    case 3: for (uint32_t i = 3; i < n; ++i) r[i] = x[i] - 3 * x[i - 1] + 3 * x[i - 2] - x[i - 3]; break;
+    case 4: for (uint32_t i = 4; i < n; ++i) r[i] = x[i] - 4 * x[i - 1] + 6 * x[i - 2] - 4 * x[i - 3] + x[i - 4]; break;
+    default: return false;
+    }
+    return true;
+}
+
+/**
+* Levinson-Durbin recursion on the block autocorrelation,
+* lpc[o - 1] holds the coefficients of order o
+*
+* @param x
+* @param n
+* @param lpc
+* @return int - highest usable order
+*/
+int FlacEncoder::Levinson(const int32_t* x, uint32_t n, double lpc[MAX_LPC_ORDER][MAX_LPC_ORDER])
+{
+    double autoc[MAX_LPC_ORDER + 1];
+    for (int lag = 0; lag <= MAX_LPC_ORDER; ++lag)
+    {
+        double sum = 0.0;
+        for (uint32_t i = lag; i < n; ++i) sum += static_cast<double>(x[i]) * x[i - lag];
+        autoc[lag] = sum;
+    }
+    if (autoc[0] <= 0.0) return 0;
+
+    double a[MAX_LPC_ORDER] = { 0 };
+    double err = autoc[0];
+    int order = 0;
+    for (int i = 0; i < MAX_LPC_ORDER; ++i)
+    {
+        double acc = autoc[i + 1];
+        for (int j = 0; j < i; ++j) acc -= a[j] * autoc[i - j];
+        double k = acc / err;
+        double prev[MAX_LPC_ORDER];
+        copy(a, a + i, prev);
+        a[i] = k;
+        for (int j = 0; j < i; ++j) a[j] = prev[j] - k * prev[i - 1 - j];
+        err *= (1.0 - k * k);
+        copy(a, a + i + 1, lpc[i]);
+        order = i + 1;
+        if (err <= 0.0) break; // exact fit, higher orders add nothing
+    }
+    return order;
+}
+
+/**
+* Quantize lpc coefficients to QLP_PRECISION bits with error feedback
+*
+* @param lpc
+* @param order
+* @param qlp
+* @param shift - -1 when the coefficients can not be represented
+*/
+void FlacEncoder::Quantize(const double* lpc, int order, int32_t* qlp, int& shift)
+{
+    const int32_t qmax = (1 << (QLP_PRECISION - 1)) - 1;
+    double cmax = 0.0;
+    for (int i = 0; i < order; ++i) cmax = max(cmax, fabs(lpc[i]));
+    if (cmax <= 0.0)
+    {
+        shift = -1;
+        return;
+    }
+    int log2cmax;
+    frexp(cmax, &log2cmax);
+    shift = min((QLP_PRECISION - 1) - log2cmax, 15);
+    if (shift < 0)
+    {
+        shift = -1;
+        return;
+    }
+    double error = 0.0;
+    for (int i = 0; i < order; ++i)
+    {
+        error += lpc[i] * (1 << shift);
+        long q = lround(error);
+        if (q > qmax) q = qmax;
+        else if (q < -qmax - 1) q = -qmax - 1;
+        error -= q;
+        qlp[i] = static_cast<int32_t>(q);
+    }
+}
+
+/**
+* Residual of a quantized lpc predictor, same integer math as the decoder
+*
+* @param x
+* @param n
+* @param order
+* @param qlp
+* @param shift
+* @return bool - false when the residual does not fit
+*/
+bool FlacEncoder::LpcResidual(const int32_t* x, uint32_t n, int order, const int32_t* qlp, int shift)
+{
+    int32_t* r = residual.data();
+    for (uint32_t i = order; i < n; ++i)
+    {
+        int64_t sum = 0;
+        for (int j = 0; j < order; ++j) sum += static_cast<int64_t>(qlp[j]) * x[i - 1 - j];
+        int64_t value = static_cast<int64_t>(x[i]) - (sum >> shift);
+        if (value > (1 << 30) || value < -(1 << 30)) return false;
+        r[i] = static_cast<int32_t>(value);
+    }
+    return true;
+}
+
+/**
+* Best rice parameter for a partition, bits ~ count * (k + 1) + sum >> k
+*
+* @param sum
+* @param count
+* @param bits
+* @return int
+*/
+static int RiceParameter(uint64_t sum, uint32_t count, uint64_t& bits)
+{
+    int best = 0;
+    bits = UINT64_MAX;
+    for (int k = 0; k <= 14; ++k)
+    {
+        uint64_t b = static_cast<uint64_t>(count) * (k + 1) + (sum >> k);
+        if (b < bits)
+        {
+            bits = b;
+            best = k;
+        }
+    }
+    return best;
+}
+
+/**
+* Estimate residual bits and choose the rice partition order
+*
+* @param r
+* @param n
+* @param order
+* @param partitionOrder
+* @return uint64_t
+*/
+uint64_t FlacEncoder::ResidualBits(const int32_t* r, uint32_t n, int order, int& partitionOrder)
+{
+    int maxPo = 0;
+    while (maxPo < 8 && (n % (2u << maxPo)) == 0 && (n >> (maxPo + 1)) > static_cast<uint32_t>(order)) maxPo++;
+
+    // sums per partition at the highest order, then merge pairs
+    uint64_t sums[256];
+    uint32_t counts[256];
+    uint32_t parts = 1u << maxPo;
+    uint32_t size = n >> maxPo;
+    for (uint32_t p = 0; p < parts; ++p)
+    {
+        uint32_t from = (p == 0) ? order : p * size;
+        uint32_t to = (p + 1) * size;
+        uint64_t sum = 0;
+        for (uint32_t i = from; i < to; ++i)
+        {
+            uint32_t u = (static_cast<uint32_t>(r[i]) << 1) ^ static_cast<uint32_t>(r[i] >> 31);
+            folded[i] = u;
+            sum += u;
+        }
+        sums[p] = sum;
+        counts[p] = to - from;
+    }
+
+    uint64_t best = UINT64_MAX;
+    for (int po = maxPo; po >= 0; --po)
+    {
+        uint64_t total = 6; // coding method and partition order
+        uint32_t np = 1u << po;
+        for (uint32_t p = 0; p < np; ++p)
+        {
+            uint64_t bits;
+            RiceParameter(sums[p], counts[p], bits);
+            total += 4 + bits;
+        }
+        if (total < best)
+        {
+            best = total;
+            partitionOrder = po;
+        }
+        for (uint32_t p = 0; p < np / 2; ++p)
+        {
+            sums[p] = sums[2 * p] + sums[2 * p + 1];
+            counts[p] = counts[2 * p] + counts[2 * p + 1];
+        }
+    }
+    return best;
+}
+
+/**
+* Write rice coded residual, folded[] was filled by ResidualBits
+*
+* @param r
+* @param n
+* @param order
+* @param partitionOrder
+*/
+void FlacEncoder::WriteResidual(const int32_t* r, uint32_t n, int order, int partitionOrder)
+{
+    frame.Put(0, 2); // rice, 4 bit parameters
+    frame.Put(partitionOrder, 4);
+    uint32_t parts = 1u << partitionOrder;
+    uint32_t size = n >> partitionOrder;
+    for (uint32_t p = 0; p < parts; ++p)
+    {
+        uint32_t from = (p == 0) ? order : p * size;
+        uint32_t to = (p + 1) * size;
+        uint64_t sum = 0;
+        for (uint32_t i = from; i < to; ++i)
+        {
+            folded[i] = (static_cast<uint32_t>(r[i]) << 1) ^ static_cast<uint32_t>(r[i] >> 31);
+            sum += folded[i];
+        }
+        uint64_t bits;
+        int k = RiceParameter(sum, to - from, bits);
+        frame.Put(k, 4);
+        for (uint32_t i = from; i < to; ++i) frame.PutRice(folded[i], k);
+    }
+}
+
+/**
+* CRC-8, polynomial x^8 + x^2 + x + 1
+*
+* @param data
+* @param size
+* @return uint8_t
+*/
+uint8_t FlacEncoder::Crc8(const uint8_t* data, size_t size)
+{
+    uint8_t crc = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc ^= data[i];
+        for (int b = 0; b < 8; ++b) crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+    }
+    return crc;
+}
+
+/**
+* CRC-16, polynomial x^16 + x^15 + x^2 + 1
+*
+* @param data
+* @param size
+* @return uint16_t
+*/
+uint16_t FlacEncoder::Crc16(const uint8_t* data, size_t size)
+{
+    static uint16_t table[256];
+    static bool init = false;
+    if (!init)
+    {
+        for (int i = 0; i < 256; ++i)
+        {
+            uint16_t crc = static_cast<uint16_t>(i << 8);
+            for (int b = 0; b < 8; ++b) crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x8005) : static_cast<uint16_t>(crc << 1);
+            table[i] = crc;
+        }
+        init = true;
+    }
+    uint16_t crc = 0;
+    for (size_t i = 0; i < size; ++i) crc = static_cast<uint16_t>((crc << 8) ^ table[(crc >> 8) ^ data[i]]);
+    return crc;
+}
+
+// ---------------- BitWriter ----------------
+
+void FlacEncoder::BitWriter::Put(uint32_t value, int bits)
+{
+    if (bits == 0) return;
+    acc = (acc << bits) | (static_cast<uint64_t>(value) & ((1ull << bits) - 1));
+    count += bits;
+    while (count >= 8)
+    {
+        count -= 8;
+        bytes.push_back(static_cast<uint8_t>(acc >> count));
+    }
+}
+
+void FlacEncoder::BitWriter::PutSigned(int32_t value, int bits)
+{
+    Put(static_cast<uint32_t>(value), bits);
+}
+
+void FlacEncoder::BitWriter::PutRice(uint32_t value, int k)
+{
+    uint32_t q = value >> k;
+    while (q >= 32)
+    {
+        Put(0, 32);
+        q -= 32;
+    }
+    Put(1, q + 1); // q zeros and the stop bit
+    Put(value, k);
+}
+
+void FlacEncoder::BitWriter::Align()
+{
+    if (count > 0) Put(0, 8 - count);
+}
+
+void FlacEncoder::BitWriter::Clear()
+{
+    bytes.clear();
+    acc = 0;
+    count = 0;
+}
+
+// ---------------- MD5 (RFC 1321) ----------------
+
+static const uint32_t MD5_K[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee,
+    0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+    0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa,
+    0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed,
+    0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+    0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05,
+    0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039,
+    0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+    0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+};
+
+static const int MD5_R[64] = {
+    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+    5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+};
+
+FlacEncoder::Md5::Md5()
+{
+    state[0] = 0x67452301;
+    state[1] = 0xefcdab89;
+    state[2] = 0x98badcfe;
+    state[3] = 0x10325476;
+}
+
+void FlacEncoder::Md5::Transform(const uint8_t block[64])
+{
+    uint32_t m[16];
+    for (int i = 0; i < 16; ++i)
+    {
+        m[i] = block[i * 4] | (block[i * 4 + 1] << 8) | (block[i * 4 + 2] << 16) | (static_cast<uint32_t>(block[i * 4 + 3]) << 24);
+    }
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    for (int i = 0; i < 64; ++i)
+    {
+        uint32_t f;
+        int g;
+        if (i < 16) { f = (b & c) | (~b & d); g = i; }
+        else if (i < 32) { f = (d & b) | (~d & c); g = (5 * i + 1) & 15; }
+        else if (i < 48) { f = b ^ c ^ d; g = (3 * i + 5) & 15; }
+        else { f = c ^ (b | ~d); g = (7 * i) & 15; }
+        uint32_t t = d;
+        d = c;
+        c = b;
+        uint32_t x = a + f + MD5_K[i] + m[g];
+        b = b + ((x << MD5_R[i]) | (x >> (32 - MD5_R[i])));
+        a = t;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+}
+
+void FlacEncoder::Md5::Update(const uint8_t* data, size_t size)
+{
+    size_t used = static_cast<size_t>(length & 63);
+    length += size;
+    if (used > 0)
+    {
+        size_t take = min(size, 64 - used);
+        memcpy(buffer + used, data, take);
+        data += take;
+        size -= take;
+        if (used + take < 64) return;
+        Transform(buffer);
+    }
+    while (size >= 64)
+    {
+        Transform(data);
+        data += 64;
+        size -= 64;
+    }
+    memcpy(buffer, data, size);
+}
+
+void FlacEncoder::Md5::Final(uint8_t digest[16])
+{
+    uint64_t bits = length * 8;
+    uint8_t pad[72] = { 0x80 };
+    size_t used = static_cast<size_t>(length & 63);
+    size_t padLen = (used < 56) ? (56 - used) : (120 - used);
+    Update(pad, padLen);
+    uint8_t len[8];
+    for (int i = 0; i < 8; ++i) len[i] = static_cast<uint8_t>(bits >> (8 * i));
+    Update(len, 8);
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = 0; j < 4; ++j) digest[i * 4 + j] = static_cast<uint8_t>(state[i] >> (8 * j));
+    }
+}
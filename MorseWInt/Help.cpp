@@ -37,10 +37,64 @@ string Help::GetHelpTxt()
 	str += " b, d             Binary Morse(0 1 <space>)\n";
 	str += " he, hd           Hex Morse(2E 2D 20)\n";
 	str += " hb, hbd          Hex Binary Morse(30 31 20)\n";
+	str += " eb, db           Bit-packed .mbin file  db reads the file path\n";
+	str += " -char:N, -word:N With db: seek to character or word N\n";
+	str += " -n:N             With db: decode N characters or words\n";
 	str += "\n";
 	str += " AUDIO OUTPUT:\n";
 	str += " ew               Morse to WAV(Stereo)   Creates WAV file\n";
 	str += " ewm              Morse to WAV(Mono)     Creates WAV file\n";
+	str += " ep               Morse to sound card    Plays at once, no file;\n";
+	str += "                  -hz, -wpm, -sps and -ramp apply\n";
+	str += " et               Live keying(sidetone)  Sends each key as it is typed,\n";
+	str += "                  Esc stops; or the text given or piped in\n";
+	str += " -sink:null|path  With ep/et: timed null output or a WAV file\n";
+	str += " -flac            With ew/ewm: write lossless FLAC instead of WAV\n";
+	str += " -mulaw, -alaw    With ew/ewm: write 8 bit G.711 WAV\n";
+	str += " -adpcm           With ew/ewm: write 4 bit IMA ADPCM WAV\n";
+	str += " -cf32, -cs16     With ew/ewm: write raw complex baseband I/Q for SDR,\n";
+	str += "                  float or 16 bit, at -sps; with -stdout/-raw streamed\n";
+	str += " -offset:Hz       With -cf32/-cs16: keyed carrier offset from centre (0)\n";
+	str += " -stdout          With ew/ewm: stream WAV to stdout instead of a file\n";
+	str += " -raw             With ew/ewm: stream raw 16 bit PCM to stdout\n";
+	str += " -snr:dB          With ew/ewm: add white noise, tone over noise in the\n";
+	str += "                  whole band\n";
+	str += " -fade[:Hz]       With ew/ewm: Rayleigh fading of Hz bandwidth (0.5)\n";
+	str += " -rician:K        With ew/ewm: Rician fading, direct/scattered power K\n";
+	str += " -qsb:dB[,s]      With ew/ewm: slow fading dB deep every s seconds (10)\n";
+	str += " -drift:Hz        With ew/ewm: tone drift in Hz per minute\n";
+	str += " -jitter:x        With ew/ewm: timing jitter, x units standard deviation\n";
+	str += " -seed:N          With ew/ewm: random seed, same seed gives the same file\n";
+	str += " -ramp[:ms][,blackman] With ew/ewm: shaped keying, raised cosine or\n";
+	str += "                  Blackman rise and fall of ms (5, 1 to 50), no key\n";
+	str += "                  clicks, e.g. -ramp or -ramp:,blackman or -ramp:8\n";
+	str += " es, esm          Sweep(Stereo/Mono)     One WAV per -hz x -wpm x -sps\n";
+	str += "                  e.g. -hz:600,880 -wpm:20,30 -sps:8000,44100\n";
+	str += " em               Messages to one WAV    Mixes the messages of a list file,\n";
+	str += "                  one per line: tone wpm amplitude start(s) phase text\n";
+	str += " -dither          With em: TPDF dither to 16 bit, -flac and -sps apply\n";
+	str += " ek               Morse to key events    Creates .mkey (varint) file\n";
+	str += " -csv, -json      With ek: write text events instead of .mkey\n";
+	str += " -us              With ek: durations in microseconds, not samples\n";
+	str += "\n";
+	str += " AUDIO INPUT / DECODING:\n";
+	str += " dw               WAV to Morse + text    Reads PCM or float WAV path\n";
+	str += "                  speed follows the code (-wpm to start),\n";
+	str += "                  tone from -hz or estimated by FFT\n";
+	str += " -mf              With dw/dd/dl: matched filter for weak signals,\n";
+	str += "                  set -wpm to the sending speed\n";
+	str += " -beam[:K]        With dw: beam search over K timing readings,\n";
+	str += "                  for sloppy spacing (default 16)\n";
+	str += " -lm:path         With dw -beam: character bigrams from a text file\n";
+	str += " -chars:path      With dw: each character with start/end sample and\n";
+	str += "                  confidence, .jsonl or binary .mchr\n";
+	str += " ds               WAV to text per signal Skims every tone in the WAV path\n";
+	str += " dd               WAVs to text           Decodes a directory or list file\n";
+	str += "                  of WAVs in parallel, dw options apply\n";
+	str += " -threads:N       With dd: decoding threads (default one per core)\n";
+	str += " -out:dir         With dd: one .txt per WAV instead of stdout\n";
+	str += " dl               Live audio to text     Raw 16 bit mono PCM on stdin at\n";
+	str += "                  -sps, tone -hz, e.g. ewm -raw ... | dl\n";
 	str += "\n";
 	str += " EXAMPLES:\n";
 	str += " .\\morse.exe d \"... ---  ...  ---\"\n";
@@ -49,6 +103,7 @@ string Help::GetHelpTxt()
 	str += "\n Place morse.exe in system32 and you can type:\n";
 	str += " morse ew -wpm:33 -hz:880 -sps:48000 sos sos\n";
 	str += " morse ewm -wpm:50 -hz:880 -sps:11025 paris paris paris\n";
+	str += " morse ewm -raw -sps:8000 cq cq | aplay -f S16_LE -r 8000\n";
     str += " Windows Key + R and morse -h\n";
 	str += "\n";
 	str += " SOUND SETTINGS:\n";
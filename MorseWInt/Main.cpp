@@ -27,6 +27,17 @@ static void MakeMorseSafe(double& tone, int& wpm, int& sps)
     if (wpm > 50.0) wpm = 50.0;
 }
 
+/**
+* Keep keying ramps in range
+*
+* @param rise - ms
+*/
+static void MakeRampSafe(double& rise)
+{
+    if (rise < 1.0) rise = 1.0;
+    if (rise > 50.0) rise = 50.0;
+}
+
 /**
 * Read cmd line user arguments
 *
@@ -57,19 +68,157 @@ int get_options(int argc, char* argv[])
             if (strncmp(argv[2], "-hz:", 4) == 0)
             {
                 frequency_in_hertz = atof(&argv[2][4]);
+                tone_list = &argv[2][4];
             }
             else if (strncmp(argv[2], "-wpm:", 5) == 0)
             {
                 words_per_minute = atof(&argv[2][5]);
+                wpm_list = &argv[2][5];
             }
             else if (strncmp(argv[2], "-sps:", 5) == 0)
             {
                 samples_per_second = atof(&argv[2][5]);
+                sps_list = &argv[2][5];
             }
             else if (strncmp(argv[2], "-lc", 3) == 0)
             {
 				lowercase = 1;
             }
+            else if (strncmp(argv[2], "-flac", 5) == 0)
+            {
+                audio_format = FORMAT_FLAC;
+            }
+            else if (strncmp(argv[2], "-mulaw", 6) == 0)
+            {
+                audio_format = FORMAT_MULAW;
+            }
+            else if (strncmp(argv[2], "-alaw", 5) == 0)
+            {
+                audio_format = FORMAT_ALAW;
+            }
+            else if (strncmp(argv[2], "-adpcm", 6) == 0)
+            {
+                audio_format = FORMAT_IMA_ADPCM;
+            }
+            else if (strncmp(argv[2], "-cf32", 5) == 0)
+            {
+                audio_format = FORMAT_IQ_CF32;
+            }
+            else if (strncmp(argv[2], "-cs16", 5) == 0)
+            {
+                audio_format = FORMAT_IQ_CS16;
+            }
+            else if (strncmp(argv[2], "-offset:", 8) == 0)
+            {
+                iq_offset = atof(&argv[2][8]);
+            }
+            else if (strncmp(argv[2], "-csv", 4) == 0)
+            {
+                keying_format = KEYING_CSV;
+            }
+            else if (strncmp(argv[2], "-json", 5) == 0)
+            {
+                keying_format = KEYING_JSON;
+            }
+            else if (strncmp(argv[2], "-us", 3) == 0)
+            {
+                keying_unit = KEYING_MICROSECONDS;
+            }
+            else if (strncmp(argv[2], "-char:", 6) == 0)
+            {
+                mbin_char = atoll(&argv[2][6]);
+            }
+            else if (strncmp(argv[2], "-word:", 6) == 0)
+            {
+                mbin_word = atoll(&argv[2][6]);
+            }
+            else if (strncmp(argv[2], "-n:", 3) == 0)
+            {
+                mbin_count = atoll(&argv[2][3]);
+            }
+            else if (strncmp(argv[2], "-stdout", 7) == 0)
+            {
+                stream_out = 1;
+            }
+            else if (strncmp(argv[2], "-raw", 4) == 0)
+            {
+                stream_out = 2;
+            }
+            else if (strncmp(argv[2], "-mf", 3) == 0)
+            {
+                matched_filter = 1;
+            }
+            else if (strncmp(argv[2], "-beam", 5) == 0)
+            {
+                beam_width = (argv[2][5] == ':') ? atoi(&argv[2][6]) : MorseBeam::DEFAULT_WIDTH;
+            }
+            else if (strncmp(argv[2], "-lm:", 4) == 0)
+            {
+                bigram_path = &argv[2][4];
+                if (beam_width == 0) beam_width = MorseBeam::DEFAULT_WIDTH;
+            }
+            else if (strncmp(argv[2], "-chars:", 7) == 0)
+            {
+                chars_path = &argv[2][7];
+            }
+            else if (strncmp(argv[2], "-threads:", 9) == 0)
+            {
+                batch_threads = atoi(&argv[2][9]);
+            }
+            else if (strncmp(argv[2], "-out:", 5) == 0)
+            {
+                batch_out = &argv[2][5];
+            }
+            else if (strncmp(argv[2], "-dither", 7) == 0)
+            {
+                mix_dither = 1;
+            }
+            else if (strncmp(argv[2], "-snr:", 5) == 0)
+            {
+                impairment.noise = true;
+                impairment.snr = atof(&argv[2][5]);
+            }
+            else if (strncmp(argv[2], "-fade", 5) == 0)
+            {
+                if (impairment.fading == FADING_NONE) impairment.fading = FADING_RAYLEIGH;
+                if (argv[2][5] == ':') impairment.doppler = atof(&argv[2][6]);
+            }
+            else if (strncmp(argv[2], "-rician:", 8) == 0)
+            {
+                impairment.fading = FADING_RICIAN;
+                impairment.kfactor = atof(&argv[2][8]);
+            }
+            else if (strncmp(argv[2], "-qsb:", 5) == 0)
+            {
+                impairment.qsbDepth = atof(&argv[2][5]);
+                const char* period = strchr(&argv[2][5], ',');
+                if (period) impairment.qsbPeriod = atof(period + 1);
+            }
+            else if (strncmp(argv[2], "-drift:", 7) == 0)
+            {
+                impairment.drift = atof(&argv[2][7]);
+            }
+            else if (strncmp(argv[2], "-jitter:", 8) == 0)
+            {
+                impairment.jitter = atof(&argv[2][8]);
+            }
+            else if (strncmp(argv[2], "-seed:", 6) == 0)
+            {
+                impairment.seed = strtoull(&argv[2][6], nullptr, 10);
+            }
+            else if (strncmp(argv[2], "-sink:", 6) == 0)
+            {
+                play_sink = &argv[2][6];
+            }
+            else if (strncmp(argv[2], "-ramp", 5) == 0 && (argv[2][5] == '\0' || argv[2][5] == ':'))
+            {
+                // -ramp, -ramp:ms, -ramp:,blackman and -ramp:ms,blackman, no ms keeps the default
+                const char* value = (argv[2][5] == ':') ? &argv[2][6] : &argv[2][5];
+                if (*value != '\0' && *value != ',') envelope.rise = atof(value);
+                MakeRampSafe(envelope.rise);
+                const char* shape = strchr(value, ',');
+                envelope.shape = (shape && strcmp(shape + 1, "blackman") == 0) ? RAMP_BLACKMAN : RAMP_COSINE;
+            }
             else
             {
                 break;
@@ -104,6 +253,29 @@ string arg_string(char* arg)
     return str;
 }
 
+/**
+* Parse comma separated list of numbers, e.g. 600,700,880
+*
+* @param list
+* @param defaultVal
+* @return vector
+*/
+vector<double> parse_list(const string& list, double defaultVal)
+{
+    vector<double> values;
+    size_t start = 0;
+    while (start <= list.size() && !list.empty())
+    {
+        size_t end = list.find(',', start);
+        if (end == string::npos) end = list.size();
+        string item = list.substr(start, end - start);
+        if (!item.empty()) values.push_back(atof(item.c_str()));
+        start = end + 1;
+    }
+    if (values.empty()) values.push_back(defaultVal);
+    return values;
+}
+
 /**
 * Parse int from edit field
 *
@@ -384,6 +556,14 @@ static void CreateMorseControls(HWND hWnd)
         hWnd, (HMENU)CID_UPPERCASE, g_hInst, NULL
     );
 
+    // checkbox for live keying, every character typed in the edit box is sent at once
+    hSidetone = CreateWindowExW(
+        0, L"BUTTON", L"Sidetone, key as you type.",
+        WS_CHILD | WS_VISIBLE | BS_AUTOCHECKBOX,
+        225, 405, 185, 20,
+        hWnd, (HMENU)CID_SIDETONE, g_hInst, NULL
+    );
+
     // set default radio button selection
     SendMessageW(hMorse, BM_SETCHECK, BST_CHECKED, 0); // default selection
     // set default checkbox state
@@ -412,6 +592,9 @@ static void CreateMorseControls(HWND hWnd)
     // Create buttons
     HWND hEncodeButton = CreateWindowExW(0, L"BUTTON", L"ENCODE", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON, 15, 355, 185, 40, hWnd, (HMENU)CID_ENCODE, g_hInst, NULL);
     HWND hDecodeButton = CreateWindowExW(0, L"BUTTON", L"DECODE", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON, 225, 355, 185, 40, hWnd, (HMENU)CID_DECODE, g_hInst, NULL);
+    HWND hPlayButton = CreateWindowExW(0, L"BUTTON", L"PLAY", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON, 425, 400, 76, 25, hWnd, (HMENU)CID_PLAY, g_hInst, NULL);
+    HWND hPauseButton = CreateWindowExW(0, L"BUTTON", L"PAUSE", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON, 507, 400, 76, 25, hWnd, (HMENU)CID_PAUSE, g_hInst, NULL);
+    HWND hStopButton = CreateWindowExW(0, L"BUTTON", L"STOP", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON, 589, 400, 76, 25, hWnd, (HMENU)CID_STOP, g_hInst, NULL);
 
     // Set fonts
     SendMessageW(hMorseLabel, WM_SETFONT, (WPARAM)hFontBold, TRUE);
@@ -430,6 +613,9 @@ static void CreateMorseControls(HWND hWnd)
     // Buttons
     SendMessageW(hEncodeButton, WM_SETFONT, (WPARAM)hFontBold, TRUE);
     SendMessageW(hDecodeButton, WM_SETFONT, (WPARAM)hFontBold, TRUE);
+    SendMessageW(hPlayButton, WM_SETFONT, (WPARAM)hFontBold, TRUE);
+    SendMessageW(hPauseButton, WM_SETFONT, (WPARAM)hFontBold, TRUE);
+    SendMessageW(hStopButton, WM_SETFONT, (WPARAM)hFontBold, TRUE);
 
     // Radio buttons
     SendMessageW(hMorse, WM_SETFONT, (WPARAM)hFont, TRUE);
@@ -439,6 +625,7 @@ static void CreateMorseControls(HWND hWnd)
     SendMessageW(hMorseToWavS, WM_SETFONT, (WPARAM)hFont, TRUE);
     SendMessageW(hMorseToWavM, WM_SETFONT, (WPARAM)hFont, TRUE);
     SendMessageW(hUpperCase, WM_SETFONT, (WPARAM)hFont, TRUE);
+    SendMessageW(hSidetone, WM_SETFONT, (WPARAM)hFont, TRUE);
 
     // set default morse settings in edit boxes
     wstring wt = StringToWString(trimDecimals(to_string(frequency_in_hertz), 3));
@@ -489,6 +676,36 @@ static int ShowMorseApp(HWND& hwnd)
     return 0;
 }
 
+/**
+* Keep the handle of a GUI render thread, handles of finished threads are closed
+*
+* @param h
+*/
+static void TrackRenderThread(HANDLE h)
+{
+    auto done = [](HANDLE t)
+    {
+        if (WaitForSingleObject(t, 0) != WAIT_OBJECT_0) return false;
+        CloseHandle(t);
+        return true;
+    };
+    render_threads.erase(remove_if(render_threads.begin(), render_threads.end(), done), render_threads.end());
+    render_threads.push_back(h);
+}
+
+/**
+* Wait for the GUI render threads, they use the render cache and the player
+*/
+static void JoinRenderThreads()
+{
+    for (HANDLE h : render_threads)
+    {
+        WaitForSingleObject(h, INFINITE);
+        CloseHandle(h);
+    }
+    render_threads.clear();
+}
+
 /**
 * Wav thread procedure
 *
@@ -504,7 +721,7 @@ static unsigned __stdcall WavThreadProc(void* pv)
     try
     {
         // Heavy work on background thread
-        MorseWav mw(p->morse.c_str(), p->tone, p->wpm, p->sps, p->channels, p->showExternal);
+        MorseWav mw(p->morse.c_str(), p->tone, p->wpm, p->sps, p->channels, p->showExternal, p->cache, p->format, nullptr, nullptr, p->player);
 
         res->fullPath = StringToWString(mw.GetFullPath());
         FullPath = mw.GetFullPath();
@@ -514,6 +731,7 @@ static unsigned __stdcall WavThreadProc(void* pv)
         res->waveSize = mw.GetWaveSize();
         res->pcmCount = mw.GetPcmCount();
         res->channels = p->channels;
+        res->cached = mw.IsCached();
     }
     catch (const exception& e)
     {
@@ -524,6 +742,7 @@ static unsigned __stdcall WavThreadProc(void* pv)
         res->waveSize = 0;
         res->pcmCount = 0;
         res->channels = p->channels;
+        res->cached = false;
     }
     catch (...)
     {
@@ -534,6 +753,7 @@ static unsigned __stdcall WavThreadProc(void* pv)
         res->waveSize = 0;
         res->pcmCount = 0;
         res->channels = p->channels;
+        res->cached = false;
     }
     PostMessageW(hwnd, WM_MWAV_DONE, reinterpret_cast<WPARAM>(res), 0);
     delete p;
@@ -551,7 +771,8 @@ static unsigned __stdcall ConsoleWavThreadProc(void* pv)
     if (!p) return 0;
     try
     {
-        MorseWav mw(p->morse.c_str(), p->tone, p->wpm, p->sps, p->channels, p->showExternal);
+        MorseWav mw(p->morse.c_str(), p->tone, p->wpm, p->sps, p->channels, p->showExternal, p->cache, p->format, p->impairment, p->envelope, p->player);
+        if (p->cache) cout << p->cache->GetStats() << "\n";
     }
     catch (const exception& e)
     {
@@ -579,6 +800,10 @@ static unsigned __stdcall ConsoleWavThreadProc(void* pv)
 static LRESULT CALLBACK Edit_SelectAll_SubclassProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam,
     UINT_PTR uIdSubclass, DWORD_PTR dwRefData)
 {
+    if (uMsg == WM_CHAR && hwnd == hEdit && sidetone && wParam < 128)
+    {
+        sidetone->Key(static_cast<char>(wParam)); // sent as typed, the edit box gets it too
+    }
     if (uMsg == WM_KEYDOWN)
     {
         // check Ctrl + A (handle both 'A' and 'a')
@@ -629,6 +854,31 @@ static LRESULT CALLBACK MorseWIntWndProc(HWND hWnd, UINT msg, WPARAM wParam, LPA
             return 0;
         }
 
+        if (id == CID_SIDETONE && code == BN_CLICKED)
+        {
+            sidetone.reset();
+            if (SendMessageW(hSidetone, BM_GETCHECK, 0, 0) == BST_CHECKED)
+            {
+                int si = ParseIntFromEdit(hSps, samples_per_second);
+                double ti = ParseDoubleFromEdit(hTone, frequency_in_hertz);
+                int wi = ParseIntFromEdit(hWpm, words_per_minute);
+                MakeMorseSafe(ti, wi, si);
+                try
+                {
+                    sidetone = make_unique<MorseSidetone>(sidetone_out, ti, wi, si, uppercase, &envelope);
+                    sidetone->Start();
+                }
+                catch (const exception& e)
+                {
+                    sidetone.reset();
+                    SendMessageW(hSidetone, BM_SETCHECK, BST_UNCHECKED, 0);
+                    wstring err = StringToWString(string("ERROR: ") + e.what());
+                    SendMessageW(hWavOut, WM_SETTEXT, 0, (LPARAM)err.c_str());
+                }
+            }
+            return 0;
+        }
+
         bool b1 = false, b2 = false, b3 = false, b4 = false, b5 = false, b6 = false, b7 = false, b8 = false;
         if (IsDlgButtonChecked(hWnd, CID_MORSE) == BST_CHECKED) { b1 = true; }
         else if (IsDlgButtonChecked(hWnd, CID_BIN) == BST_CHECKED) { b2 = true; }
@@ -704,10 +954,13 @@ static LRESULT CALLBACK MorseWIntWndProc(HWND hWnd, UINT msg, WPARAM wParam, LPA
                 p->channels = STEREO;
                 p->hwnd = hWnd;
                 p->showExternal = SHOW_EXTERNAL_MEDIAPLAYER;
+                p->cache = render_cache.get();
+                p->format = audio_format;
+                p->player = PLAY_WHILE_RENDERING ? &player : nullptr;
 
                 // start thread (CRT-friendly)
                 uintptr_t h = _beginthreadex(NULL, 0, &WavThreadProc, p, 0, NULL);
-                if (h != 0) CloseHandle(reinterpret_cast<HANDLE>(h));
+                if (h != 0) TrackRenderThread(reinterpret_cast<HANDLE>(h));
             }
             else if (b6)
             {
@@ -741,10 +994,13 @@ static LRESULT CALLBACK MorseWIntWndProc(HWND hWnd, UINT msg, WPARAM wParam, LPA
                 p->channels = MONO;
                 p->hwnd = hWnd;
                 p->showExternal = SHOW_EXTERNAL_MEDIAPLAYER;
+                p->cache = render_cache.get();
+                p->format = audio_format;
+                p->player = PLAY_WHILE_RENDERING ? &player : nullptr;
 
                 // start thread (CRT-friendly)
                 uintptr_t h = _beginthreadex(NULL, 0, &WavThreadProc, p, 0, NULL);
-                if (h != 0) CloseHandle(reinterpret_cast<HANDLE>(h));
+                if (h != 0) TrackRenderThread(reinterpret_cast<HANDLE>(h));
             }
             return 0;
         }
@@ -794,11 +1050,56 @@ static LRESULT CALLBACK MorseWIntWndProc(HWND hWnd, UINT msg, WPARAM wParam, LPA
             }
             return 0;
         }
+        else if (id == CID_PLAY && code == BN_CLICKED)
+        {
+            // play in-process on the sound card: morse in the edit box as it is, text encoded first
+            tmp = WStringToString(in);
+            for (char& c : tmp) if (c == '\r' || c == '\n') c = ' ';
+            if (tmp.find_first_not_of(".- ") != string::npos) tmp = m.morse_encode(tmp);
+
+            int si = ParseIntFromEdit(hSps, samples_per_second);
+            double ti = ParseDoubleFromEdit(hTone, frequency_in_hertz);
+            int wi = ParseIntFromEdit(hWpm, words_per_minute);
+            MakeMorseSafe(ti, wi, si);
+            try
+            {
+                player.Play(tmp, ti, wi, si, MONO, &envelope);
+            }
+            catch (const exception& e)
+            {
+                out = StringToWString(string("ERROR: ") + e.what());
+                SendMessageW(hWavOut, WM_SETTEXT, 0, (LPARAM)out.c_str());
+            }
+            SetDlgItemTextW(hWnd, CID_PAUSE, L"PAUSE");
+            return 0;
+        }
+        else if (id == CID_PAUSE && code == BN_CLICKED)
+        {
+            if (!player.IsPlaying()) return 0;
+            if (player.IsPaused())
+            {
+                player.Resume();
+                SetDlgItemTextW(hWnd, CID_PAUSE, L"PAUSE");
+            }
+            else
+            {
+                player.Pause();
+                SetDlgItemTextW(hWnd, CID_PAUSE, L"RESUME");
+            }
+            return 0;
+        }
+        else if (id == CID_STOP && code == BN_CLICKED)
+        {
+            player.Stop();
+            SetDlgItemTextW(hWnd, CID_PAUSE, L"PAUSE");
+            return 0;
+        }
         break;
     }
     case WM_MWAV_DONE:
     {
         EnableWindow(GetDlgItem(hWnd, CID_PAUSE), TRUE);
+        SetDlgItemTextW(hWnd, CID_PAUSE, L"PAUSE"); // the new file plays from the start
         WavThreadResult* res = reinterpret_cast<WavThreadResult*>(wParam);
         if (res)
         {
@@ -812,6 +1113,7 @@ static LRESULT CALLBACK MorseWIntWndProc(HWND hWnd, UINT msg, WPARAM wParam, LPA
             wout += L"code: " + wpmin + L" Hz (-wpm:" + wpmin + L")\r\n";
             wout += StringToWString(to_string(res->pcmCount * res->channels)) + L" PCM samples in ";
             wout += StringToWString(trimDecimals(to_string(res->pcmCount / stod(spsin)), 2)) + L" s\r\n";
+            if (res->cached) wout += L"(from render cache)\r\n";
 
             SendMessageW(hWavOut, WM_SETTEXT, 0, (LPARAM)wout.c_str());
             SendMessageW(hTone, WM_SETTEXT, 0, (LPARAM)tonein.c_str());
@@ -841,6 +1143,8 @@ static LRESULT CALLBACK MorseWIntWndProc(HWND hWnd, UINT msg, WPARAM wParam, LPA
     }
     case WM_DESTROY:
     {
+        sidetone.reset();
+        player.Stop();
         PostQuitMessage(0);
         return 0;
     }
@@ -853,16 +1157,57 @@ static LRESULT CALLBACK MorseWIntWndProc(HWND hWnd, UINT msg, WPARAM wParam, LPA
 /**
 * Creates new output console
 *
+* @param keepStdout - leave stdout alone when it is piped into another tool
 */
-static void AttachToNewConsole()
+static void AttachToNewConsole(bool keepStdout)
 {
     AllocConsole();
     FILE* fp = nullptr;
-    freopen_s(&fp, "CONOUT$", "w", stdout);
+    if (!keepStdout) freopen_s(&fp, "CONOUT$", "w", stdout);
     freopen_s(&fp, "CONOUT$", "w", stderr);
     freopen_s(&fp, "CONIN$", "r", stdin);
 }
 
+/**
+* Get stdout in binary mode for streaming audio, the CRT of a GUI
+* application may not have stdout set up, then wrap the raw handle
+*
+* @return FILE*
+*/
+static FILE* OpenStdoutBinary()
+{
+    int fh = _fileno(stdout);
+    if (fh >= 0)
+    {
+        _setmode(fh, _O_BINARY);
+        return stdout;
+    }
+    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+    if (hOut == INVALID_HANDLE_VALUE || hOut == NULL) return nullptr;
+    fh = _open_osfhandle(reinterpret_cast<intptr_t>(hOut), _O_BINARY);
+    if (fh < 0) return nullptr;
+    return _fdopen(fh, "wb");
+}
+
+/**
+* Get stdin in binary mode for streaming audio, wrapping the raw handle
+* like OpenStdoutBinary
+*
+* @return int - file descriptor, -1 if there is no stdin
+*/
+static int OpenStdinBinary()
+{
+    int fh = _fileno(stdin);
+    if (fh >= 0)
+    {
+        _setmode(fh, _O_BINARY);
+        return fh;
+    }
+    HANDLE hIn = GetStdHandle(STD_INPUT_HANDLE);
+    if (hIn == INVALID_HANDLE_VALUE || hIn == NULL) return -1;
+    return _open_osfhandle(reinterpret_cast<intptr_t>(hIn), _O_RDONLY | _O_BINARY);
+}
+
 /**
 * Check if a console is available (e.g., launched from cmd)
 *
@@ -897,6 +1242,13 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, PWSTR, int)
     // store instance handle in global variable
     g_hInst = hInstance;
 
+    // open render cache, a missing cache only costs rendering time
+    if (USE_RENDER_CACHE)
+    {
+        try { render_cache = make_unique<MorseCache>(MorseWav::GetSaveDir() + "cache\\", RENDER_CACHE_MAX_BYTES); }
+        catch (...) { render_cache.reset(); }
+    }
+
     CheckRadioButton(g_hWnd, CID_MORSE, CID_M2WM, CID_MORSE); // default selection
 
     // Process command line arguments
@@ -961,6 +1313,18 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, PWSTR, int)
         // determine action
         if (strcmp(argv[1], "ew") == 0) { action = "wav"; }
         else if (strcmp(argv[1], "ewm") == 0) { action = "wav_mono"; }
+        else if (strcmp(argv[1], "es") == 0) { action = "sweep"; }
+        else if (strcmp(argv[1], "esm") == 0) { action = "sweep_mono"; }
+        else if (strcmp(argv[1], "em") == 0) { action = "mix"; }
+        else if (strcmp(argv[1], "ep") == 0) { action = "play"; }
+        else if (strcmp(argv[1], "et") == 0) { action = "sidetone"; }
+        else if (strcmp(argv[1], "ek") == 0) { action = "keying"; }
+        else if (strcmp(argv[1], "eb") == 0) { action = "mbin"; }
+        else if (strcmp(argv[1], "db") == 0) { action = "mbin_decode"; }
+        else if (strcmp(argv[1], "dw") == 0) { action = "wav_decode"; }
+        else if (strcmp(argv[1], "ds") == 0) { action = "skim"; }
+        else if (strcmp(argv[1], "dd") == 0) { action = "batch_decode"; }
+        else if (strcmp(argv[1], "dl") == 0) { action = "live_decode"; }
         else if (strcmp(argv[1], "e") == 0) { action = "encode"; }
         else if (strcmp(argv[1], "d") == 0) { action = "decode"; }
         else if (strcmp(argv[1], "b") == 0) { action = "binary"; }
@@ -969,8 +1333,13 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, PWSTR, int)
         else if (strcmp(argv[1], "hb") == 0) { action = "hexbin"; }
         else if (strcmp(argv[1], "hbd") == 0) { action = "hexbindec"; }
 
-        // command line mode
-        AttachToNewConsole();
+        // command line mode, streaming keeps stdout for the audio
+        bool streaming = false;
+        for (int i = 2; i < argc; ++i)
+        {
+            if (argv[i] && (strcmp(argv[i], "-stdout") == 0 || strcmp(argv[i], "-raw") == 0)) streaming = true;
+        }
+        AttachToNewConsole(streaming);
         if (!HasConsole())
         {
             // No console available: fallback UI
@@ -1003,23 +1372,415 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, PWSTR, int)
         else if (action == "hexdec") { cout << m.hexdecimal_bin_txt(arg_in, 0) << "\n"; }
         else if (action == "hexbin") { cout << m.bin_morse_hexdecimal(arg_in, 1) << "\n"; }
         else if (action == "hexbindec") { cout << m.hexdecimal_bin_txt(arg_in, 1) << "\n"; }
-        else if (action == "sound" || action == "wav" || action == "wav_mono")
+        else if (action == "sweep" || action == "sweep_mono")
+        {
+            // make every sweep value safe, wpm and sps are whole numbers
+            vector<double> tones = parse_list(tone_list, frequency_in_hertz);
+            vector<double> wpms = parse_list(wpm_list, words_per_minute);
+            vector<double> spss = parse_list(sps_list, samples_per_second);
+            for (double& t : tones) { int w = words_per_minute, s = samples_per_second; MakeMorseSafe(t, w, s); }
+            for (double& w : wpms) { double t = frequency_in_hertz; int wi = (int)w, s = samples_per_second; MakeMorseSafe(t, wi, s); w = wi; }
+            for (double& s : spss) { double t = frequency_in_hertz; int w = words_per_minute, si = (int)s; MakeMorseSafe(t, w, si); s = si; }
+            try
+            {
+                MorseSweep sweep(arg_in, lowercase == 0);
+                cout << sweep.GetMorseCode() << "\n";
+                sweep.Run(tones, wpms, spss, (action == "sweep") ? STEREO : MONO);
+            }
+            catch (const exception& e)
+            {
+                cerr << "ERROR creating WAV: " << e.what() << endl;
+            }
+        }
+        else if (action == "mix")
+        {
+            // arg_in is the message list, every message on its own tone, speed and start
+            double tone = frequency_in_hertz;
+            MakeMorseSafe(tone, words_per_minute, samples_per_second);
+            try
+            {
+                MorseMixer mixer(samples_per_second, uppercase);
+                mixer.Load(arg_in.substr(0, arg_in.find_last_not_of(' ') + 1));
+                _mkdir(MorseWav::GetSaveDir().c_str());
+                bool flac = (audio_format == FORMAT_FLAC);
+                string path = MorseWav::GetSaveDir() + "morse_" + to_string(time(NULL)) + "_mix" + (flac ? ".flac" : ".wav");
+                auto start = chrono::steady_clock::now();
+                uint64_t bytes = mixer.Save(path, flac, mix_dither != 0);
+                double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                double seconds = (double)mixer.GetFrameCount() / samples_per_second;
+                cout << mixer.GetCount() << " messages, " << seconds << " s @ " << (samples_per_second / 1e3) << " kHz in " << elapsed << " s written to\n "
+                    << path << " (" << (bytes / 1024.0) << " kB)\n";
+                if (mixer.GetClipped() > 0) cerr << mixer.GetClipped() << " samples clipped, lower the amplitudes\n";
+            }
+            catch (const exception& e)
+            {
+                cerr << "ERROR creating mix: " << e.what() << endl;
+            }
+        }
+        else if (action == "mbin")
+        {
+            // bit-packed .mbin file in SaveDir
+            try
+            {
+                MorseBin mb(uppercase);
+                mb.Encode(arg_in);
+                _mkdir(MorseWav::GetSaveDir().c_str());
+                string path = MorseWav::GetSaveDir() + "morse_" + to_string(time(NULL)) + ".mbin";
+                mb.Save(path);
+                cout << mb.GetSymbolCount() << " characters, " << mb.GetWordCount() << " words written to " << path << "\n";
+            }
+            catch (const exception& e)
+            {
+                cerr << "ERROR creating .mbin file: " << e.what() << endl;
+            }
+        }
+        else if (action == "mbin_decode")
+        {
+            // arg_in is the file path, seek with -char:N or -word:N
+            try
+            {
+                MorseBin mb(uppercase);
+                mb.Load(arg_in.substr(0, arg_in.find_last_not_of(' ') + 1));
+                uint32_t count = (mbin_count > 0) ? (uint32_t)mbin_count : UINT32_MAX;
+                if (mbin_word >= 0) cout << mb.DecodeWords((uint32_t)mbin_word, count) << "\n";
+                else if (mbin_char >= 0) cout << mb.DecodeChars((uint32_t)mbin_char, count) << "\n";
+                else cout << mb.DecodeChars(0, count) << "\n";
+            }
+            catch (const exception& e)
+            {
+                cerr << "ERROR reading .mbin file: " << e.what() << endl;
+            }
+        }
+        else if (action == "wav_decode")
+        {
+            // arg_in is the wav path, -wpm is the starting speed (and the -mf template), tone from -hz or estimated,
+            // -beam keeps several labelings of the runs, -lm trains its bigram model on a text file,
+            // -chars writes every character with its position and confidence (.jsonl or binary .mchr)
+            try
+            {
+                MorseWavReader reader(arg_in.substr(0, arg_in.find_last_not_of(' ') + 1));
+                double tone = frequency_in_hertz;
+                if (tone_list.empty())
+                {
+                    // no -hz given, tune to the strongest tone of the first seconds
+                    double estimate = MorseDecoder::EstimateTone(reader);
+                    if (estimate > 0.0) tone = estimate;
+                    cout << "tone: " << tone << " Hz (estimated)\n";
+                }
+                MorseDecoder decoder(tone, reader.GetSps(), words_per_minute, uppercase, matched_filter != 0, beam_width);
+                if (!bigram_path.empty())
+                {
+                    ifstream lm(bigram_path);
+                    if (!lm)
+                    {
+                        cerr << "Failed to open file: " << bigram_path << endl;
+                        throw runtime_error("Failed to open file: " + bigram_path);
+                    }
+                    stringstream sample;
+                    sample << lm.rdbuf();
+                    decoder.TrainBigram(sample.str());
+                }
+                if (!chars_path.empty() && beam_width == 0)
+                {
+                    size_t dot = chars_path.find_last_of('.');
+                    bool jsonl = dot != string::npos && chars_path.substr(dot) == MorseCharLog::GetExtension(CHARLOG_JSONL);
+                    MorseCharLog log(chars_path, jsonl ? CHARLOG_JSONL : CHARLOG_BINARY, reader.GetSps());
+                    decoder.Decode(reader, log);
+                    log.Close();
+                }
+                else
+                {
+                    if (!chars_path.empty()) cerr << "-chars needs the classifier, ignored with -beam\n";
+                    decoder.Decode(reader);
+                }
+                cout << "wpm: " << decoder.GetWpm() << " (estimated at the end)\n";
+                cout << decoder.GetMorseCode() << "\n";
+                cout << decoder.GetText() << "\n";
+            }
+            catch (const exception& e)
+            {
+                cerr << "ERROR decoding WAV: " << e.what() << endl;
+            }
+        }
+        else if (action == "batch_decode")
+        {
+            // arg_in is a directory of wav files or a list file, decoded on -threads:N threads,
+            // results in file order or one .txt per wav in -out:dir, dw options apply to every file
+            try
+            {
+                vector<string> files = MorseBatch::ListFiles(arg_in.substr(0, arg_in.find_last_not_of(' ') + 1));
+                MorseBatch batch(tone_list.empty() ? 0.0 : frequency_in_hertz, words_per_minute, uppercase, matched_filter != 0, beam_width);
+                if (!bigram_path.empty())
+                {
+                    ifstream lm(bigram_path);
+                    if (!lm)
+                    {
+                        cerr << "Failed to open file: " << bigram_path << endl;
+                        throw runtime_error("Failed to open file: " + bigram_path);
+                    }
+                    stringstream sample;
+                    sample << lm.rdbuf();
+                    batch.TrainBigram(sample.str());
+                }
+                if (!batch_out.empty()) batch.SetOutDir(batch_out);
+                batch.Run(files, static_cast<size_t>(max(batch_threads, 0)), cout);
+                batch.Report(cout);
+            }
+            catch (const exception& e)
+            {
+                cerr << "ERROR batch decoding: " << e.what() << endl;
+            }
+        }
+        else if (action == "live_decode")
         {
+            // raw 16 bit mono PCM on stdin at -sps with the tone at -hz, e.g. ewm -raw ... | dl,
+            // characters are written as they are decoded, also while stdin has nothing to read
+            try
+            {
+                int in = OpenStdinBinary();
+                if (in < 0) throw runtime_error("No stdin to read from");
+                MorseLive live(frequency_in_hertz, samples_per_second, words_per_minute, uppercase, matched_filter != 0);
+
+                // stdin on its own thread, _read blocks until data comes
+                thread feeder([&live, in]()
+                {
+                    vector<int16_t> pcm(MorseLive::BLOCK_FRAMES);
+                    char* bytes = reinterpret_cast<char*>(pcm.data());
+                    size_t have = 0; // bytes in pcm
+                    int got;
+                    while ((got = _read(in, bytes + have, static_cast<unsigned>(pcm.size() * 2 - have))) > 0)
+                    {
+                        have += got;
+                        size_t frames = have / 2;
+                        size_t pushed = live.Push(pcm.data(), frames);
+                        while (pushed < frames)
+                        {
+                            Sleep(1); // ring full, the decoder is behind
+                            pushed += live.Push(pcm.data() + pushed, frames - pushed);
+                        }
+                        if (have & 1) bytes[0] = bytes[have - 1]; // half a sample, keep it
+                        have &= 1;
+                    }
+                    live.End();
+                });
+
+                // characters until every one after the end of input is out
+                CharRecord r;
+                for (;;)
+                {
+                    bool done = live.IsDone();
+                    while (live.Next(r)) cout << r.text << (r.space ? " " : "") << flush;
+                    if (done) break;
+                    Sleep(1);
+                }
+                feeder.join();
+                cout << "\n";
+                if (live.GetDropped() > 0) cerr << live.GetDropped() << " characters dropped\n";
+            }
+            catch (const exception& e)
+            {
+                cerr << "ERROR decoding stdin: " << e.what() << endl;
+            }
+        }
+        else if (action == "skim")
+        {
+            // arg_in is the wav path, every carrier in the band is decoded on its own
+            try
+            {
+                MorseWavReader reader(arg_in.substr(0, arg_in.find_last_not_of(' ') + 1));
+                MorseSkimmer skimmer(reader.GetSps(), words_per_minute, uppercase);
+                skimmer.Decode(reader);
+                vector<MorseSkimmer::Signal> signals = skimmer.GetSignals();
+                cout << signals.size() << " signals, " << skimmer.GetBinHz() << " Hz channels\n";
+                for (const MorseSkimmer::Signal& s : signals)
+                {
+                    cout << (int)(s.tone + 0.5) << " Hz " << (int)(s.wpm + 0.5) << " wpm: " << s.text << "\n";
+                }
+            }
+            catch (const exception& e)
+            {
+                cerr << "ERROR skimming WAV: " << e.what() << endl;
+            }
+        }
+        else if (action == "keying")
+        {
+            // key down / key up schedule only, same timing as the wav
+            string morse = m.morse_encode(arg_in);
+            ostream& info = stream_out ? cerr : cout;
+            info << morse << "\n";
+            MakeMorseSafe(frequency_in_hertz, words_per_minute, samples_per_second);
+            try
+            {
+                MorseTiming timing(morse.c_str());
+                MorseKeying keying(timing, words_per_minute, samples_per_second, keying_unit);
+                if (stream_out)
+                {
+                    FILE* out = OpenStdoutBinary();
+                    if (!out)
+                    {
+                        cerr << "ERROR streaming: no stdout available" << endl;
+                        return 1;
+                    }
+                    keying.Write(out, keying_format);
+                    fflush(out);
+                    cerr << keying.GetEventCount() << " key events streamed\n";
+                    return 0;
+                }
+                _mkdir(MorseWav::GetSaveDir().c_str());
+                string path = MorseWav::GetSaveDir() + "morse_" + to_string(time(NULL)) + MorseKeying::GetExtension(keying_format);
+                keying.Save(path, keying_format);
+                info << keying.GetEventCount() << " key events written to " << path << "\n";
+            }
+            catch (const exception& e)
+            {
+                cerr << "ERROR creating keying file: " << e.what() << endl;
+            }
+        }
+        else if (action == "play")
+        {
+            // in-process playback, no file and no media player
             string morse = m.morse_encode(arg_in);
             if (!lowercase) arg_in = m.stringToUpper(arg_in);
             cout << arg_in << "\n";
             cout << morse << "\n";
             MakeMorseSafe(frequency_in_hertz, words_per_minute, samples_per_second);
-            if (action == "wav")
+            try
+            {
+                unique_ptr<MorseSink> sink;
+                if (play_sink == "null") sink = make_unique<NullSink>(true);
+                else if (!play_sink.empty()) sink = make_unique<WavSink>(play_sink);
+                else sink = make_unique<WaveOutSink>();
+                MorsePlayer mp(*sink);
+                chrono::steady_clock::time_point start = chrono::steady_clock::now();
+                mp.Play(morse, frequency_in_hertz, words_per_minute, samples_per_second, MONO, &envelope);
+                while (mp.IsPlaying() && mp.GetPlayed() == 0) this_thread::sleep_for(chrono::microseconds(100));
+                double latency = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+                mp.Wait();
+                cout << "playback started in " << trimDecimals(to_string(latency), 2) << " ms, ";
+                cout << mp.GetPlayed() << " of " << mp.GetFrameCount() << " frames played";
+                if (mp.GetUnderruns() > 0) cout << ", " << mp.GetUnderruns() << " underruns";
+                cout << "\n";
+            }
+            catch (const exception& e)
+            {
+                cerr << "ERROR playing: " << e.what() << endl;
+            }
+        }
+        else if (action == "sidetone")
+        {
+            // live keying: the text given, else every key as it is typed until Esc or end of input
+            MakeMorseSafe(frequency_in_hertz, words_per_minute, samples_per_second);
+            try
+            {
+                unique_ptr<MorseSink> sink;
+                if (play_sink == "null") sink = make_unique<NullSink>(true, samples_per_second / 200);
+                else if (!play_sink.empty()) sink = make_unique<WavSink>(play_sink);
+                else sink = make_unique<WaveOutSink>(5);
+                MorseSidetone st(*sink, frequency_in_hertz, words_per_minute, samples_per_second, uppercase, &envelope);
+                st.Start();
+                string text = arg_in.substr(0, arg_in.find_last_not_of(' ') + 1);
+                if (!text.empty())
+                {
+                    for (char c : text)
+                    {
+                        while (!st.Key(c)) Sleep(1);
+                    }
+                }
+                else if (_isatty(_fileno(stdin)))
+                {
+                    cout << "type to key, Esc to stop\n";
+                    int c;
+                    while ((c = _getch()) != 27 && c != 26)
+                    {
+                        if (c == 0 || c == 0xE0) { _getch(); continue; } // arrow and function keys
+                        if (c == '\r') c = ' ';
+                        cout << static_cast<char>(c) << flush;
+                        st.Key(static_cast<char>(c));
+                    }
+                    cout << "\n";
+                }
+                else
+                {
+                    int c;
+                    while ((c = getchar()) != EOF)
+                    {
+                        if (c == '\n' || c == '\r') c = ' ';
+                        while (!st.Key(static_cast<char>(c))) Sleep(1);
+                    }
+                }
+                st.Drain();
+                st.Stop();
+                cout << st.GetSent() << " characters sent, keystroke to first sample ";
+                cout << trimDecimals(to_string(st.GetLastLatency()), 3) << " ms (max ";
+                cout << trimDecimals(to_string(st.GetMaxLatency()), 3) << " ms)\n";
+            }
+            catch (const exception& e)
+            {
+                cerr << "ERROR keying: " << e.what() << endl;
+            }
+        }
+        else if (action == "sound" || action == "wav" || action == "wav_mono")
+        {
+            string morse = m.morse_encode(arg_in);
+            if (!lowercase) arg_in = m.stringToUpper(arg_in);
+            ostream& info = stream_out ? cerr : cout; // stdout carries the audio when streaming
+            info << arg_in << "\n";
+            info << morse << "\n";
+            MakeMorseSafe(frequency_in_hertz, words_per_minute, samples_per_second);
+            // complex baseband keys a carrier at -offset from the centre frequency instead of the tone
+            bool iq = (audio_format == FORMAT_IQ_CF32 || audio_format == FORMAT_IQ_CS16);
+            double tone = iq ? iq_offset : frequency_in_hertz;
+            if (iq && fabs(iq_offset) >= samples_per_second / 2.0)
+            {
+                cerr << "ERROR: -offset must be below half of -sps" << endl;
+                return 1;
+            }
+            if (stream_out)
+            {
+                // render block by block straight to stdout, no file and no media player
+                FILE* out = OpenStdoutBinary();
+                if (!out)
+                {
+                    cerr << "ERROR streaming: no stdout available" << endl;
+                    return 1;
+                }
+                try
+                {
+                    if (iq)
+                    {
+                        // raw I/Q whether -stdout or -raw, SDR tools take no header
+                        MorseStream ms(morse.c_str(), iq_offset, words_per_minute, samples_per_second,
+                            audio_format == FORMAT_IQ_CS16, out, &envelope);
+                        cerr << ms.GetPcmCount() << " I/Q frames streamed\n";
+                    }
+                    else
+                    {
+                        MorseStream ms(morse.c_str(), frequency_in_hertz, words_per_minute, samples_per_second,
+                            (action == "wav_mono") ? MONO : STEREO, stream_out == 2, out, &impairment, &envelope);
+                        cerr << ms.GetPcmCount() << " PCM frames streamed\n";
+                    }
+                }
+                catch (const exception& e)
+                {
+                    cerr << "ERROR streaming: " << e.what() << endl;
+                }
+                return 0;
+            }
+            else if (action == "wav")
             {
                 // start background thread to create stereo wav
                 ConsoleWavParams* p = new ConsoleWavParams();
                 p->morse = morse;
-                p->tone = frequency_in_hertz;
+                p->tone = tone;
                 p->wpm = words_per_minute;
                 p->sps = samples_per_second;
                 p->channels = STEREO;
                 p->showExternal = SHOW_EXTERNAL_MEDIAPLAYER;
+                p->cache = render_cache.get();
+                p->format = audio_format;
+                p->impairment = &impairment;
+                p->envelope = &envelope;
+                p->player = PLAY_WHILE_RENDERING ? &player : nullptr;
 
                 uintptr_t th = _beginthreadex(NULL, 0, &ConsoleWavThreadProc, p, 0, NULL);
                 if (th != 0)
@@ -1032,7 +1793,7 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, PWSTR, int)
                 {
                     // fallback to synchronous if thread creation failed
                     delete p;
-                    try { MorseWav mw(morse.c_str(), frequency_in_hertz, words_per_minute, samples_per_second, STEREO, SHOW_EXTERNAL_MEDIAPLAYER); }
+                    try { MorseWav mw(morse.c_str(), tone, words_per_minute, samples_per_second, STEREO, SHOW_EXTERNAL_MEDIAPLAYER, render_cache.get(), audio_format, &impairment, &envelope, PLAY_WHILE_RENDERING ? &player : nullptr); }
                     catch (...) { cerr << "Failed to create WAV (fallback)." << endl; }
                 }
             }
@@ -1041,11 +1802,16 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, PWSTR, int)
                 // start background thread to create mono wav
                 ConsoleWavParams* p = new ConsoleWavParams();
                 p->morse = morse;
-                p->tone = frequency_in_hertz;
+                p->tone = tone;
                 p->wpm = words_per_minute;
                 p->sps = samples_per_second;
                 p->channels = MONO;
                 p->showExternal = SHOW_EXTERNAL_MEDIAPLAYER;
+                p->cache = render_cache.get();
+                p->format = audio_format;
+                p->impairment = &impairment;
+                p->envelope = &envelope;
+                p->player = PLAY_WHILE_RENDERING ? &player : nullptr;
 
                 uintptr_t th = _beginthreadex(NULL, 0, &ConsoleWavThreadProc, p, 0, NULL);
                 if (th != 0)
@@ -1056,20 +1822,23 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, PWSTR, int)
                 else
                 {
                     delete p;
-                    try { MorseWav mw(morse.c_str(), frequency_in_hertz, words_per_minute, samples_per_second, MONO, SHOW_EXTERNAL_MEDIAPLAYER); }
+                    try { MorseWav mw(morse.c_str(), tone, words_per_minute, samples_per_second, MONO, SHOW_EXTERNAL_MEDIAPLAYER, render_cache.get(), audio_format, &impairment, &envelope, PLAY_WHILE_RENDERING ? &player : nullptr); }
                     catch (...) { cerr << "Failed to create WAV (fallback)." << endl; }
                 }
             }
         }
         cout << "\nPress [Enter] key to close program . . .\n";
         int c = getchar();
+        render_cache.reset();
         return 0;
     }
     else
     {
         // GUI mode
         ShowMorseApp(g_hWnd);
+        JoinRenderThreads();
     }
+    render_cache.reset();
 
     // when done, free all allocated buffers and arrays
     for (int i = 0; i < argc_start; ++i)
@@ -0,0 +1,359 @@
+#include "morsebatch.h"
+#include "morsewavreader.h"
+#define NOMINMAX
+#include <windows.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+/**
+* C++ MorseBatch Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+namespace fs = std::filesystem;
+
+static const char* STAGE_NAMES[STAGE_COUNT] = { "open", "tone", "read", "decode", "write" };
+
+/**
+* CPU seconds of the calling thread, kernel and user
+*
+* @return double
+*/
+static double ThreadSeconds()
+{
+    FILETIME created, exited, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &created, &exited, &kernel, &user)) return 0.0;
+    uint64_t k = (static_cast<uint64_t>(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime;
+    uint64_t u = (static_cast<uint64_t>(user.dwHighDateTime) << 32) | user.dwLowDateTime;
+    return (k + u) * 1e-7;
+}
+
+/**
+* CPU seconds of the calling thread since a point, the point moves to
+* now. The clock ticks once per scheduler quantum, summed over many
+* short laps each stage still gets its share
+*
+* @param since
+* @return double
+*/
+static double Lap(double& since)
+{
+    double now = ThreadSeconds();
+    double seconds = now - since;
+    since = now;
+    return seconds;
+}
+
+/**
+* Constructor
+*
+* @param tone
+* @param wpm
+* @param uppercase
+* @param matched_filter
+* @param beam_width
+*/
+MorseBatch::MorseBatch(double tone, double wpm, bool uppercase, bool matched_filter, int beam_width)
+{
+    Tone = tone;
+    Wpm = wpm;
+    Uppercase = uppercase;
+    Matched = matched_filter;
+    BeamWidth = beam_width;
+}
+
+/**
+* Train the bigram model of every decoder
+*
+* @param text
+*/
+void MorseBatch::TrainBigram(const string& text)
+{
+    Bigram = text;
+}
+
+/**
+* Write each result to its own file
+*
+* @param dir
+*/
+void MorseBatch::SetOutDir(const string& dir)
+{
+    OutDir = dir;
+}
+
+/**
+* Wav files of a directory or the paths in a list file
+*
+* @param path
+* @return vector<string>
+*/
+vector<string> MorseBatch::ListFiles(const string& path)
+{
+    vector<string> files;
+    error_code ec;
+    if (fs::is_directory(path, ec))
+    {
+        for (const fs::directory_entry& e : fs::recursive_directory_iterator(path, fs::directory_options::skip_permission_denied, ec))
+        {
+            if (!e.is_regular_file(ec)) continue;
+            string ext = e.path().extension().string();
+            transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+            if (ext == ".wav") files.push_back(e.path().string());
+        }
+        sort(files.begin(), files.end());
+        return files;
+    }
+
+    ifstream list(path);
+    if (!list)
+    {
+        cerr << "Failed to open file: " << path << '\n';
+        throw runtime_error("Error opening file or directory");
+    }
+    string line;
+    while (getline(list, line))
+    {
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (!line.empty()) files.push_back(line);
+    }
+    return files;
+}
+
+/**
+* Decode the files, the calling thread writes the results in order
+*
+* @param files
+* @param threads
+* @param out
+*/
+void MorseBatch::Run(const vector<string>& files, size_t threads, ostream& out)
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    size_t n = files.size();
+    results.assign(n, Result());
+    for (size_t i = 0; i < n; ++i) results[i].path = files[i];
+    done.assign(n, 0);
+    failed = 0;
+    audio = 0.0;
+    fill(stageSeconds, stageSeconds + STAGE_COUNT, 0.0);
+
+    // one output per input, a stem that is taken gets the file number
+    outPaths.assign(n, string());
+    if (!OutDir.empty())
+    {
+        fs::create_directories(OutDir);
+        map<string, size_t> stems;
+        for (size_t i = 0; i < n; ++i)
+        {
+            string stem = fs::path(files[i]).stem().string();
+            if (stems[stem]++ > 0) stem += "_" + to_string(i);
+            outPaths[i] = (fs::path(OutDir) / (stem + ".txt")).string();
+        }
+    }
+
+    Threads = (threads > 0) ? threads : max(1u, thread::hardware_concurrency());
+    Threads = max<size_t>(1, min(Threads, n));
+    queues.clear();
+    for (size_t t = 0; t < Threads; ++t) queues.push_back(make_unique<Queue>());
+    for (size_t i = 0; i < n; ++i) queues[i % Threads]->files.push_back(i);
+
+    vector<Worker> workers(Threads);
+    vector<thread> pool;
+    for (size_t t = 0; t < Threads; ++t) pool.emplace_back(&MorseBatch::Work, this, t, ref(workers[t]));
+
+    for (size_t next = 0; next < n; ++next)
+    {
+        unique_lock<mutex> guard(doneLock);
+        doneSignal.wait(guard, [&] { return done[next] != 0; });
+        guard.unlock();
+        Print(out, results[next]);
+    }
+    for (thread& t : pool) t.join();
+
+    for (const Worker& w : workers)
+    {
+        for (int s = 0; s < STAGE_COUNT; ++s) stageSeconds[s] += w.stage[s];
+    }
+    for (const Result& r : results)
+    {
+        if (!r.error.empty()) failed++;
+        audio += r.seconds;
+    }
+    wall = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+* Write files/s, audio hours/s and the time spent per stage
+*
+* @param out
+*/
+void MorseBatch::Report(ostream& out) const
+{
+    double seconds = max(wall, 1e-9);
+    out << results.size() << " files, " << failed << " failed, " << fixed << setprecision(2)
+        << audio / 3600.0 << " audio hours in " << wall << " s on " << Threads << " threads\n";
+    out << results.size() / seconds << " files/s, " << setprecision(3) << audio / 3600.0 / seconds << " audio hours/s\n";
+    out << "CPU time per stage, all threads:" << setprecision(2);
+    for (int s = 0; s < STAGE_COUNT; ++s) out << ' ' << STAGE_NAMES[s] << ' ' << stageSeconds[s] << " s";
+    out << '\n' << defaultfloat;
+}
+
+/**
+* Thread procedure, decode files until all queues are empty
+*
+* @param id
+* @param worker
+*/
+void MorseBatch::Work(size_t id, Worker& worker)
+{
+    worker.buffer.resize(MorseDecoder::READ_FRAMES);
+    size_t file;
+    while (Take(id, file))
+    {
+        Decode(worker, file);
+        if (!OutDir.empty()) Write(worker, file);
+        {
+            lock_guard<mutex> guard(doneLock);
+            done[file] = 1;
+        }
+        doneSignal.notify_one();
+    }
+}
+
+/**
+* Next file: the front of the own queue, else the back of another
+*
+* @param id
+* @param file
+* @return bool - false when there is no work left
+*/
+bool MorseBatch::Take(size_t id, size_t& file)
+{
+    for (size_t k = 0; k < queues.size(); ++k)
+    {
+        Queue& q = *queues[(id + k) % queues.size()];
+        lock_guard<mutex> guard(q.lock);
+        if (q.files.empty()) continue;
+        if (k == 0)
+        {
+            file = q.files.front();
+            q.files.pop_front();
+        }
+        else
+        {
+            file = q.files.back();
+            q.files.pop_back();
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+* Decode one file with the decoder of the thread
+*
+* @param worker
+* @param file
+*/
+void MorseBatch::Decode(Worker& worker, size_t file)
+{
+    Result& r = results[file];
+    double t = ThreadSeconds();
+    try
+    {
+        MorseWavReader reader(r.path);
+        worker.stage[STAGE_OPEN] += Lap(t);
+
+        r.tone = Tone;
+        if (r.tone <= 0.0)
+        {
+            r.tone = MorseDecoder::EstimateTone(reader);
+            worker.stage[STAGE_TONE] += Lap(t);
+            if (r.tone <= 0.0) throw runtime_error("No tone found");
+        }
+
+        double sps = reader.GetSps();
+        unique_ptr<MorseDecoder>& decoder = worker.decoders[sps];
+        if (!decoder)
+        {
+            decoder = make_unique<MorseDecoder>(r.tone, sps, Wpm, Uppercase, Matched, BeamWidth);
+            if (!Bigram.empty()) decoder->TrainBigram(Bigram);
+        }
+        else
+        {
+            decoder->Reset(r.tone);
+        }
+        worker.stage[STAGE_DECODE] += Lap(t);
+
+        uint64_t frames = 0;
+        size_t n;
+        while ((n = reader.Read(worker.buffer.data(), worker.buffer.size())) > 0)
+        {
+            worker.stage[STAGE_READ] += Lap(t);
+            decoder->Process(worker.buffer.data(), n);
+            worker.stage[STAGE_DECODE] += Lap(t);
+            frames += n;
+        }
+        decoder->Finish();
+        worker.stage[STAGE_DECODE] += Lap(t);
+
+        r.seconds = frames / sps;
+        r.wpm = decoder->GetWpm();
+        r.morse = decoder->GetMorseCode();
+        r.text = decoder->GetText();
+    }
+    catch (const exception& e)
+    {
+        r.error = e.what();
+    }
+}
+
+/**
+* Write one result to its own file
+*
+* @param worker
+* @param file
+*/
+void MorseBatch::Write(Worker& worker, size_t file)
+{
+    Result& r = results[file];
+    if (!r.error.empty()) return;
+    double t = ThreadSeconds();
+    ofstream f(outPaths[file], ios::binary);
+    f << r.morse << "\n" << r.text << "\n";
+    if (!f) r.error = "Error writing " + outPaths[file];
+    r.morse.clear();
+    r.text.clear();
+    worker.stage[STAGE_WRITE] += Lap(t);
+}
+
+/**
+* Write one result, the decoded strings are released afterwards
+*
+* @param out
+* @param result
+*/
+void MorseBatch::Print(ostream& out, Result& result) const
+{
+    if (!result.error.empty())
+    {
+        out << "== " << result.path << ": ERROR " << result.error << "\n";
+        return;
+    }
+    if (!OutDir.empty()) return;
+    out << "== " << result.path << " (" << static_cast<int>(result.tone + 0.5) << " Hz, "
+        << static_cast<int>(result.wpm + 0.5) << " wpm, " << static_cast<int>(result.seconds + 0.5) << " s)\n";
+    out << result.morse << "\n" << result.text << "\n";
+    string().swap(result.morse);
+    string().swap(result.text);
+}
@@ -0,0 +1,349 @@
+#include "morsebeam.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+/**
+* C++ MorseBeam Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Dots and dashes of a trie node, the bits below the leading one
+*
+* @param node
+* @return string
+*/
+static string NodeCode(uint16_t node)
+{
+    string code;
+    for (; node > 1; node >>= 1) code += (node & 1) ? '-' : '.';
+    reverse(code.begin(), code.end());
+    return code;
+}
+
+/**
+* Constructor, the trie is read from the Morse tables
+*
+* @param unit
+* @param uppercase
+* @param width
+*/
+MorseBeam::MorseBeam(double unit, bool uppercase, int width)
+    : morse(uppercase)
+{
+    Width = max(width, 1);
+    symbol.resize(NODES);
+    prefix.assign(NODES, 0);
+    letter.assign(NODES, 1); // unknown
+    letter[SPACE] = 0;
+    letters = 2;             // space, unknown
+
+    string question = morse.morse_encode("?");
+    question = question.substr(0, question.find(' '));
+    for (uint16_t node = 2; node < NODES; ++node)
+    {
+        string code = NodeCode(node);
+        string ch = morse.morse_decode(code);
+        if (ch.empty() || (ch == "?" && code != question)) continue;
+        symbol[node] = ch;
+        letter[node] = static_cast<uint8_t>(letters++);
+        for (uint16_t n = node; n > 1; n >>= 1) prefix[n] = 1;
+    }
+
+    beam.resize(Width);
+    next.resize(4 * Width);
+    Reset(unit);
+}
+
+/**
+* Start over on new input
+*
+* @param unit
+*/
+void MorseBeam::Reset(double unit)
+{
+    // start at several speeds around the given one, the timing picks
+    size = 0;
+    for (int k = -3; k <= 3 && size < Width; ++k)
+    {
+        Hyp& h = beam[size++];
+        h.score = 0.0f;
+        h.unit = static_cast<float>(((unit > 0.0) ? unit : 1.0) * pow(2.0, k / 2.0));
+        h.node = 1;
+        h.last = SPACE;
+        h.count = 0;
+    }
+    candidates = 0;
+    base = 0;
+    MorseCode.clear();
+    Text.clear();
+}
+
+/**
+* Train the character bigram model, add one smoothed
+*
+* @param text
+*/
+void MorseBeam::TrainBigram(const string& text)
+{
+    vector<double> counts(static_cast<size_t>(letters) * letters, 1.0);
+    istringstream words(text);
+    string word;
+    while (words >> word)
+    {
+        // per word, morse_encode works on short strings
+        istringstream codes(morse.morse_encode(word));
+        string code;
+        int last = 0;
+        while (codes >> code)
+        {
+            uint16_t node = 1;
+            for (char e : code)
+            {
+                node = static_cast<uint16_t>(2 * node + (e == '-' || e == '1'));
+                if (node >= NODES) break;
+            }
+            int c = (node < NODES) ? letter[node] : 1;
+            counts[last * letters + c] += 1.0;
+            last = c;
+        }
+        counts[last * letters] += 1.0; // word space
+    }
+
+    bigram.resize(counts.size());
+    for (int p = 0; p < letters; ++p)
+    {
+        double total = 0.0;
+        for (int c = 0; c < letters; ++c) total += counts[p * letters + c];
+        for (int c = 0; c < letters; ++c) bigram[p * letters + c] = static_cast<float>(log(counts[p * letters + c] / total));
+    }
+}
+
+/**
+* Add a key down or key up run
+*
+* @param key
+* @param length
+*/
+void MorseBeam::Add(bool key, double length)
+{
+    if (length <= 0.0) return;
+    float l = static_cast<float>(length);
+
+    candidates = 0;
+    for (int i = 0; i < size; ++i) Extend(beam[i], key, l);
+    if (candidates == 0)
+    {
+        // a mark no character takes: close the characters, '?' if they
+        // are none, and start new ones
+        for (int i = 0; i < size; ++i)
+        {
+            Hyp h = beam[i];
+            Close(h);
+            Extend(h, key, l);
+        }
+    }
+    Prune();
+    Commit(LAG / 2);
+}
+
+/**
+* End of input, commit the best hypothesis
+*/
+void MorseBeam::Flush()
+{
+    if (size == 0) return;
+    int best = 0;
+    for (int i = 0; i < size; ++i)
+    {
+        Close(beam[i]);
+        if (beam[i].score < beam[best].score) best = i;
+    }
+    beam[0] = beam[best];
+    size = 1;
+    Commit(0);
+    beam[0].score = 0.0f;
+
+    while (!MorseCode.empty() && MorseCode.back() == ' ') MorseCode.pop_back();
+    while (!Text.empty() && Text.back() == ' ') Text.pop_back();
+}
+
+const string& MorseBeam::GetMorseCode() const
+{
+    return MorseCode;
+}
+
+const string& MorseBeam::GetText() const
+{
+    return Text;
+}
+
+/**
+* Get dit length of the best hypothesis
+*
+* @return double
+*/
+double MorseBeam::GetUnit() const
+{
+    return (size > 0) ? beam[0].unit : 0.0;
+}
+
+/**
+* Every label of one run the character of a hypothesis allows
+*
+* @param h
+* @param key
+* @param length
+*/
+void MorseBeam::Extend(const Hyp& h, bool key, float length)
+{
+    if (key)
+    {
+        uint16_t dit = static_cast<uint16_t>(2 * h.node), dah = static_cast<uint16_t>(dit + 1);
+        if (dit < NODES && prefix[dit]) Push(h, dit, Cost(length, h.unit), length, 0, false);
+        if (dah < NODES && prefix[dah]) Push(h, dah, Cost(length, 3.0f * h.unit), length / 3.0f, 0, false);
+        return;
+    }
+    if (h.node == 1)
+    {
+        Push(h, 1, 0.0f, 0.0f, 0, false); // silence before the first mark
+        return;
+    }
+    Push(h, h.node, Cost(length, h.unit), length, 0, false);
+    if (symbol[h.node].empty()) return;
+    Push(h, 1, Cost(length, 3.0f * h.unit), length / 3.0f, h.node, false);
+    float word = (length >= 5.0f * h.unit) ? 0.0f : Cost(length, 5.0f * h.unit); // long pauses are word gaps
+    Push(h, 1, word, 0.0f, h.node, true);
+}
+
+/**
+* Add one candidate
+*
+* @param h
+* @param node
+* @param cost
+* @param unitLength - observed dit length, 0 = none
+* @param emit - completed character, 0 = none
+* @param space - word gap after it
+*/
+void MorseBeam::Push(const Hyp& h, uint16_t node, float cost, float unitLength, uint16_t emit, bool space)
+{
+    if (candidates == static_cast<int>(next.size())) return;
+    if (h.count + (emit ? 1 : 0) + (space ? 1 : 0) > LAG) return;
+
+    Hyp& n = next[candidates++];
+    n = h;
+    n.node = node;
+    n.score += cost;
+    if (unitLength > 0.0f) n.unit += ALPHA * (unitLength - n.unit);
+    if (emit) Append(n, emit);
+    if (space) Append(n, SPACE);
+}
+
+/**
+* Keep the Width best candidates, one per (current character, last character)
+*/
+void MorseBeam::Prune()
+{
+    sort(next.begin(), next.begin() + candidates, [](const Hyp& a, const Hyp& b) { return a.score < b.score; });
+    size = 0;
+    for (int i = 0; i < candidates && size < Width; ++i)
+    {
+        const Hyp& c = next[i];
+        bool same = false;
+        for (int j = 0; j < size && !same; ++j) same = beam[j].node == c.node && beam[j].last == c.last;
+        if (!same) beam[size++] = c;
+    }
+    float best = (size > 0) ? beam[0].score : 0.0f;
+    for (int i = 0; i < size; ++i) beam[i].score -= best;
+}
+
+/**
+* Commit the oldest characters of the best hypothesis while it holds more
+* than keep, hypotheses that disagree with them are dropped
+*
+* @param keep
+*/
+void MorseBeam::Commit(int keep)
+{
+    while (size > 0 && beam[0].count > keep)
+    {
+        uint16_t c = beam[0].chars[base];
+        Emit(c);
+        int kept = 0;
+        for (int i = 0; i < size; ++i)
+        {
+            if (beam[i].count == 0 || beam[i].chars[base] != c) continue;
+            beam[i].count--;
+            if (kept != i) beam[kept] = beam[i];
+            kept++;
+        }
+        size = kept;
+        base = (base + 1) % LAG;
+    }
+}
+
+/**
+* End the character of a hypothesis, as '?' if it is none
+*
+* @param h
+*/
+void MorseBeam::Close(Hyp& h)
+{
+    if (h.node == 1 || h.count >= LAG) return;
+    if (symbol[h.node].empty()) h.score += UNKNOWN_COST;
+    Append(h, h.node);
+    h.node = 1;
+}
+
+/**
+* Append a character or SPACE to a hypothesis, scored by the bigram model
+*
+* @param h
+* @param c
+*/
+void MorseBeam::Append(Hyp& h, uint16_t c)
+{
+    if (!bigram.empty()) h.score -= LM_WEIGHT * bigram[letter[h.last] * letters + letter[c]];
+    h.chars[(base + h.count) % LAG] = c;
+    h.count++;
+    h.last = c;
+}
+
+/**
+* Write a committed character
+*
+* @param c
+*/
+void MorseBeam::Emit(uint16_t c)
+{
+    if (c == SPACE)
+    {
+        Text += ' ';
+        MorseCode += ' ';
+        return;
+    }
+    Text += symbol[c].empty() ? "?" : symbol[c];
+    size_t at = MorseCode.size();
+    for (uint16_t n = c; n > 1; n >>= 1) MorseCode += (n & 1) ? '-' : '.';
+    reverse(MorseCode.begin() + at, MorseCode.end());
+    MorseCode += ' ';
+}
+
+/**
+* Timing cost of a run, log normal around the expected length
+*
+* @param length
+* @param expected
+* @return float
+*/
+float MorseBeam::Cost(float length, float expected)
+{
+    float d = log(length / expected) / SIGMA;
+    return 0.5f * d * d;
+}
@@ -0,0 +1,326 @@
+#include "morsebin.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+/**
+* C++ MorseBin Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+static const size_t HEADER_SIZE = 4 + 1 + 1 + 2 + 4 + 4 + 4 + 8;
+static const size_t ENTRY_SIZE = 4 + 4 + 8;
+
+/**
+* Constructor
+*
+* @param uppercase
+*/
+MorseBin::MorseBin(bool uppercase)
+{
+    this->uppercase = uppercase;
+}
+
+/**
+* Encode text with the Morse tables, morse_binary gives one 0/1 group per
+* character and an empty group per word space
+*
+* @param text
+*/
+void MorseBin::Encode(const string& text)
+{
+    Morse m(uppercase);
+    string binary = m.morse_binary(text);
+
+    symbols = 0;
+    words = 0;
+    bits = 0;
+    index.clear();
+    payload.clear();
+    payload.reserve(binary.size() / 2 + 1);
+
+    size_t pos = 0;
+    while (pos <= binary.size() && !binary.empty())
+    {
+        size_t end = binary.find(' ', pos);
+        if (end == string::npos) end = binary.size();
+        size_t len = end - pos;
+
+        if (symbols % interval == 0) index.push_back({ symbols, words, bits });
+        if (len == 0)
+        {
+            PutBits(0, LENGTH_BITS); // word space
+            words++;
+        }
+        else
+        {
+            if (len >= (1u << LENGTH_BITS)) throw runtime_error("Morse character too long for .mbin");
+            uint32_t code = 0;
+            for (size_t i = pos; i < end; ++i) code = (code << 1) | (binary[i] == '1');
+            PutBits(static_cast<uint32_t>(len), LENGTH_BITS);
+            PutBits(code, static_cast<int>(len));
+        }
+        symbols++;
+        pos = end + 1;
+    }
+    if (symbols > 0) words++; // words = word spaces + 1
+}
+
+/**
+* Decode all symbols
+*
+* @return string
+*/
+string MorseBin::Decode()
+{
+    return DecodeRange(0, symbols, false);
+}
+
+/**
+* Decode count characters from character first, seeks through the index
+*
+* @param first
+* @param count
+* @return string
+*/
+string MorseBin::DecodeChars(uint32_t first, uint32_t count)
+{
+    if (first >= symbols) return "";
+    const IndexEntry& e = index[first / interval];
+    uint64_t bit = e.bit;
+    for (uint32_t s = e.symbol; s < first; ++s) ReadSymbol(bit);
+    return DecodeRange(bit, min(count, symbols - first), false);
+}
+
+/**
+* Decode count words from word first, seeks through the index
+*
+* @param first
+* @param count
+* @return string
+*/
+string MorseBin::DecodeWords(uint32_t first, uint32_t count)
+{
+    if (first >= words || index.empty()) return "";
+    // last entry in a word before the first one, an entry with e.word ==
+    // first may sit in the middle of that word; entry 0 for word 0
+    auto it = lower_bound(index.begin(), index.end(), first,
+        [](const IndexEntry& e, uint32_t w) { return e.word < w; });
+    const IndexEntry& e = (it == index.begin()) ? *it : *(it - 1);
+    uint64_t bit = e.bit;
+    uint32_t word = e.word;
+    while (word < first)
+    {
+        if (ReadSymbol(bit).empty()) word++;
+    }
+    return DecodeRange(bit, count, true);
+}
+
+/**
+* Save container
+*
+* @param path
+*/
+void MorseBin::Save(const string& path)
+{
+    vector<uint8_t> bytes = GetBytes();
+    ofstream out(path, ios::binary);
+    if (!out.is_open())
+    {
+        cerr << "Failed to open file: " << path << '\n';
+        throw runtime_error("Error opening file or directory");
+    }
+    out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    if (!out) throw runtime_error("Error writing .mbin file");
+}
+
+/**
+* Load container
+*
+* @param path
+*/
+void MorseBin::Load(const string& path)
+{
+    ifstream in(path, ios::binary);
+    if (!in.is_open())
+    {
+        cerr << "Failed to open file: " << path << '\n';
+        throw runtime_error("Error opening file or directory");
+    }
+    vector<uint8_t> bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    SetBytes(bytes.data(), bytes.size());
+}
+
+/**
+* Get serialized container
+*
+* @return vector
+*/
+vector<uint8_t> MorseBin::GetBytes() const
+{
+    uint32_t entries = static_cast<uint32_t>(index.size());
+    vector<uint8_t> out(HEADER_SIZE + entries * ENTRY_SIZE + payload.size());
+    uint8_t* p = out.data();
+    uint8_t table = uppercase ? 0 : 1;
+    memcpy(p, "MBIN", 4); p += 4;
+    *p++ = VERSION;
+    *p++ = table;
+    memcpy(p, &interval, 2); p += 2;
+    memcpy(p, &symbols, 4); p += 4;
+    memcpy(p, &words, 4); p += 4;
+    memcpy(p, &entries, 4); p += 4;
+    memcpy(p, &bits, 8); p += 8;
+    for (const IndexEntry& e : index)
+    {
+        memcpy(p, &e.symbol, 4); p += 4;
+        memcpy(p, &e.word, 4); p += 4;
+        memcpy(p, &e.bit, 8); p += 8;
+    }
+    if (!payload.empty()) memcpy(p, payload.data(), payload.size());
+    return out;
+}
+
+/**
+* Read serialized container
+*
+* @param data
+* @param size
+*/
+void MorseBin::SetBytes(const uint8_t* data, size_t size)
+{
+    uint32_t entries;
+    if (size < HEADER_SIZE || memcmp(data, "MBIN", 4) != 0) throw runtime_error("Not a .mbin file");
+    if (data[4] != VERSION) throw runtime_error("Unsupported .mbin version");
+    uppercase = (data[5] == 0);
+    memcpy(&interval, data + 6, 2);
+    memcpy(&symbols, data + 8, 4);
+    memcpy(&words, data + 12, 4);
+    memcpy(&entries, data + 16, 4);
+    memcpy(&bits, data + 20, 8);
+
+    uint64_t bytes = (bits + 7) / 8;
+    if (interval == 0 || entries != (symbols + interval - 1) / interval ||
+        size != HEADER_SIZE + static_cast<uint64_t>(entries) * ENTRY_SIZE + bytes)
+    {
+        throw runtime_error("Corrupt .mbin file");
+    }
+
+    const uint8_t* p = data + HEADER_SIZE;
+    index.resize(entries);
+    for (IndexEntry& e : index)
+    {
+        memcpy(&e.symbol, p, 4); p += 4;
+        memcpy(&e.word, p, 4); p += 4;
+        memcpy(&e.bit, p, 8); p += 8;
+        if (e.bit > bits) throw runtime_error("Corrupt .mbin index");
+    }
+    payload.assign(p, p + bytes);
+}
+
+uint32_t MorseBin::GetSymbolCount() const
+{
+    return symbols;
+}
+
+uint32_t MorseBin::GetWordCount() const
+{
+    return words;
+}
+
+bool MorseBin::IsUppercase() const
+{
+    return uppercase;
+}
+
+/**
+* Append n bits, MSB first
+*
+* @param value
+* @param n
+*/
+void MorseBin::PutBits(uint32_t value, int n)
+{
+    for (int i = n - 1; i >= 0; --i)
+    {
+        if ((bits & 7) == 0) payload.push_back(0);
+        if ((value >> i) & 1) payload.back() |= static_cast<uint8_t>(0x80 >> (bits & 7));
+        bits++;
+    }
+}
+
+/**
+* Read n bits, MSB first
+*
+* @param bit - advanced by n
+* @param n
+* @return uint32_t
+*/
+uint32_t MorseBin::GetBits(uint64_t& bit, int n) const
+{
+    if (bit + n > bits) throw runtime_error("Truncated .mbin payload");
+    uint32_t value = 0;
+    for (int i = 0; i < n; ++i, ++bit)
+    {
+        value = (value << 1) | ((payload[bit >> 3] >> (7 - (bit & 7))) & 1);
+    }
+    return value;
+}
+
+/**
+* Read one symbol as a 0/1 group, empty for a word space
+*
+* @param bit
+* @return string
+*/
+string MorseBin::ReadSymbol(uint64_t& bit) const
+{
+    int len = static_cast<int>(GetBits(bit, LENGTH_BITS));
+    string code(len, '0');
+    uint32_t value = GetBits(bit, len);
+    for (int i = 0; i < len; ++i)
+    {
+        if ((value >> (len - 1 - i)) & 1) code[i] = '1';
+    }
+    return code;
+}
+
+/**
+* Decode count symbols, or count words, from a bit offset with the Morse tables
+*
+* @param bit
+* @param count
+* @param stopAtWords
+* @return string
+*/
+string MorseBin::DecodeRange(uint64_t bit, uint32_t count, bool stopAtWords)
+{
+    // morse_decode trims, so word spaces are added here and words decoded one by one
+    Morse m(uppercase);
+    string line, word;
+    uint32_t n = 0;
+    while (n < count && bit < bits)
+    {
+        string code = ReadSymbol(bit);
+        if (code.empty())
+        {
+            if (!word.empty()) line += m.morse_decode(word);
+            word.clear();
+            if (stopAtWords && ++n == count) break;
+            line += ' ';
+        }
+        else
+        {
+            if (!word.empty()) word += ' ';
+            word += code;
+        }
+        if (!stopAtWords) n++;
+    }
+    if (!word.empty()) line += m.morse_decode(word);
+    return line;
+}
@@ -0,0 +1,215 @@
+#include "morsecache.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+
+/**
+* C++ MorseCache Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+namespace fs = std::filesystem;
+
+/**
+* Constructor
+*
+* @param dir
+* @param max_bytes
+*/
+MorseCache::MorseCache(const string& dir, uintmax_t max_bytes)
+{
+    Dir = fs::path(dir);
+    MaxBytes = max_bytes;
+    error_code ec;
+    fs::create_directories(Dir, ec);
+    LoadStats();
+}
+
+/**
+* Build the cache key for a render, 64 bit FNV-1a of all settings
+*
+* @param morsecode
+* @param tone
+* @param wpm
+* @param sps
+* @param channels
+* @param format
+* @return string
+*/
+string MorseCache::Key(const string& morsecode, double tone, double wpm, double sps, int channels, const string& format)
+{
+    ostringstream s;
+    s << setprecision(17) << morsecode << '|' << tone << '|' << wpm << '|' << sps << '|' << channels << '|' << format;
+    string str = s.str();
+
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : str)
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    ostringstream hex;
+    hex << std::hex << setw(16) << setfill('0') << hash;
+    return hex.str();
+}
+
+/**
+* Path of a cache entry
+*
+* @param key
+* @param ext
+* @return path
+*/
+fs::path MorseCache::EntryPath(const string& key, const string& ext)
+{
+    return Dir / (key + ext);
+}
+
+/**
+* Copy from to to, never a link: the user's file and the cache entry
+* must not share data or times
+*
+* @param from
+* @param to
+* @return bool
+*/
+bool MorseCache::Copy(const fs::path& from, const fs::path& to)
+{
+    error_code ec;
+    fs::copy_file(from, to, fs::copy_options::overwrite_existing, ec);
+    return !ec;
+}
+
+/**
+* Put a cached copy of key at dest
+*
+* @param key
+* @param dest
+* @return bool
+*/
+bool MorseCache::Fetch(const string& key, const string& dest)
+{
+    lock_guard<mutex> guard(lock);
+    fs::path to(dest);
+    fs::path entry = EntryPath(key, to.extension().string());
+    error_code ec;
+    if (!fs::exists(entry, ec))
+    {
+        misses++;
+        SaveStats();
+        return false;
+    }
+    fs::create_directories(to.parent_path(), ec);
+    if (!Copy(entry, to))
+    {
+        misses++;
+        SaveStats();
+        return false;
+    }
+    // mark the entry as most recently used, dest is a copy and keeps its own time
+    fs::last_write_time(entry, fs::file_time_type::clock::now(), ec);
+    hits++;
+    SaveStats();
+    return true;
+}
+
+/**
+* Add a rendered file to the cache and evict old entries
+*
+* @param key
+* @param src
+*/
+void MorseCache::Store(const string& key, const string& src)
+{
+    lock_guard<mutex> guard(lock);
+    fs::path from(src);
+    fs::path entry = EntryPath(key, from.extension().string());
+    if (Copy(from, entry))
+    {
+        error_code ec;
+        fs::last_write_time(entry, fs::file_time_type::clock::now(), ec);
+    }
+    Evict();
+}
+
+/**
+* Remove least recently used entries until the cache fits in MaxBytes
+*/
+void MorseCache::Evict()
+{
+    struct Entry { fs::path path; fs::file_time_type time; uintmax_t size; };
+    vector<Entry> entries;
+    uintmax_t total = 0;
+    error_code ec;
+    for (const auto& it : fs::directory_iterator(Dir, ec))
+    {
+        if (!it.is_regular_file(ec) || it.path().filename() == "stats.txt") continue;
+        Entry e{ it.path(), it.last_write_time(ec), it.file_size(ec) };
+        total += e.size;
+        entries.push_back(e);
+    }
+    if (total <= MaxBytes) return;
+
+    sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+    for (const Entry& e : entries)
+    {
+        if (total <= MaxBytes) break;
+        if (fs::remove(e.path, ec))
+        {
+            total -= e.size;
+            evictions++;
+        }
+    }
+    SaveStats();
+}
+
+/**
+* Load persistent statistics
+*/
+void MorseCache::LoadStats()
+{
+    ifstream in(Dir / "stats.txt");
+    if (in.is_open()) in >> hits >> misses >> evictions;
+}
+
+/**
+* Save persistent statistics
+*/
+void MorseCache::SaveStats()
+{
+    ofstream out(Dir / "stats.txt", ios::trunc);
+    if (out.is_open()) out << hits << ' ' << misses << ' ' << evictions << '\n';
+}
+
+/**
+* Get statistics line
+*
+* @return string
+*/
+string MorseCache::GetStats()
+{
+    lock_guard<mutex> guard(lock);
+    uintmax_t total = 0;
+    size_t files = 0;
+    error_code ec;
+    for (const auto& it : fs::directory_iterator(Dir, ec))
+    {
+        if (!it.is_regular_file(ec) || it.path().filename() == "stats.txt") continue;
+        total += it.file_size(ec);
+        files++;
+    }
+    uint64_t lookups = hits + misses;
+    ostringstream s;
+    s << "cache: " << hits << " hits, " << misses << " misses";
+    if (lookups > 0) s << " (" << (100.0 * hits / lookups) << "% hit rate)";
+    s << ", " << evictions << " evictions, " << files << " files, " << (total / 1024.0) << " of " << (MaxBytes / 1024.0) << " kB";
+    return s.str();
+}
+
+uint64_t MorseCache::GetHits() { return hits; }
+uint64_t MorseCache::GetMisses() { return misses; }
@@ -0,0 +1,161 @@
+#include "morsecharlog.h"
+#include "morsekeying.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+/**
+* C++ MorseCharLog Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param path
+* @param format
+* @param samples_per_second
+*/
+MorseCharLog::MorseCharLog(const string& path, int format, double samples_per_second)
+{
+    Format = (format == CHARLOG_JSONL) ? CHARLOG_JSONL : CHARLOG_BINARY;
+    Out = fopen(path.c_str(), "wb");
+    if (!Out)
+    {
+        cerr << "Failed to open file: " << path << '\n';
+        throw runtime_error("Error opening file or directory");
+    }
+    buffer.resize(BUFFER_SIZE);
+    if (Format == CHARLOG_BINARY)
+    {
+        uint8_t header[4 + 1 + 10];
+        memcpy(header, "MCHR", 4);
+        header[4] = VERSION;
+        size_t n = 5 + MorseKeying::PutVarint(static_cast<uint64_t>(samples_per_second), header + 5);
+        Put(reinterpret_cast<const char*>(header), n);
+    }
+}
+
+MorseCharLog::~MorseCharLog()
+{
+    try
+    {
+        Close();
+    }
+    catch (...)
+    {
+    }
+}
+
+/**
+* Append one record
+*
+* @param record
+*/
+void MorseCharLog::Add(const CharRecord& record)
+{
+    if (used + 128 + 6 * record.text.size() > buffer.size()) Flush();
+    float confidence = max(0.0f, min(1.0f, record.confidence));
+    if (Format == CHARLOG_BINARY)
+    {
+        uint8_t* p = reinterpret_cast<uint8_t*>(buffer.data());
+        used += MorseKeying::PutVarint(record.start - min(last, record.start), p + used);
+        used += MorseKeying::PutVarint(record.end - min(record.start, record.end), p + used);
+        p[used++] = static_cast<uint8_t>(lrintf(confidence * 255.0f));
+        used += MorseKeying::PutVarint(2 * record.text.size() + (record.space ? 1 : 0), p + used);
+        memcpy(p + used, record.text.data(), record.text.size());
+        used += record.text.size();
+        last = record.start;
+        return;
+    }
+
+    char* p = buffer.data();
+    memcpy(p + used, "{\"char\":\"", 9);
+    used += 9;
+    for (char c : record.text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            p[used++] = '\\';
+            p[used++] = c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            used += snprintf(p + used, 7, "\\u%04x", c);
+        }
+        else
+        {
+            p[used++] = c;
+        }
+    }
+    memcpy(p + used, "\",\"start\":", 10);
+    used += 10;
+    used += to_chars(p + used, p + used + 20, record.start).ptr - (p + used);
+    memcpy(p + used, ",\"end\":", 7);
+    used += 7;
+    used += to_chars(p + used, p + used + 20, record.end).ptr - (p + used);
+    used += snprintf(p + used, 40, ",\"confidence\":%.2f,\"space\":%s}\n", confidence, record.space ? "true" : "false");
+}
+
+/**
+* Write what is pending and close the file
+*/
+void MorseCharLog::Close()
+{
+    if (!Out) return;
+    FILE* file = Out;
+    try
+    {
+        Flush();
+    }
+    catch (...)
+    {
+        fclose(file);
+        Out = nullptr;
+        throw;
+    }
+    Out = nullptr;
+    if (fclose(file) != 0) throw runtime_error("Error writing character log");
+}
+
+/**
+* Get file extension for a format
+*
+* @param format
+* @return const char*
+*/
+const char* MorseCharLog::GetExtension(int format)
+{
+    return (format == CHARLOG_JSONL) ? ".jsonl" : ".mchr";
+}
+
+/**
+* Append bytes to the buffer
+*
+* @param s
+* @param n
+*/
+void MorseCharLog::Put(const char* s, size_t n)
+{
+    if (used + n > buffer.size()) Flush();
+    memcpy(buffer.data() + used, s, n);
+    used += n;
+}
+
+/**
+* Write the pending buffer
+*/
+void MorseCharLog::Flush()
+{
+    if (used > 0 && fwrite(buffer.data(), 1, used, Out) != used)
+    {
+        throw runtime_error("Error writing character log");
+    }
+    used = 0;
+}
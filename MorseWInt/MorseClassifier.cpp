@@ -0,0 +1,268 @@
+#include "morseclassifier.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+* C++ MorseClassifier Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param unit
+*/
+MorseClassifier::MorseClassifier(double unit)
+{
+    this->unit = (unit > 0.0) ? unit : 1.0;
+    ready.reserve(WARMUP_RUNS);
+}
+
+/**
+* Add a key down or key up run, held back until the speed is known
+*
+* @param key
+* @param length
+*/
+void MorseClassifier::Add(bool key, double length)
+{
+    double start = position;
+    position += length;
+    if (!key && !lastKey) return; // more of a gap that was passed on early
+    lastKey = key;
+    if (locked)
+    {
+        Online(key, length, start);
+        return;
+    }
+    if (!key && warmupMarks == 0) return; // leading silence
+    warmup[warmupRuns++] = { key, length, start };
+    if (key) warmupMarks++;
+    if (warmupMarks >= WARMUP_MARKS || warmupRuns == WARMUP_RUNS) Lock();
+}
+
+/**
+* End of input, complete the last character
+*/
+void MorseClassifier::Flush()
+{
+    if (!locked) Lock();
+    if (count > 0) EndCharacter(RUN_WORD_GAP, 1.0);
+}
+
+/**
+* Get next completed character
+*
+* @param elements
+* @param gap
+* @return bool
+*/
+bool MorseClassifier::Next(string& elements, int& gap)
+{
+    Symbol s;
+    if (!Next(s)) return false;
+    elements = s.elements;
+    gap = s.gap;
+    return true;
+}
+
+/**
+* Get next completed character with its position and confidence
+*
+* @param symbol
+* @return bool
+*/
+bool MorseClassifier::Next(Symbol& symbol)
+{
+    if (readyAt == ready.size()) return false;
+    symbol = ready[readyAt++];
+    if (readyAt == ready.size())
+    {
+        // all taken, the capacity is kept
+        ready.clear();
+        readyAt = 0;
+    }
+    return true;
+}
+
+/**
+* Get current dit length estimate
+*
+* @return double
+*/
+double MorseClassifier::GetUnit() const
+{
+    return unit;
+}
+
+bool MorseClassifier::IsLocked() const
+{
+    return locked;
+}
+
+/**
+* Find the starting speed from the held back runs and replay them.
+* The widest ratio between sorted marks splits dits from dahs; without
+* one, the shortest gap (an element gap, 1 unit) or the given unit tells
+* whether the marks are dits or dahs.
+*/
+void MorseClassifier::Lock()
+{
+    double m[WARMUP_RUNS];
+    int n = 0;
+    double minGap = 0.0;
+    for (int i = 0; i < warmupRuns; ++i)
+    {
+        if (warmup[i].key) m[n++] = warmup[i].length;
+        else if (minGap == 0.0 || warmup[i].length < minGap) minGap = warmup[i].length;
+    }
+
+    if (n > 0)
+    {
+        sort(m, m + n);
+        int split = 0;
+        double ratio = 1.0;
+        for (int i = 0; i + 1 < n; ++i)
+        {
+            if (m[i + 1] / m[i] > ratio)
+            {
+                ratio = m[i + 1] / m[i];
+                split = i + 1;
+            }
+        }
+        double sum = 0.0;
+        for (int i = 0; i < n; ++i) sum += m[i];
+
+        if (ratio > 1.8)
+        {
+            double dits = 0.0, dahs = 0.0;
+            for (int i = 0; i < split; ++i) dits += m[i];
+            for (int i = split; i < n; ++i) dahs += m[i];
+            unit = 0.5 * (dits / split + dahs / (3.0 * (n - split)));
+        }
+        else
+        {
+            double mean = sum / n;
+            bool dahs = (minGap > 0.0 && minGap < 0.6 * mean) || (fabs(log(mean / (3.0 * unit))) < fabs(log(mean / unit)));
+            unit = dahs ? mean / 3.0 : mean;
+        }
+    }
+
+    locked = true;
+    for (int i = 0; i < warmupRuns; ++i) Online(warmup[i].key, warmup[i].length, warmup[i].start);
+    warmupRuns = 0;
+}
+
+/**
+* Classify one run at the current speed, marks wait for the end of the character
+*
+* @param key
+* @param length
+* @param start
+*/
+void MorseClassifier::Online(bool key, double length, double start)
+{
+    if (key)
+    {
+        if (count == 0) charStart = start;
+        if (count < MAX_ELEMENTS) marks[count++] = length;
+        charEnd = start + length;
+        return;
+    }
+    if (count == 0) return; // silence before the first mark
+
+    if (length < 2.0 * unit)
+    {
+        gapMargin = min(gapMargin, Margin(2.0 * unit / length, 2.0));
+        Update(length); // element gap
+        return;
+    }
+    if (length < 4.0 * unit)
+    {
+        double margin = min(Margin(length / (2.0 * unit), 1.5), Margin(4.0 * unit / length, 4.0 / 3.0));
+        Update(length / 3.0);
+        EndCharacter(RUN_CHAR_GAP, margin);
+        return;
+    }
+    EndCharacter(RUN_WORD_GAP, Margin(length / (4.0 * unit), 1.25)); // long pauses say nothing about the speed
+}
+
+/**
+* Classify the marks of a character and update the speed from them
+*
+* @param gap
+* @param margin - of the gap that ends it
+*/
+void MorseClassifier::EndCharacter(int gap, double margin)
+{
+    double lo = *min_element(marks, marks + count);
+    double hi = *max_element(marks, marks + count);
+    double threshold;
+
+    if (hi > 2.0 * lo)
+    {
+        // dits and dahs in one character
+        threshold = sqrt(lo * hi);
+        double dits = 0.0, dahs = 0.0;
+        int nd = 0, nh = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            if (marks[i] < threshold) { dits += marks[i]; nd++; }
+            else { dahs += marks[i]; nh++; }
+        }
+        double u = 0.5 * (dits / nd + dahs / (3.0 * nh));
+        if (u < 0.5 * unit || u > 2.0 * unit) unit = u; // speed change
+    }
+    else
+    {
+        double mean = 0.0;
+        for (int i = 0; i < count; ++i) mean += marks[i];
+        mean /= count;
+        if (mean < 0.5 * unit) unit = mean;             // dits, faster
+        else if (mean > 4.5 * unit) unit = mean / 3.0;  // dahs, slower
+        threshold = 2.0 * unit;
+    }
+
+    Symbol s;
+    s.gap = gap;
+    s.start = charStart;
+    s.end = charEnd;
+    s.confidence = min(margin, gapMargin);
+    for (int i = 0; i < count; ++i)
+    {
+        bool dit = marks[i] < threshold;
+        s.elements += dit ? '.' : '-';
+        s.confidence = min(s.confidence, Margin(dit ? threshold / marks[i] : marks[i] / threshold, sqrt(3.0)));
+        Update(dit ? marks[i] : marks[i] / 3.0);
+    }
+    ready.push_back(s);
+    count = 0;
+    gapMargin = 1.0;
+}
+
+/**
+* Move the dit estimate towards one observed unit length
+*
+* @param unitLength
+*/
+void MorseClassifier::Update(double unitLength)
+{
+    unit += ALPHA * (unitLength - unit);
+}
+
+/**
+* Timing margin of a run: its log distance from a class boundary as a
+* part of that of an ideal run, 0 to 1
+*
+* @param ratio - run over boundary, or boundary over run
+* @param ideal - the same ratio for an ideal run
+* @return double
+*/
+double MorseClassifier::Margin(double ratio, double ideal)
+{
+    return max(0.0, min(1.0, log(ratio) / log(ideal)));
+}
@@ -0,0 +1,234 @@
+#include "morsecodec.h"
+#include <cstring>
+
+/**
+* C++ MorseCodec Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* G.711 lookup tables, mu-law uses the top 14 bits, A-law the top 13 bits
+* of a 16 bit sample (same results as the reference g711.c)
+*/
+struct G711Tables
+{
+    uint8_t mulaw[1 << 14];
+    uint8_t alaw[1 << 13];
+
+    G711Tables()
+    {
+        static const int seg_uend[8] = { 0x3F, 0x7F, 0xFF, 0x1FF, 0x3FF, 0x7FF, 0xFFF, 0x1FFF };
+        static const int seg_aend[8] = { 0x1F, 0x3F, 0x7F, 0xFF, 0x1FF, 0x3FF, 0x7FF, 0xFFF };
+
+        for (int i = 0; i < (1 << 14); ++i)
+        {
+            int pcm = static_cast<int16_t>(i << 2) >> 2;
+            int mask = 0xFF;
+            if (pcm < 0)
+            {
+                pcm = -pcm;
+                mask = 0x7F;
+            }
+            if (pcm > 8159) pcm = 8159;
+            pcm += (0x84 >> 2);
+            int seg = 0;
+            while (seg < 8 && pcm > seg_uend[seg]) seg++;
+            int uval = (seg >= 8) ? 0x7F : ((seg << 4) | ((pcm >> (seg + 1)) & 0xF));
+            mulaw[i] = static_cast<uint8_t>(uval ^ mask);
+        }
+
+        for (int i = 0; i < (1 << 13); ++i)
+        {
+            int pcm = static_cast<int16_t>(i << 3) >> 3;
+            int mask = 0xD5;
+            if (pcm < 0)
+            {
+                mask = 0x55;
+                pcm = -pcm - 1;
+            }
+            int seg = 0;
+            while (seg < 8 && pcm > seg_aend[seg]) seg++;
+            int aval = 0x7F;
+            if (seg < 8)
+            {
+                aval = seg << 4;
+                aval |= (seg < 2) ? ((pcm >> 1) & 0xF) : ((pcm >> seg) & 0xF);
+            }
+            alaw[i] = static_cast<uint8_t>(aval ^ mask);
+        }
+    }
+};
+
+static const G711Tables& Tables()
+{
+    static const G711Tables tables;
+    return tables;
+}
+
+// IMA ADPCM step sizes and index changes
+static const int IMA_STEP[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+static const int IMA_INDEX[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+/**
+* Constructor
+*
+* @param channels
+*/
+MorseCodec::MorseCodec(int channels)
+{
+    NumChannels = (channels == 2) ? 2 : 1;
+    pred[0] = pred[1] = 0;
+    index[0] = index[1] = 0;
+}
+
+/**
+* G.711 mu-law
+*
+* @param in
+* @param out
+* @param n
+*/
+void MorseCodec::MuLaw(const int16_t* in, uint8_t* out, size_t n)
+{
+    const uint8_t* table = Tables().mulaw;
+    for (size_t i = 0; i < n; ++i) out[i] = table[static_cast<uint16_t>(in[i]) >> 2];
+}
+
+/**
+* G.711 A-law
+*
+* @param in
+* @param out
+* @param n
+*/
+void MorseCodec::ALaw(const int16_t* in, uint8_t* out, size_t n)
+{
+    const uint8_t* table = Tables().alaw;
+    for (size_t i = 0; i < n; ++i) out[i] = table[static_cast<uint16_t>(in[i]) >> 3];
+}
+
+/**
+* ADPCM block size in bytes
+*
+* @param channels
+* @param sps
+* @return size_t
+*/
+size_t MorseCodec::ImaBlockAlign(int channels, double sps)
+{
+    size_t perChannel = (sps <= 11025.0) ? 256 : (sps <= 22050.0) ? 512 : 1024;
+    return perChannel * ((channels == 2) ? 2 : 1);
+}
+
+/**
+* ADPCM samples per channel in one block, the header holds the first one
+*
+* @param block_align
+* @param channels
+* @return size_t
+*/
+size_t MorseCodec::ImaSamplesPerBlock(size_t block_align, int channels)
+{
+    size_t ch = (channels == 2) ? 2 : 1;
+    return (block_align - 4 * ch) * 2 / ch + 1;
+}
+
+/**
+* Encode one sample to a 4 bit code and update the channel state
+*
+* @param channel
+* @param sample
+* @return uint8_t
+*/
+uint8_t MorseCodec::ImaNibble(int channel, int sample)
+{
+    int step = IMA_STEP[index[channel]];
+    int diff = sample - pred[channel];
+    uint8_t nibble = 0;
+    if (diff < 0)
+    {
+        nibble = 8;
+        diff = -diff;
+    }
+    int vpdiff = step >> 3;
+    if (diff >= step) { nibble |= 4; diff -= step; vpdiff += step; }
+    step >>= 1;
+    if (diff >= step) { nibble |= 2; diff -= step; vpdiff += step; }
+    step >>= 1;
+    if (diff >= step) { nibble |= 1; vpdiff += step; }
+
+    int p = (nibble & 8) ? pred[channel] - vpdiff : pred[channel] + vpdiff;
+    if (p > 32767) p = 32767;
+    else if (p < -32768) p = -32768;
+    pred[channel] = p;
+
+    int idx = index[channel] + IMA_INDEX[nibble];
+    if (idx < 0) idx = 0;
+    else if (idx > 88) idx = 88;
+    index[channel] = idx;
+    return nibble;
+}
+
+/**
+* Encode one ADPCM block
+*
+* @param in
+* @param frames
+* @param out
+* @param block_align
+*/
+void MorseCodec::ImaBlock(const int16_t* in, size_t frames, uint8_t* out, size_t block_align)
+{
+    const size_t perBlock = ImaSamplesPerBlock(block_align, NumChannels);
+    auto sample = [&](size_t i, int ch) -> int { return (i < frames) ? in[i * NumChannels + ch] : 0; };
+
+    // header per channel: first sample, step index, reserved
+    for (int ch = 0; ch < NumChannels; ++ch)
+    {
+        pred[ch] = sample(0, ch);
+        uint8_t* h = out + ch * 4;
+        h[0] = static_cast<uint8_t>(pred[ch] & 0xFF);
+        h[1] = static_cast<uint8_t>((pred[ch] >> 8) & 0xFF);
+        h[2] = static_cast<uint8_t>(index[ch]);
+        h[3] = 0;
+    }
+    uint8_t* data = out + NumChannels * 4;
+
+    if (NumChannels == 1)
+    {
+        // two samples per byte, low nibble first
+        for (size_t i = 1; i < perBlock; i += 2)
+        {
+            uint8_t lo = ImaNibble(0, sample(i, 0));
+            uint8_t hi = ImaNibble(0, sample(i + 1, 0));
+            *data++ = static_cast<uint8_t>(lo | (hi << 4));
+        }
+    }
+    else
+    {
+        // 4 bytes (8 samples) of the left channel, then 4 bytes of the right channel
+        for (size_t i = 1; i < perBlock; i += 8)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                for (size_t j = 0; j < 8; j += 2)
+                {
+                    uint8_t lo = ImaNibble(ch, sample(i + j, ch));
+                    uint8_t hi = ImaNibble(ch, sample(i + j + 1, ch));
+                    *data++ = static_cast<uint8_t>(lo | (hi << 4));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,217 @@
+#define _USE_MATH_DEFINES // Required for MSVC/Windows
+#include "morsedecimator.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+* C++ MorseDecimator Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param tone
+* @param samples_per_second
+*/
+MorseDecimator::MorseDecimator(double tone, double samples_per_second)
+{
+    Tone = tone;
+    Sps = samples_per_second;
+    R = max<size_t>(1, static_cast<size_t>(Sps / (2.0 * OUT_RATE) + 0.5));
+
+    // block sums of the mixed samples, plain and weighted by the position
+    double w = 2.0 * M_PI * Tone / Sps;
+    mixI.resize(R);
+    mixQ.resize(R);
+    rampI.resize(R);
+    rampQ.resize(R);
+    for (size_t k = 0; k < R; ++k)
+    {
+        mixI[k] = static_cast<float>(cos(w * k));
+        mixQ[k] = static_cast<float>(-sin(w * k));
+        rampI[k] = static_cast<float>(k * cos(w * k));
+        rampQ[k] = static_cast<float>(-(k * sin(w * k)));
+    }
+    rotate = polar(1.0, -w * R);
+
+    // half band: every other tap is zero, the middle one is 1 / 2, the
+    // odd ones are kept once as the filter is symmetric
+    const int mid = HALF_BAND_TAPS / 2;
+    double sum = 0.5;
+    for (int n = 1; n <= mid; n += 2)
+    {
+        double sinc = sin(M_PI * n / 2.0) / (M_PI * n);
+        double blackman = 0.42 + 0.5 * cos(M_PI * n / (mid + 1)) + 0.08 * cos(2.0 * M_PI * n / (mid + 1));
+        halfBand.push_back(static_cast<float>(sinc * blackman));
+        sum += 2.0 * halfBand.back();
+    }
+    for (float& h : halfBand) h = static_cast<float>(h / sum);
+    center = static_cast<float>(0.5 / sum);
+
+    midI.assign(HALF_BAND_TAPS - 1, 0.0f);
+    midQ.assign(HALF_BAND_TAPS - 1, 0.0f);
+}
+
+/**
+* Feed mono samples
+*
+* @param mono
+* @param n
+* @param out
+*/
+void MorseDecimator::Process(const int16_t* mono, size_t n, vector<complex<float>>& out)
+{
+    size_t at = input.size();
+    input.resize(at + n);
+    for (size_t i = 0; i < n; ++i) input[at + i] = mono[i];
+    Stage1(out);
+}
+
+/**
+* Size the buffers for Process calls of up to frames samples
+*
+* @param frames
+*/
+void MorseDecimator::Reserve(size_t frames)
+{
+    input.reserve(frames + R);
+    midI.reserve(4 * HALF_BAND_TAPS);
+    midQ.reserve(4 * HALF_BAND_TAPS);
+}
+
+/**
+* Push silence through both stages
+*
+* @param out
+*/
+void MorseDecimator::Flush(vector<complex<float>>& out)
+{
+    input.resize(input.size() + 2 * R * (HALF_BAND_TAPS + 1), 0.0f);
+    Stage1(out);
+}
+
+/**
+* Get output samples per second
+*
+* @return double
+*/
+double MorseDecimator::GetRate() const
+{
+    return Sps / GetFactor();
+}
+
+/**
+* Get input samples per output sample
+*
+* @return size_t
+*/
+size_t MorseDecimator::GetFactor() const
+{
+    return 2 * R;
+}
+
+/**
+* Get group delay of both stages: output n is centred on input sample
+* 2nR - (HALF_BAND_TAPS / 2) R - 1
+*
+* @return double
+*/
+double MorseDecimator::GetDelay() const
+{
+    return static_cast<double>(HALF_BAND_TAPS / 2) * R + 1.0;
+}
+
+/**
+* Mix and decimate by R. The triangle over blocks m and m + 1 is
+* (B(m) + A(m)) + ((R - 1) A(m + 1) - B(m + 1)), where A is the sum of the
+* mixed samples of a block and B the sum weighted by their position, so
+* every input sample takes four multiply adds in four dot products
+*
+* @param out
+*/
+void MorseDecimator::Stage1(vector<complex<float>>& out)
+{
+    const float* mi = mixI.data();
+    const float* mq = mixQ.data();
+    const float* ri = rampI.data();
+    const float* rq = rampQ.data();
+    const double scale = 1.0 / (static_cast<double>(R) * R);
+    size_t at = 0;
+    for (; at + R <= input.size(); at += R)
+    {
+        const float* x = input.data() + at;
+        // four lanes per sum, the inner loop is one SIMD multiply add
+        float ai4[4] = { 0 }, aq4[4] = { 0 }, bi4[4] = { 0 }, bq4[4] = { 0 };
+        size_t k = 0;
+        for (; k + 4 <= R; k += 4)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                ai4[j] += x[k + j] * mi[k + j];
+                aq4[j] += x[k + j] * mq[k + j];
+                bi4[j] += x[k + j] * ri[k + j];
+                bq4[j] += x[k + j] * rq[k + j];
+            }
+        }
+        for (int j = 0; k < R; ++k, ++j)
+        {
+            ai4[j] += x[k] * mi[k];
+            aq4[j] += x[k] * mq[k];
+            bi4[j] += x[k] * ri[k];
+            bq4[j] += x[k] * rq[k];
+        }
+        float ai = (ai4[0] + ai4[1]) + (ai4[2] + ai4[3]);
+        float aq = (aq4[0] + aq4[1]) + (aq4[2] + aq4[3]);
+        float bi = (bi4[0] + bi4[1]) + (bi4[2] + bi4[3]);
+        float bq = (bq4[0] + bq4[1]) + (bq4[2] + bq4[3]);
+        complex<double> a = phasor * complex<double>(ai, aq);
+        complex<double> b = phasor * complex<double>(bi, bq);
+        phasor *= rotate;
+
+        complex<double> z = (lastB + lastA + static_cast<double>(R - 1) * a - b) * scale;
+        lastA = a;
+        lastB = b;
+        Stage2(static_cast<float>(z.real()), static_cast<float>(z.imag()), out);
+    }
+    phasor /= abs(phasor); // keep the phasor on the unit circle
+
+    // keep the samples of the next block
+    input.erase(input.begin(), input.begin() + at);
+}
+
+/**
+* Half band filter and decimate by 2
+*
+* @param i
+* @param q
+* @param out
+*/
+void MorseDecimator::Stage2(float i, float q, vector<complex<float>>& out)
+{
+    midI.push_back(i);
+    midQ.push_back(q);
+    odd = !odd;
+    if (odd)
+    {
+        const int mid = HALF_BAND_TAPS / 2;
+        const float* xi = midI.data() + midI.size() - HALF_BAND_TAPS + mid;
+        const float* xq = midQ.data() + midQ.size() - HALF_BAND_TAPS + mid;
+        float yi = center * xi[0], yq = center * xq[0];
+        for (int t = 0, n = 1; n <= mid; ++t, n += 2)
+        {
+            yi += halfBand[t] * (xi[-n] + xi[n]);
+            yq += halfBand[t] * (xq[-n] + xq[n]);
+        }
+        out.push_back(complex<float>(yi, yq));
+    }
+    if (midI.size() >= 4 * HALF_BAND_TAPS)
+    {
+        midI.erase(midI.begin(), midI.end() - (HALF_BAND_TAPS - 1));
+        midQ.erase(midQ.begin(), midQ.end() - (HALF_BAND_TAPS - 1));
+    }
+}
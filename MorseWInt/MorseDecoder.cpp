@@ -0,0 +1,496 @@
+#define _USE_MATH_DEFINES // Required for MSVC/Windows
+#include "morsedecoder.h"
+#include "morsetiming.h"
+#include "morsefft.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/**
+* C++ MorseDecoder Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param tone
+* @param samples_per_second
+* @param wpm
+* @param uppercase
+* @param matched_filter
+* @param beam_width
+*/
+MorseDecoder::MorseDecoder(double tone, double samples_per_second, double wpm, bool uppercase, bool matched_filter, int beam_width)
+    : morse(uppercase), classifier(1.0)
+{
+    Tone = tone;
+    Sps = samples_per_second;
+    Wpm = (wpm > 0.0) ? wpm : 20.0;
+    Rate = Sps;
+    // a Goertzel block costs about what decimation does, the matched filter much more
+    if (Sps >= (matched_filter ? DECIMATE_SPS_MATCHED : DECIMATE_SPS))
+    {
+        decimator = make_unique<MorseDecimator>(Tone, Sps);
+        Rate = decimator->GetRate();
+    }
+
+    // blocks fit the fastest speed, the classifier follows slower ones
+    BlockSize = max<size_t>(MorseTiming::SamplesPerUnit(max(Wpm, MAX_WPM), Rate) / BLOCKS_PER_UNIT, 1);
+    classifier = MorseClassifier(static_cast<double>(MorseTiming::SamplesPerUnit(Wpm, Rate)) / BlockSize);
+    coeff = 2.0 * cos(2.0 * M_PI * Tone / Sps);
+
+    // peak falls to half in about 2 seconds, long enough to span word gaps
+    double blocksPerSecond = Rate / BlockSize;
+    peakDecay = pow(0.5, 1.0 / (2.0 * blocksPerSecond));
+
+    if (matched_filter && decimator)
+    {
+        dit.assign(max<size_t>(MorseTiming::SamplesPerUnit(Wpm, Rate), 1), 0.0f);
+    }
+    else if (matched_filter)
+    {
+        size_t length = MorseTiming::SamplesPerUnit(Wpm, Sps);
+        matched = make_unique<MorseMatchedFilter>(Tone, Sps, length, BlockSize);
+    }
+
+    // run positions are in blocks, records in input samples
+    BlockSamples = static_cast<double>(BlockSize) * (decimator ? decimator->GetFactor() : 1);
+    Delay = decimator ? decimator->GetDelay() : 0.0;
+    if (matched) Delay += 0.5 * matched->GetLength();   // a level is over the last dit
+    if (!dit.empty()) Delay += 0.5 * dit.size() * decimator->GetFactor();
+
+    if (beam_width > 0)
+    {
+        beam = make_unique<MorseBeam>(classifier.GetUnit(), uppercase, beam_width);
+    }
+}
+
+/**
+* Train the character bigram model of the beam search back end
+*
+* @param text
+*/
+void MorseDecoder::TrainBigram(const string& text)
+{
+    if (beam) beam->TrainBigram(text);
+}
+
+/**
+* Start over on a new recording at the same sample rate
+*
+* @param tone
+*/
+void MorseDecoder::Reset(double tone)
+{
+    Tone = tone;
+    coeff = 2.0 * cos(2.0 * M_PI * Tone / Sps);
+    if (decimator) decimator = make_unique<MorseDecimator>(Tone, Sps);
+    if (matched) matched = make_unique<MorseMatchedFilter>(Tone, Sps, matched->GetLength(), BlockSize);
+    s1 = s2 = 0.0;
+    inBlock = 0;
+    levels.clear();
+    baseband.clear();
+    blockSum = 0.0;
+    fill(dit.begin(), dit.end(), complex<float>(0.0f));
+    ditSum = 0.0;
+    ditAt = 0;
+
+    classifier = MorseClassifier(static_cast<double>(MorseTiming::SamplesPerUnit(Wpm, Rate)) / BlockSize);
+    if (beam) beam->Reset(classifier.GetUnit());
+    peak = 0.0;
+    floor = 0.0;
+    key = false;
+    runBlocks = 0;
+    runSent = 0;
+    flushBlocks = WORD_FLUSH_UNITS * classifier.GetUnit();
+    records.clear();
+    recordAt = 0;
+    MorseCode.clear();
+    Text.clear();
+    word.clear();
+}
+
+/**
+* Keep a record of every decoded character
+*
+* @param keep
+*/
+void MorseDecoder::KeepRecords(bool keep)
+{
+    Records = keep;
+    if (!keep || !symbols.empty()) return;
+    records.reserve(64);
+    // node n of a binary tree is the code of its path, 2n dit, 2n + 1 dah
+    for (int node = 2; node < (1 << 9); ++node)
+    {
+        int top = 0;
+        while ((node >> (top + 1)) != 0) ++top; // the leading 1 is the root
+        string elements;
+        for (int bit = top - 1; bit >= 0; --bit) elements += ((node >> bit) & 1) ? '-' : '.';
+        symbols.emplace(elements, morse.morse_decode(elements));
+    }
+}
+
+/**
+* Collect the morse code and text
+*
+* @param keep
+*/
+void MorseDecoder::KeepTextOutput(bool keep)
+{
+    KeepText = keep;
+}
+
+/**
+* Get next character record
+*
+* @param record
+* @return bool
+*/
+bool MorseDecoder::NextRecord(CharRecord& record)
+{
+    if (recordAt == records.size()) return false;
+    record = records[recordAt++];
+    if (recordAt == records.size())
+    {
+        // all taken, the capacity is kept
+        records.clear();
+        recordAt = 0;
+    }
+    return true;
+}
+
+/**
+* Size the buffers for Process calls of up to frames samples
+*
+* @param frames
+*/
+void MorseDecoder::Reserve(size_t frames)
+{
+    if (decimator)
+    {
+        decimator->Reserve(frames);
+        baseband.reserve(frames / decimator->GetFactor() + 2);
+    }
+    if (matched) levels.reserve((frames + matched->GetSize()) / BlockSize + 2);
+}
+
+/**
+* Feed mono samples, Goertzel over blocks of BlockSize samples or the
+* matched filter sampled every BlockSize samples, on baseband when the
+* input is decimated
+*
+* @param mono
+* @param n
+*/
+void MorseDecoder::Process(const int16_t* mono, size_t n)
+{
+    if (decimator)
+    {
+        decimator->Process(mono, n, baseband);
+        for (complex<float> z : baseband) Baseband(z);
+        baseband.clear();
+        return;
+    }
+    if (matched)
+    {
+        matched->Process(mono, n, levels);
+        for (double level : levels) Block(level);
+        levels.clear();
+        return;
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        double s = mono[i] + coeff * s1 - s2;
+        s2 = s1;
+        s1 = s;
+        if (++inBlock == BlockSize)
+        {
+            double power = s1 * s1 + s2 * s2 - coeff * s1 * s2;
+            Block(sqrt(max(power, 0.0)) / BlockSize);
+            s1 = s2 = 0.0;
+            inBlock = 0;
+        }
+    }
+}
+
+/**
+* Flush the last run, character and word
+*/
+void MorseDecoder::Finish()
+{
+    if (decimator)
+    {
+        decimator->Flush(baseband);
+        for (complex<float> z : baseband) Baseband(z);
+        baseband.clear();
+    }
+    if (matched)
+    {
+        matched->Flush(levels);
+        for (double level : levels) Block(level);
+        levels.clear();
+    }
+    if (runBlocks > runSent) Run(key, runBlocks - runSent);
+    runBlocks = 0;
+    runSent = 0;
+    if (beam)
+    {
+        beam->Flush();
+        return;
+    }
+    classifier.Flush();
+    Drain();
+    EndWord();
+    while (!MorseCode.empty() && MorseCode.back() == ' ') MorseCode.pop_back();
+    while (!Text.empty() && Text.back() == ' ') Text.pop_back();
+}
+
+/**
+* Decode a whole wav file
+*
+* @param reader
+*/
+void MorseDecoder::Decode(MorseWavReader& reader)
+{
+    vector<int16_t> buffer(READ_FRAMES);
+    size_t n;
+    while ((n = reader.Read(buffer.data(), buffer.size())) > 0)
+    {
+        Process(buffer.data(), n);
+    }
+    Finish();
+}
+
+/**
+* Decode a whole wav file with character records
+*
+* @param reader
+* @param log
+*/
+void MorseDecoder::Decode(MorseWavReader& reader, MorseCharLog& log)
+{
+    KeepRecords(true);
+    vector<int16_t> buffer(READ_FRAMES);
+    CharRecord r;
+    size_t n;
+    while ((n = reader.Read(buffer.data(), buffer.size())) > 0)
+    {
+        Process(buffer.data(), n);
+        while (NextRecord(r)) log.Add(r);
+    }
+    Finish();
+    while (NextRecord(r)) log.Add(r);
+}
+
+/**
+* Estimate the dominant tone from the first seconds of a wav
+*
+* @param reader
+* @param seconds
+* @return double
+*/
+double MorseDecoder::EstimateTone(MorseWavReader& reader, double seconds)
+{
+    vector<int16_t> mono(static_cast<size_t>(seconds * reader.GetSps()));
+    size_t n = 0, got;
+    while (n < mono.size() && (got = reader.Read(mono.data() + n, mono.size() - n)) > 0) n += got;
+    reader.Rewind();
+    return EstimateTone(mono.data(), n, reader.GetSps());
+}
+
+/**
+* Estimate the dominant tone
+*
+* @param mono
+* @param n
+* @param samples_per_second
+* @return double
+*/
+double MorseDecoder::EstimateTone(const int16_t* mono, size_t n, double samples_per_second)
+{
+    size_t size = MorseFft::Pow2(static_cast<size_t>(samples_per_second / 10.0));
+    if (size < 64) size = 64;
+    if (n < size) return 0.0;
+
+    MorseFft fft(size);
+    vector<double> window(size), frame(size), power(size / 2 + 1, 0.0);
+    vector<complex<double>> bins(size / 2 + 1);
+    MorseFft::Hann(window.data(), size);
+
+    for (size_t start = 0; start + size <= n; start += size)
+    {
+        for (size_t i = 0; i < size; ++i) frame[i] = mono[start + i] * window[i];
+        fft.Real(frame.data(), bins.data());
+        for (size_t k = 0; k < bins.size(); ++k) power[k] += norm(bins[k]);
+    }
+
+    double binHz = samples_per_second / size;
+    size_t lo = max<size_t>(2, static_cast<size_t>(MIN_TONE / binHz));
+    size_t hi = min(power.size() - 2, static_cast<size_t>(MAX_TONE / binHz));
+    size_t best = 0;
+    for (size_t k = lo; k <= hi; ++k)
+    {
+        if (best == 0 || power[k] > power[best]) best = k;
+    }
+    if (best == 0 || power[best] <= 0.0) return 0.0;
+
+    // Gaussian interpolation, exact for the Hann window main lobe shape
+    double a = log(power[best - 1] + 1e-12), b = log(power[best]), c = log(power[best + 1] + 1e-12);
+    double d = a - 2.0 * b + c;
+    double delta = (d < 0.0) ? 0.5 * (a - c) / d : 0.0;
+    return (best + delta) * binHz;
+}
+
+const string& MorseDecoder::GetMorseCode() const
+{
+    return beam ? beam->GetMorseCode() : MorseCode;
+}
+
+const string& MorseDecoder::GetText() const
+{
+    return beam ? beam->GetText() : Text;
+}
+
+/**
+* Get current speed estimate, 1.2 / wpm seconds per unit
+*
+* @return double
+*/
+double MorseDecoder::GetWpm() const
+{
+    double unit = beam ? beam->GetUnit() : classifier.GetUnit();
+    return 1.2 * Rate / (unit * BlockSize);
+}
+
+/**
+* One baseband sample, the tone is at 0 Hz: a block level is the
+* magnitude of the mean over the block (Goertzel at 0 Hz), the matched
+* filter level that of the mean over the last dit
+*
+* @param z
+*/
+void MorseDecoder::Baseband(complex<float> z)
+{
+    if (!dit.empty())
+    {
+        ditSum += complex<double>(z) - complex<double>(dit[ditAt]);
+        dit[ditAt] = z;
+        if (++ditAt == dit.size()) ditAt = 0;
+    }
+    else
+    {
+        blockSum += complex<double>(z);
+    }
+    if (++inBlock == BlockSize)
+    {
+        Block(dit.empty() ? abs(blockSum) / BlockSize : abs(ditSum) / dit.size());
+        blockSum = 0.0;
+        inBlock = 0;
+    }
+}
+
+/**
+* Threshold one block level into key down / key up, halfway between the
+* noise floor and the peak with some hysteresis
+*
+* @param level
+*/
+void MorseDecoder::Block(double level)
+{
+    peak = max(level, peak * peakDecay);
+    floor = (level < floor) ? level : floor + (level - floor) * 0.01;
+
+    double span = peak - floor;
+    bool down = key ? (level > floor + span * 0.4) : (level > floor + span * 0.6);
+    if (peak < 1.0) down = false; // digital silence
+
+    if (down != key && runBlocks > 0)
+    {
+        if (runBlocks > runSent) Run(key, runBlocks - runSent);
+        runBlocks = 0;
+        runSent = 0;
+    }
+    key = down;
+    runBlocks++;
+
+    // a key up this long is a word gap whatever follows, the rest of it
+    // only moves the classifier position; not before the speed is known,
+    // with a wrong -wpm a character gap can be 5 units long
+    if (!key && runSent == 0 && runBlocks >= flushBlocks && !beam && classifier.IsLocked())
+    {
+        Run(false, runBlocks);
+        runSent = runBlocks;
+    }
+}
+
+/**
+* Pass a run to the adaptive classifier and take the characters it
+* completes, or to the beam search
+*
+* @param down
+* @param blocks
+*/
+void MorseDecoder::Run(bool down, uint64_t blocks)
+{
+    if (beam)
+    {
+        beam->Add(down, static_cast<double>(blocks));
+        return;
+    }
+    classifier.Add(down, static_cast<double>(blocks));
+    flushBlocks = WORD_FLUSH_UNITS * classifier.GetUnit();
+    Drain();
+}
+
+/**
+* Take completed characters from the classifier
+*/
+void MorseDecoder::Drain()
+{
+    MorseClassifier::Symbol s;
+    while (classifier.Next(s))
+    {
+        if (Records) Record(s);
+        if (!KeepText) continue;
+        if (!word.empty()) word += ' ';
+        word += s.elements;
+        MorseCode += s.elements + " ";
+        if (s.gap == RUN_WORD_GAP) EndWord();
+    }
+}
+
+/**
+* Turn a character of the classifier into a record, block positions to
+* input samples, the text from the table made by KeepRecords
+*
+* @param symbol
+*/
+void MorseDecoder::Record(const MorseClassifier::Symbol& symbol)
+{
+    auto it = symbols.find(symbol.elements);
+
+    CharRecord r;
+    r.text = (it != symbols.end()) ? it->second : "?";  // longer than the tables go
+    r.start = static_cast<uint64_t>(max(0.0, symbol.start * BlockSamples - Delay) + 0.5);
+    r.end = static_cast<uint64_t>(max(0.0, symbol.end * BlockSamples - Delay) + 0.5);
+    r.confidence = (r.text == "?") ? 0.0f : static_cast<float>(symbol.confidence);
+    r.space = symbol.gap == RUN_WORD_GAP;
+    records.push_back(r);
+}
+
+/**
+* Word gap, decode the word with the Morse tables
+*/
+void MorseDecoder::EndWord()
+{
+    if (word.empty()) return;
+    Text += morse.morse_decode(word) + " ";
+    MorseCode += " ";
+    word.clear();
+}
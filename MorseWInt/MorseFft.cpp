@@ -0,0 +1,125 @@
+#define _USE_MATH_DEFINES // Required for MSVC/Windows
+#include "morsefft.h"
+#include <cmath>
+#include <stdexcept>
+
+/**
+* C++ MorseFft Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param n
+*/
+MorseFft::MorseFft(size_t n)
+{
+    if (n < 4 || (n & (n - 1)) != 0) throw invalid_argument("FFT size must be a power of two >= 4");
+    N = n;
+    M = n / 2;
+
+    int bits = 0;
+    while ((size_t(1) << bits) < M) bits++;
+    rev.resize(M);
+    for (size_t i = 0; i < M; ++i)
+    {
+        size_t r = 0;
+        for (int b = 0; b < bits; ++b) r |= ((i >> b) & 1) << (bits - 1 - b);
+        rev[i] = r;
+    }
+
+    twiddle.resize(M / 2);
+    for (size_t j = 0; j < M / 2; ++j) twiddle[j] = polar(1.0, -2.0 * M_PI * j / M);
+    split.resize(M + 1);
+    for (size_t k = 0; k <= M; ++k) split[k] = polar(1.0, -2.0 * M_PI * k / N);
+    work.resize(M);
+}
+
+/**
+* Real forward transform, even and odd samples packed as one complex signal
+*
+* @param in
+* @param out
+*/
+void MorseFft::Real(const double* in, complex<double>* out)
+{
+    for (size_t i = 0; i < M; ++i) work[i] = complex<double>(in[2 * i], in[2 * i + 1]);
+    Complex(work.data(), false);
+
+    for (size_t k = 0; k <= M; ++k)
+    {
+        complex<double> z = work[k % M];
+        complex<double> c = conj(work[(M - k) % M]);
+        complex<double> even = (z + c) * 0.5;
+        complex<double> odd = (z - c) * complex<double>(0.0, -0.5);
+        out[k] = even + split[k] * odd;
+    }
+}
+
+/**
+* In place iterative radix-2 transform
+*
+* @param data
+* @param inverse
+*/
+void MorseFft::Complex(complex<double>* data, bool inverse)
+{
+    for (size_t i = 0; i < M; ++i)
+    {
+        if (i < rev[i]) swap(data[i], data[rev[i]]);
+    }
+    for (size_t len = 2; len <= M; len <<= 1)
+    {
+        size_t half = len / 2;
+        size_t step = M / len;
+        for (size_t i = 0; i < M; i += len)
+        {
+            for (size_t j = 0; j < half; ++j)
+            {
+                complex<double> w = inverse ? conj(twiddle[j * step]) : twiddle[j * step];
+                complex<double> t = data[i + j + half] * w;
+                data[i + j + half] = data[i + j] - t;
+                data[i + j] += t;
+            }
+        }
+    }
+}
+
+/**
+* Get real transform size
+*
+* @return size_t
+*/
+size_t MorseFft::GetSize() const
+{
+    return N;
+}
+
+/**
+* Hann window
+*
+* @param w
+* @param n
+*/
+void MorseFft::Hann(double* w, size_t n)
+{
+    for (size_t i = 0; i < n; ++i) w[i] = 0.5 - 0.5 * cos(2.0 * M_PI * i / n);
+}
+
+/**
+* Smallest power of two >= n
+*
+* @param n
+* @return size_t
+*/
+size_t MorseFft::Pow2(size_t n)
+{
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
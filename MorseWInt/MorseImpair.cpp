@@ -0,0 +1,411 @@
+#define _USE_MATH_DEFINES // Required for MSVC/Windows
+
+#include "morseimpair.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <sstream>
+
+/**
+* C++ MorseImpair Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+// offsets of the random streams from the seed
+static const uint64_t FADE_STREAM = 0x632BE59BD9B4E019ull;
+static const uint64_t NOISE_STREAM = 0x8CB92BA72F3D8DD7ull;
+
+/**
+* Is any impairment set
+*
+* @return bool
+*/
+bool Impairment::IsActive() const
+{
+    return noise || fading != FADING_NONE || qsbDepth > 0.0 || drift != 0.0 || jitter > 0.0;
+}
+
+/**
+* Get the settings as text
+*
+* @return string
+*/
+string Impairment::GetName() const
+{
+    ostringstream name;
+    if (noise) name << "snr" << snr << "_";
+    if (fading == FADING_RAYLEIGH) name << "rayleigh" << doppler << "_";
+    if (fading == FADING_RICIAN) name << "rician" << kfactor << "x" << doppler << "_";
+    if (qsbDepth > 0.0) name << "qsb" << qsbDepth << "x" << qsbPeriod << "_";
+    if (drift != 0.0) name << "drift" << drift << "_";
+    if (jitter > 0.0) name << "jitter" << jitter << "_";
+    name << "seed" << seed;
+    return name.str();
+}
+
+/**
+* Constructor
+*
+* @param settings
+* @param timing
+* @param tone
+* @param wpm
+* @param samples_per_second
+* @param amplitude
+*/
+MorseImpair::MorseImpair(const Impairment& settings, const MorseTiming& timing, double tone, double wpm, double samples_per_second, double amplitude)
+    : Settings(settings), Sps(samples_per_second), Tone(tone),
+    fadeRandom(settings.seed + FADE_STREAM), noiseKey(settings.seed + NOISE_STREAM)
+{
+    Amp = amplitude * 32767.0;
+    Sigma = Settings.noise ? Amp / sqrt(2.0) * pow(10.0, -Settings.snr / 20.0) : 0.0;
+    // at least 32 gain points per 1 / doppler, linear between them loses
+    // (1 - pole) / 3 of the power on average, put back by fadeNorm
+    gainFrames = GAIN_FRAMES;
+    if (Settings.fading != FADING_NONE && Settings.doppler > 0.0)
+    {
+        gainFrames = max<size_t>(PHASOR_LANES, min<size_t>(GAIN_FRAMES, static_cast<size_t>(Sps / (32.0 * Settings.doppler))));
+    }
+    fadePole = exp(-2.0 * M_PI * Settings.doppler * gainFrames / Sps);
+    fadeNorm = sqrt(3.0 / (2.0 + fadePole));
+
+    // jittered run lengths, at least half their nominal length
+    MorseRandom random(Settings.seed);
+    double unit = static_cast<double>(MorseTiming::SamplesPerUnit(wpm, Sps));
+    for (const KeyRun& r : timing.GetRuns())
+    {
+        double nominal = r.units * unit;
+        double length = nominal;
+        if (Settings.jitter > 0.0 && nominal > 0.0) length = max(0.5 * nominal, nominal + Settings.jitter * unit * random.Normal());
+        lengths.push_back(static_cast<uint64_t>(length + 0.5));
+        frames += lengths.back();
+    }
+
+    block.resize(BLOCK_FRAMES);
+    if (Sigma > 0.0)
+    {
+        // rounded to 16 bit, the clean samples are whole numbers already
+        MorseRandom random(noiseKey);
+        vector<float> normals(NOISE_TABLE);
+        random.Normal(normals.data(), normals.size());
+        noise.resize(NOISE_TABLE);
+        for (size_t i = 0; i < NOISE_TABLE; ++i)
+        {
+            double w = floor(Sigma * normals[i] + 0.5);
+            noise[i] = static_cast<int16_t>(max(-32767.0, min(32767.0, w)));
+        }
+    }
+    Rewind();
+}
+
+/**
+* Start again at the first frame, the fading starts in its steady state
+*/
+void MorseImpair::Rewind()
+{
+    fadeRandom.Seed(Settings.seed + FADE_STREAM);
+    fadeI = fadeQ = 0.0;
+    if (Settings.fading != FADING_NONE)
+    {
+        fadeI = sqrt(0.5) * fadeRandom.Normal();
+        fadeQ = sqrt(0.5) * fadeRandom.Normal();
+    }
+    gainStep = 0;
+    Gain(0, gainI[0], gainQ[0]);
+    Fade();
+    Gain(1, gainI[1], gainQ[1]);
+}
+
+/**
+* Move the gain points on to step, gainI / gainQ [0] is at step and
+* [1] at the next one
+*
+* @param step
+*/
+void MorseImpair::MoveGain(uint64_t step)
+{
+    while (gainStep < step)
+    {
+        gainI[0] = gainI[1];
+        gainQ[0] = gainQ[1];
+        ++gainStep;
+        Fade();
+        Gain(gainStep + 1, gainI[1], gainQ[1]);
+    }
+}
+
+/**
+* Move the scattered paths one gain point on: complex gaussian through a
+* one pole lowpass of the doppler bandwidth, mean power stays 1
+*/
+void MorseImpair::Fade()
+{
+    if (Settings.fading == FADING_NONE) return;
+    double b = sqrt(0.5 * (1.0 - fadePole * fadePole));
+    fadeI = fadePole * fadeI + b * fadeRandom.Normal();
+    fadeQ = fadePole * fadeQ + b * fadeRandom.Normal();
+}
+
+/**
+* Complex gain at a gain point from the fading state and the QSB cycle
+*
+* @param step
+* @param i
+* @param q
+*/
+void MorseImpair::Gain(uint64_t step, double& i, double& q)
+{
+    double a = Amp;
+    if (Settings.qsbDepth > 0.0 && Settings.qsbPeriod > 0.0)
+    {
+        double t = static_cast<double>(step * gainFrames) / Sps;
+        a *= pow(10.0, -Settings.qsbDepth / 20.0 * (0.5 - 0.5 * cos(2.0 * M_PI * t / Settings.qsbPeriod)));
+    }
+    i = a;
+    q = 0.0;
+    if (Settings.fading == FADING_RAYLEIGH)
+    {
+        i = a * fadeNorm * fadeI;
+        q = a * fadeNorm * fadeQ;
+    }
+    else if (Settings.fading == FADING_RICIAN)
+    {
+        double k = max(0.0, Settings.kfactor);
+        double direct = sqrt(k / (k + 1.0)), scattered = fadeNorm * sqrt(1.0 / (k + 1.0));
+        i = a * (direct + scattered * fadeI);
+        q = a * scattered * fadeQ;
+    }
+}
+
+/**
+* Write n key down samples from frame position on: Re(g e^(i phase))
+* with the gain g linear between gain points. Every gain step starts the
+* phasor lanes at the exact phase of the drifting tone and the step at
+* its middle; a call that starts inside a step turns the lanes on from
+* there, so a sample only depends on its frame, not on the block sizes
+*
+* @param out
+* @param position
+* @param n
+*/
+void MorseImpair::Key(float* out, uint64_t position, size_t n)
+{
+    const int L = PHASOR_LANES;
+    const double rate = Settings.drift / 60.0; // Hz per second
+    size_t k = 0;
+    while (k < n)
+    {
+        uint64_t t = position + k;
+        uint64_t step = t / gainFrames;
+        MoveGain(step);
+        uint64_t start = step * gainFrames;
+        size_t offset = static_cast<size_t>(t - start);
+        size_t end = offset + min(n - k, gainFrames - offset);
+        float* o = out + k - offset; // indexed from the step start
+
+        // phase in cycles at the step start, frequency at its middle
+        double sec = static_cast<double>(start) / Sps;
+        double cycles = Tone * sec + 0.5 * rate * sec * sec;
+        double phase = 2.0 * M_PI * (cycles - floor(cycles));
+        double omega = 2.0 * M_PI * (Tone + rate * (sec + 0.5 * gainFrames / Sps)) / Sps;
+
+        float zr[L], zi[L], ar[L], aq[L];
+        double di = (gainI[1] - gainI[0]) / gainFrames;
+        double dq = (gainQ[1] - gainQ[0]) / gainFrames;
+        complex<double> z = polar(1.0, phase), w = polar(1.0, omega);
+        for (int j = 0; j < L; ++j)
+        {
+            zr[j] = static_cast<float>(z.real());
+            zi[j] = static_cast<float>(z.imag());
+            ar[j] = static_cast<float>(gainI[0] + di * j);
+            aq[j] = static_cast<float>(gainQ[0] + dq * j);
+            z *= w;
+        }
+        complex<double> wl = polar(1.0, omega * L);
+        const float cr = static_cast<float>(wl.real()), ci = static_cast<float>(wl.imag());
+        const float si = static_cast<float>(di * L), sq = static_cast<float>(dq * L);
+
+        // one vector of L samples at i, the lanes move on to i + L
+        float part[L];
+        auto lanes = [&](float* dst, size_t i)
+        {
+            const float v = static_cast<float>(i / L);
+            for (int j = 0; j < L; ++j)
+            {
+                dst[j] = (ar[j] + si * v) * zr[j] - (aq[j] + sq * v) * zi[j];
+                float r = zr[j] * cr - zi[j] * ci;
+                zi[j] = zr[j] * ci + zi[j] * cr;
+                zr[j] = r;
+            }
+        };
+        size_t i = 0;
+        for (; i + L <= offset; i += L)
+        {
+            for (int j = 0; j < L; ++j)
+            {
+                float r = zr[j] * cr - zi[j] * ci;
+                zi[j] = zr[j] * ci + zi[j] * cr;
+                zr[j] = r;
+            }
+        }
+        if (i < offset)
+        {
+            lanes(part, i);
+            for (size_t x = offset; x < min(i + L, end); ++x) o[x] = part[x - i];
+            i += L;
+        }
+        for (; i + L <= end; i += L) lanes(o + i, i);
+        if (i < end)
+        {
+            lanes(part, i);
+            for (size_t x = i; x < end; ++x) o[x] = part[x - i];
+        }
+        k += end - offset;
+    }
+}
+
+/**
+* Noise of a run of NOISE_RUN frames: the table from an offset that is a
+* splitmix64 hash of the run, so it does not depend on the block sizes
+*
+* @param run
+* @return const int16_t*
+*/
+const int16_t* MorseImpair::NoiseRun(uint64_t run) const
+{
+    uint64_t z = noiseKey + run * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return noise.data() + z % (NOISE_TABLE - NOISE_RUN + 1);
+}
+
+/**
+* Round half away from zero and saturate to 16 bit without branches, the
+* sign of the noise is random and would defeat the branch predictor
+*
+* @param v
+* @return float
+*/
+static inline float Saturate(float v)
+{
+    v += copysign(0.5f, v);
+    v = (v < -32768.0f) ? -32768.0f : v;
+    return (v > 32767.0f) ? 32767.0f : v;
+}
+
+/**
+* Add noise to n samples of the block from frame position on and write
+* them as 16 bit, saturating at full scale
+*
+* @param out
+* @param position
+* @param n
+* @param channels
+*/
+void MorseImpair::Finish(int16_t* out, uint64_t position, size_t n, int channels)
+{
+    float* x = block.data();
+    for (size_t i = 0; i < n;)
+    {
+        uint64_t t = position + i;
+        size_t at = static_cast<size_t>(t % NOISE_RUN);
+        size_t m = min(n - i, NOISE_RUN - at);
+        if (Sigma > 0.0)
+        {
+            const int16_t* w = NoiseRun(t / NOISE_RUN) + at;
+            for (size_t k = 0; k < m; ++k) x[i + k] = Saturate(x[i + k] + w[k]);
+        }
+        else
+        {
+            for (size_t k = 0; k < m; ++k) x[i + k] = Saturate(x[i + k]);
+        }
+        i += m;
+    }
+    if (channels == 2)
+    {
+        for (size_t i = 0; i < n; ++i) out[2 * i] = out[2 * i + 1] = static_cast<int16_t>(x[i]);
+    }
+    else
+    {
+        for (size_t i = 0; i < n; ++i) out[i] = static_cast<int16_t>(x[i]);
+    }
+}
+
+/**
+* Add noise to n clean 16 bit frames from frame position on, the same
+* noise as Finish adds at those frames
+*
+* @param out
+* @param position
+* @param n
+* @param channels
+*/
+void MorseImpair::AddNoise(int16_t* out, uint64_t position, size_t n, int channels)
+{
+    if (Sigma <= 0.0) return;
+    for (size_t i = 0; i < n;)
+    {
+        uint64_t t = position + i;
+        size_t at = static_cast<size_t>(t % NOISE_RUN);
+        size_t m = min(n - i, NOISE_RUN - at);
+        const int16_t* w = NoiseRun(t / NOISE_RUN) + at;
+        int16_t* o = out + i * channels;
+        // saturating 16 bit adds, stereo channels get the same noise
+        auto add = [](int16_t x, int16_t w)
+        {
+            int32_t v = x + w;
+            v = (v < -32768) ? -32768 : v;
+            return static_cast<int16_t>((v > 32767) ? 32767 : v);
+        };
+        if (channels == 2)
+        {
+            for (size_t k = 0; k < m; ++k)
+            {
+                o[2 * k] = add(o[2 * k], w[k]);
+                o[2 * k + 1] = add(o[2 * k + 1], w[k]);
+            }
+        }
+        else
+        {
+            for (size_t k = 0; k < m; ++k) o[k] = add(o[k], w[k]);
+        }
+        i += m;
+    }
+}
+
+/**
+* Is the key down tone the clean one: with noise and jitter only the
+* renderer keys its tone table and adds the noise to that
+*
+* @return bool
+*/
+bool MorseImpair::CleanTone() const
+{
+    return Settings.fading == FADING_NONE && Settings.qsbDepth <= 0.0 && Settings.drift == 0.0;
+}
+
+/**
+* Get the length of a run in frames
+*
+* @param run
+* @return uint64_t
+*/
+uint64_t MorseImpair::GetLength(size_t run) const
+{
+    return lengths[run];
+}
+
+uint64_t MorseImpair::GetFrameCount() const
+{
+    return frames;
+}
+
+float* MorseImpair::GetBlock()
+{
+    return block.data();
+}
@@ -0,0 +1,267 @@
+#include "morsekeying.h"
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+/**
+* C++ MorseKeying Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param timing
+* @param wpm
+* @param samples_per_second
+* @param unit
+*/
+MorseKeying::MorseKeying(const MorseTiming& timing, double wpm, double samples_per_second, int unit) : Timing(timing)
+{
+    Sps = static_cast<uint32_t>(samples_per_second);
+    UnitSamples = MorseTiming::SamplesPerUnit(wpm, samples_per_second);
+    Unit = (unit == KEYING_MICROSECONDS) ? KEYING_MICROSECONDS : KEYING_SAMPLES;
+}
+
+/**
+* Write the schedule
+*
+* @param out
+* @param format
+*/
+void MorseKeying::Write(FILE* out, int format)
+{
+    Out = out;
+    buffer.resize(BUFFER_SIZE);
+    used = 0;
+    if (format == KEYING_BINARY) WriteBinary();
+    else WriteText(format == KEYING_JSON);
+    Flush();
+    Out = nullptr;
+}
+
+/**
+* Write the schedule to a file
+*
+* @param path
+* @param format
+*/
+void MorseKeying::Save(const string& path, int format)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        cerr << "Failed to open file: " << path << '\n';
+        throw runtime_error("Error opening file or directory");
+    }
+    try
+    {
+        Write(file, format);
+    }
+    catch (...)
+    {
+        fclose(file);
+        throw;
+    }
+    if (fclose(file) != 0) throw runtime_error("Error writing keying file");
+}
+
+/**
+* Get number of key events (runs)
+*
+* @return size_t
+*/
+size_t MorseKeying::GetEventCount() const
+{
+    return Timing.GetRuns().size();
+}
+
+/**
+* Get file extension for a format
+*
+* @param format
+* @return const char*
+*/
+const char* MorseKeying::GetExtension(int format)
+{
+    switch (format)
+    {
+    case KEYING_CSV: return ".csv";
+    case KEYING_JSON: return ".json";
+    default: return ".mkey";
+    }
+}
+
+/**
+* Encode an unsigned LEB128 varint
+*
+* @param value
+* @param p
+* @return size_t
+*/
+size_t MorseKeying::PutVarint(uint64_t value, uint8_t* p)
+{
+    size_t n = 0;
+    while (value >= 0x80)
+    {
+        p[n++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    p[n++] = static_cast<uint8_t>(value);
+    return n;
+}
+
+/**
+* Decode an unsigned LEB128 varint
+*
+* @param p
+* @param end
+* @return uint64_t
+*/
+uint64_t MorseKeying::GetVarint(const uint8_t*& p, const uint8_t* end)
+{
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (p >= end) throw runtime_error("Truncated varint");
+        uint8_t b = *p++;
+        value |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if (!(b & 0x80)) return value;
+    }
+    throw runtime_error("Varint too long");
+}
+
+/**
+* Convert a sample position to the output unit
+*
+* @param samples
+* @return uint64_t
+*/
+uint64_t MorseKeying::ToUnit(uint64_t samples) const
+{
+    if (Unit == KEYING_SAMPLES || Sps == 0) return samples;
+    return (samples * 1000000 + Sps / 2) / Sps;
+}
+
+/**
+* Binary form, durations are differences of rounded positions
+*/
+void MorseKeying::WriteBinary()
+{
+    const vector<KeyRun>& runs = Timing.GetRuns();
+    uint8_t header[4 + 3 + 20];
+    size_t n = 0;
+    memcpy(header, "MKEY", 4);
+    n += 4;
+    header[n++] = VERSION;
+    header[n++] = static_cast<uint8_t>(Unit);
+    header[n++] = (runs.empty() || runs[0].key) ? 1 : 0;
+    n += PutVarint((Unit == KEYING_SAMPLES) ? Sps : 1000000, header + n);
+    n += PutVarint(runs.size(), header + n);
+    Put(reinterpret_cast<const char*>(header), n);
+
+    uint64_t position = 0;
+    uint64_t start = 0;
+    for (const KeyRun& r : runs)
+    {
+        if (used + 10 > buffer.size()) Flush();
+        position += static_cast<uint64_t>(r.units) * UnitSamples;
+        uint64_t end = ToUnit(position);
+        used += PutVarint(end - start, reinterpret_cast<uint8_t*>(buffer.data() + used));
+        start = end;
+    }
+}
+
+/**
+* CSV or JSON form, one event per run with absolute start
+*
+* @param json
+*/
+void MorseKeying::WriteText(bool json)
+{
+    const char* unit = (Unit == KEYING_SAMPLES) ? "samples" : "us";
+    if (json)
+    {
+        string head = "{\"unit\":\"";
+        head += unit;
+        head += "\",\"rate\":" + to_string((Unit == KEYING_SAMPLES) ? Sps : 1000000);
+        head += ",\"fields\":[\"key\",\"start\",\"duration\"],\"events\":[";
+        Put(head.data(), head.size());
+    }
+    else
+    {
+        string head = string("key,start_") + unit + ",duration_" + unit + "\n";
+        Put(head.data(), head.size());
+    }
+
+    uint64_t position = 0;
+    uint64_t start = 0;
+    bool first = true;
+    for (const KeyRun& r : Timing.GetRuns())
+    {
+        if (used + 64 > buffer.size()) Flush();
+        position += static_cast<uint64_t>(r.units) * UnitSamples;
+        uint64_t end = ToUnit(position);
+        if (json)
+        {
+            if (!first) buffer[used++] = ',';
+            buffer[used++] = '[';
+        }
+        buffer[used++] = r.key ? '1' : '0';
+        buffer[used++] = ',';
+        PutNumber(start);
+        buffer[used++] = ',';
+        PutNumber(end - start);
+        buffer[used++] = json ? ']' : '\n';
+        start = end;
+        first = false;
+    }
+    if (json) Put("]}\n", 3);
+}
+
+/**
+* Append bytes to the buffer
+*
+* @param s
+* @param n
+*/
+void MorseKeying::Put(const char* s, size_t n)
+{
+    if (used + n > buffer.size()) Flush();
+    if (n > buffer.size())
+    {
+        if (fwrite(s, 1, n, Out) != n) throw runtime_error("Error writing keying output");
+        return;
+    }
+    memcpy(buffer.data() + used, s, n);
+    used += n;
+}
+
+/**
+* Append a decimal number, room is checked by the caller
+*
+* @param value
+*/
+void MorseKeying::PutNumber(uint64_t value)
+{
+    char* p = buffer.data() + used;
+    to_chars_result r = to_chars(p, p + 20, value);
+    used += r.ptr - p;
+}
+
+/**
+* Write the pending buffer
+*/
+void MorseKeying::Flush()
+{
+    if (used > 0 && fwrite(buffer.data(), 1, used, Out) != used)
+    {
+        throw runtime_error("Error writing keying output");
+    }
+    used = 0;
+}
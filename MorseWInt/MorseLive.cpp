@@ -0,0 +1,113 @@
+#include "morselive.h"
+#include <chrono>
+
+/**
+* C++ MorseLive Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param tone
+* @param samples_per_second
+* @param wpm
+* @param uppercase
+* @param matched_filter
+*/
+MorseLive::MorseLive(double tone, double samples_per_second, double wpm, bool uppercase, bool matched_filter)
+    : decoder(tone, samples_per_second, wpm, uppercase, matched_filter), input(RING_FRAMES), output(CHAR_SLOTS)
+{
+    decoder.KeepRecords(true);
+    decoder.KeepTextOutput(false);
+    decoder.Reserve(BLOCK_FRAMES);
+    block.resize(BLOCK_FRAMES);
+    worker = thread(&MorseLive::Work, this);
+}
+
+MorseLive::~MorseLive()
+{
+    End();
+    if (worker.joinable()) worker.join();
+}
+
+/**
+* Add mono samples
+*
+* @param mono
+* @param n
+* @return size_t
+*/
+size_t MorseLive::Push(const int16_t* mono, size_t n)
+{
+    return input.Write(mono, n);
+}
+
+/**
+* End of input
+*/
+void MorseLive::End()
+{
+    ending.store(true, memory_order_release);
+}
+
+/**
+* Get the next character
+*
+* @param record
+* @return bool
+*/
+bool MorseLive::Next(CharRecord& record)
+{
+    return output.Read(&record, 1) == 1;
+}
+
+bool MorseLive::IsDone() const
+{
+    return done.load(memory_order_acquire);
+}
+
+uint64_t MorseLive::GetDropped() const
+{
+    return dropped.load(memory_order_relaxed);
+}
+
+/**
+* Decode thread, a short sleep when there is nothing to do
+*/
+void MorseLive::Work()
+{
+    for (;;)
+    {
+        // samples pushed before End are in the ring once ending is seen
+        bool end = ending.load(memory_order_acquire);
+        size_t n = input.Read(block.data(), block.size());
+        if (n > 0)
+        {
+            decoder.Process(block.data(), n);
+            Emit();
+            continue;
+        }
+        if (end) break;
+        this_thread::sleep_for(chrono::microseconds(IDLE_MICROSECONDS));
+    }
+    decoder.Finish();
+    Emit();
+    done.store(true, memory_order_release);
+}
+
+/**
+* Move the characters of the decoder to the output ring
+*/
+void MorseLive::Emit()
+{
+    CharRecord r;
+    while (decoder.NextRecord(r))
+    {
+        if (output.Write(&r, 1) == 0) dropped.fetch_add(1, memory_order_relaxed);
+    }
+}
@@ -0,0 +1,108 @@
+#define _USE_MATH_DEFINES // Required for MSVC/Windows
+#include "morsematchedfilter.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+* C++ MorseMatchedFilter Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param tone
+* @param samples_per_second
+* @param length
+* @param step
+*/
+MorseMatchedFilter::MorseMatchedFilter(double tone, double samples_per_second, size_t length, size_t step)
+    : M(max<size_t>(length, 1)),
+    L(max<size_t>(MorseFft::Pow2(4 * max<size_t>(length, 1)), 64)),
+    Step(max<size_t>(step, 1)), forward(L), inverse(2 * L)
+{
+    // time reversed conjugate of the tone: y(n) = sum x(n - k) exp(i w k) / M
+    kernel.assign(L, complex<double>(0.0, 0.0));
+    double w = 2.0 * M_PI * tone / samples_per_second;
+    for (size_t k = 0; k < M; ++k) kernel[k] = polar(1.0 / M, w * k);
+    inverse.Complex(kernel.data(), false);
+
+    spectrum.resize(L);
+    block.assign(L, 0.0);
+    filled = M - 1; // silence before the first sample
+}
+
+/**
+* Feed mono samples
+*
+* @param mono
+* @param n
+* @param levels
+*/
+void MorseMatchedFilter::Process(const int16_t* mono, size_t n, vector<double>& levels)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        block[filled++] = mono[i];
+        if (filled == L) Filter(L, levels);
+    }
+}
+
+/**
+* Filter the samples still in the block and the tail of the last dit
+*
+* @param levels
+*/
+void MorseMatchedFilter::Flush(vector<double>& levels)
+{
+    for (size_t i = 0; i + 1 < M; ++i)
+    {
+        block[filled++] = 0.0;
+        if (filled == L) Filter(L, levels);
+    }
+    if (filled > M - 1)
+    {
+        size_t valid = filled;
+        fill(block.begin() + filled, block.end(), 0.0);
+        Filter(valid, levels);
+    }
+}
+
+size_t MorseMatchedFilter::GetLength() const
+{
+    return M;
+}
+
+size_t MorseMatchedFilter::GetSize() const
+{
+    return L;
+}
+
+/**
+* One overlap-save block, outputs M - 1 to valid - 1 are linear convolution
+*
+* @param valid
+* @param levels
+*/
+void MorseMatchedFilter::Filter(size_t valid, vector<double>& levels)
+{
+    forward.Real(block.data(), spectrum.data());
+    for (size_t k = 1; k < L / 2; ++k) spectrum[L - k] = conj(spectrum[k]);
+    for (size_t k = 0; k < L; ++k) spectrum[k] *= kernel[k];
+    inverse.Complex(spectrum.data(), true);
+
+    const double scale = 1.0 / L;
+    for (size_t i = M - 1; i < valid; ++i)
+    {
+        if (phase == 0) levels.push_back(abs(spectrum[i]) * scale);
+        if (++phase == Step) phase = 0;
+    }
+
+    // keep the last M - 1 samples for the next block
+    copy(block.begin() + (L - (M - 1)), block.end(), block.begin());
+    filled = M - 1;
+}
@@ -0,0 +1,337 @@
+#define _USE_MATH_DEFINES // Required for MSVC/Windows
+
+#include "morsemixer.h"
+#include "flacencoder.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+/**
+* C++ MorseMixer Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param samples_per_second
+* @param uppercase
+*/
+MorseMixer::MorseMixer(double samples_per_second, bool uppercase)
+    : morse(uppercase), Sps(samples_per_second)
+{
+    mix.resize(BLOCK_FRAMES);
+}
+
+/**
+* Add a message
+*
+* @param message
+*/
+void MorseMixer::Add(const Message& message)
+{
+    if (message.wpm <= 0.0 || message.tone <= 0.0) throw runtime_error("Mix message needs a tone and wpm above 0");
+    string code = morse.morse_encode(message.text);
+    uint64_t start = static_cast<uint64_t>(max(0.0, message.start) * Sps + 0.5);
+    Voice v = {
+        MorseTiming(code.c_str()), GetTable(message.tone),
+        2.0 * M_PI * message.tone / Sps, message.phase * M_PI / 180.0,
+        static_cast<float>(message.amplitude), MorseTiming::SamplesPerUnit(message.wpm, Sps),
+        start, start };
+    LoadRun(v);
+    frames = max(frames, v.start + v.timing.GetUnits() * v.unitSamples);
+    voices.push_back(v);
+}
+
+/**
+* Add the messages of a text file
+*
+* @param path
+* @return size_t
+*/
+size_t MorseMixer::Load(const string& path)
+{
+    ifstream in(path);
+    if (!in.is_open())
+    {
+        cerr << "Failed to open file: " << path << '\n';
+        throw runtime_error("Error opening file or directory");
+    }
+    size_t added = 0;
+    string line;
+    int number = 0;
+    while (getline(in, line))
+    {
+        ++number;
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == string::npos || line[first] == '#') continue;
+
+        istringstream fields(line);
+        Message m;
+        if (!(fields >> m.tone >> m.wpm >> m.amplitude >> m.start >> m.phase))
+        {
+            throw runtime_error("Bad mix line " + to_string(number) + ", use: tone wpm amplitude start phase text");
+        }
+        getline(fields >> ws, m.text);
+        while (!m.text.empty() && (m.text.back() == '\r' || m.text.back() == ' ')) m.text.pop_back();
+        Add(m);
+        ++added;
+    }
+    return added;
+}
+
+/**
+* Mix up to n frames as float
+*
+* @param out
+* @param n
+* @return size_t
+*/
+size_t MorseMixer::Mix(float* out, size_t n)
+{
+    n = static_cast<size_t>(min<uint64_t>(n, frames - position));
+    size_t done = 0;
+    while (done < n)
+    {
+        size_t block = min(BLOCK_FRAMES, n - done);
+        float* dst = out + done;
+        fill(dst, dst + block, 0.0f);
+        for (Voice& v : voices) Accumulate(v, dst, block);
+        position += block;
+        done += block;
+    }
+    return done;
+}
+
+/**
+* Add one voice's key down samples of a block. With the phase p at the
+* block start, sin(p + wk) = sin p cos wk + cos p sin wk, so every sample
+* is two multiply adds against the tone tables
+*
+* @param v
+* @param out
+* @param n
+*/
+void MorseMixer::Accumulate(Voice& v, float* out, size_t n)
+{
+    size_t k = 0;
+    if (v.delay > 0)
+    {
+        size_t skip = static_cast<size_t>(min<uint64_t>(v.delay, n));
+        v.delay -= skip;
+        k = skip;
+    }
+    const size_t runs = v.timing.GetRuns().size();
+    if (k == n || v.run >= runs) return;
+
+    // phase at this block in double, the tables hold the steps within it
+    double p = fmod(v.phase + v.omega * static_cast<double>(position), 2.0 * M_PI);
+    const float as = v.amp * static_cast<float>(sin(p));
+    const float ac = v.amp * static_cast<float>(cos(p));
+    const float* c = v.table;
+    const float* s = v.table + BLOCK_FRAMES;
+    while (k < n && v.run < runs)
+    {
+        size_t m = static_cast<size_t>(min<uint64_t>(v.left, n - k));
+        if (v.timing.GetRuns()[v.run].key)
+        {
+            for (size_t i = k; i < k + m; ++i) out[i] += as * c[i] + ac * s[i];
+        }
+        k += m;
+        v.left -= m;
+        if (v.left == 0)
+        {
+            ++v.run;
+            LoadRun(v);
+        }
+    }
+}
+
+/**
+* Mix up to n frames as 16 bit PCM
+*
+* @param out
+* @param n
+* @param dither
+* @return size_t
+*/
+size_t MorseMixer::Render(int16_t* out, size_t n, bool dither)
+{
+    size_t done = 0;
+    while (done < n && !Done())
+    {
+        size_t block = Mix(mix.data(), min(BLOCK_FRAMES, n - done));
+        for (size_t i = 0; i < block; ++i)
+        {
+            float x = mix[i] * 32767.0f;
+            if (dither)
+            {
+                // triangular, the difference of two uniform values of 1 LSB
+                noise ^= noise << 13;
+                noise ^= noise >> 17;
+                noise ^= noise << 5;
+                x += static_cast<float>(static_cast<int>(noise & 0xFFFF) - static_cast<int>(noise >> 16)) * (1.0f / 65536.0f);
+            }
+            if (x > 32767.0f) { x = 32767.0f; ++clipped; }
+            else if (x < -32768.0f) { x = -32768.0f; ++clipped; }
+            out[done + i] = static_cast<int16_t>(lrintf(x));
+        }
+        done += block;
+    }
+    return done;
+}
+
+/**
+* Mix everything into a 16 bit mono wav or FLAC file
+*
+* @param path
+* @param flac
+* @param dither
+* @return uint64_t
+*/
+uint64_t MorseMixer::Save(const string& path, bool flac, bool dither)
+{
+    ofstream out(path, ios::binary);
+    if (!out.is_open())
+    {
+        cerr << "Failed to open file: " << path << '\n';
+        throw runtime_error("Error opening file or directory");
+    }
+
+    Rewind();
+    vector<int16_t> block(FlacEncoder::BLOCK_SIZE);
+    if (flac)
+    {
+        FlacEncoder encoder(out, 1, static_cast<uint32_t>(Sps), frames);
+        while (!Done())
+        {
+            size_t n = Render(block.data(), block.size(), dither);
+            encoder.Write(block.data(), n);
+        }
+        encoder.Finish();
+    }
+    else
+    {
+        uint32_t data_size = static_cast<uint32_t>(frames * 2);
+        uint32_t riff_size = 36 + data_size;
+        uint32_t fmt_size = 16;
+        uint16_t format = 1; // WAVE_FORMAT_PCM
+        uint16_t channels = 1;
+        uint32_t rate = static_cast<uint32_t>(Sps);
+        uint32_t bytes_per_sec = rate * 2;
+        uint16_t align = 2;
+        uint16_t bits = 16;
+
+        // RIFF header and fmt subchunk
+        out.write("RIFF", 4);
+        out.write(reinterpret_cast<const char*>(&riff_size), 4);
+        out.write("WAVEfmt ", 8);
+        out.write(reinterpret_cast<const char*>(&fmt_size), 4);
+        out.write(reinterpret_cast<const char*>(&format), 2);
+        out.write(reinterpret_cast<const char*>(&channels), 2);
+        out.write(reinterpret_cast<const char*>(&rate), 4);
+        out.write(reinterpret_cast<const char*>(&bytes_per_sec), 4);
+        out.write(reinterpret_cast<const char*>(&align), 2);
+        out.write(reinterpret_cast<const char*>(&bits), 2);
+
+        // data subchunk
+        out.write("data", 4);
+        out.write(reinterpret_cast<const char*>(&data_size), 4);
+        while (!Done())
+        {
+            size_t n = Render(block.data(), block.size(), dither);
+            out.write(reinterpret_cast<const char*>(block.data()), n * sizeof(int16_t));
+        }
+    }
+    if (!out) throw runtime_error("Error writing file: " + path);
+    uint64_t size = static_cast<uint64_t>(out.tellp());
+    out.close();
+    return size;
+}
+
+/**
+* Start again at the beginning
+*/
+void MorseMixer::Rewind()
+{
+    for (Voice& v : voices)
+    {
+        v.delay = v.start;
+        v.run = 0;
+        LoadRun(v);
+    }
+    position = 0;
+    clipped = 0;
+}
+
+/**
+* Load the sample count of the current run, skipping empty runs
+*
+* @param v
+*/
+void MorseMixer::LoadRun(Voice& v)
+{
+    const vector<KeyRun>& runs = v.timing.GetRuns();
+    v.left = 0;
+    while (v.run < runs.size())
+    {
+        v.left = static_cast<uint64_t>(runs[v.run].units) * v.unitSamples;
+        if (v.left > 0) break;
+        ++v.run;
+    }
+}
+
+/**
+* Get the shared cos / sin table for a tone, one block of phase steps
+*
+* @param tone
+* @return const float*
+*/
+const float* MorseMixer::GetTable(double tone)
+{
+    auto it = tables.find(tone);
+    if (it == tables.end())
+    {
+        vector<float> t(2 * BLOCK_FRAMES);
+        double w = 2.0 * M_PI * tone / Sps;
+        for (size_t k = 0; k < BLOCK_FRAMES; ++k)
+        {
+            t[k] = static_cast<float>(cos(w * k));
+            t[BLOCK_FRAMES + k] = static_cast<float>(sin(w * k));
+        }
+        it = tables.emplace(tone, move(t)).first;
+    }
+    return it->second.data();
+}
+
+bool MorseMixer::Done() const
+{
+    return position >= frames;
+}
+
+size_t MorseMixer::GetCount() const
+{
+    return voices.size();
+}
+
+uint64_t MorseMixer::GetFrameCount() const
+{
+    return frames;
+}
+
+uint64_t MorseMixer::GetClipped() const
+{
+    return clipped;
+}
+
+double MorseMixer::GetSps() const
+{
+    return Sps;
+}
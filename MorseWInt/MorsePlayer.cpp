@@ -0,0 +1,367 @@
+#include "morseplayer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+/**
+* C++ MorsePlayer Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param frames
+* @param channels
+* @param samples_per_second
+*/
+PcmBuffer::PcmBuffer(uint64_t frames, int channels, double samples_per_second)
+    : NumChannels(channels), Sps(samples_per_second), frames(frames)
+{
+    pcm.reset(new int16_t[static_cast<size_t>(frames) * channels]);
+}
+
+/**
+* Writer: where the next frame goes
+*
+* @return int16_t*
+*/
+int16_t* PcmBuffer::GetWrite()
+{
+    return pcm.get() + ready.load(memory_order_relaxed) * NumChannels;
+}
+
+/**
+* Writer: publish n frames, the release store orders them before the count
+*
+* @param n
+*/
+void PcmBuffer::Publish(size_t n)
+{
+    uint64_t at = ready.load(memory_order_relaxed);
+    ready.store(min<uint64_t>(at + n, frames), memory_order_release);
+}
+
+/**
+* Writer: copy in and publish n frames, what does not fit is dropped
+*
+* @param block
+* @param n
+*/
+void PcmBuffer::Append(const int16_t* block, size_t n)
+{
+    n = static_cast<size_t>(min<uint64_t>(n, frames - ready.load(memory_order_relaxed)));
+    memcpy(GetWrite(), block, n * NumChannels * sizeof(int16_t));
+    Publish(n);
+}
+
+/**
+* Writer: done
+*/
+void PcmBuffer::Close()
+{
+    closed.store(true, memory_order_release);
+}
+
+uint64_t PcmBuffer::GetReady() const
+{
+    return ready.load(memory_order_acquire);
+}
+
+bool PcmBuffer::IsClosed() const
+{
+    return closed.load(memory_order_acquire);
+}
+
+const int16_t* PcmBuffer::GetData() const
+{
+    return pcm.get();
+}
+
+uint64_t PcmBuffer::GetFrameCount() const
+{
+    return frames;
+}
+
+int PcmBuffer::GetChannels() const
+{
+    return NumChannels;
+}
+
+double PcmBuffer::GetSps() const
+{
+    return Sps;
+}
+
+/**
+* Constructor
+*
+* @param sink
+*/
+MorsePlayer::MorsePlayer(MorseSink& sink)
+    : sink(sink)
+{
+}
+
+MorsePlayer::~MorsePlayer()
+{
+    Stop();
+}
+
+/**
+* Start playing a message
+*
+* @param morsecode
+* @param tone
+* @param wpm
+* @param samples_per_second
+* @param channels
+* @param envelope
+*/
+void MorsePlayer::Play(const string& morsecode, double tone, double wpm, double samples_per_second, int channels, const Envelope* envelope)
+{
+    lock_guard<mutex> lock(control);
+    Halt();
+    source.reset();
+    NumChannels = (channels == 2) ? 2 : 1;
+    Sps = samples_per_second;
+
+    timing = make_unique<MorseTiming>(morsecode.c_str());
+    table = make_unique<ToneTable>(tone, Sps, 0.8);
+    render = make_unique<MorseRender>(*timing, *table, wpm, NumChannels);
+    ramp.reset();
+    if (envelope && envelope->IsActive())
+    {
+        ramp = make_unique<KeyRamp>(*envelope, Sps);
+        render->SetRamp(ramp.get());
+    }
+    ring = make_unique<MorseRing<int16_t>>(RING_FRAMES * NumChannels);
+    block.resize(BLOCK_FRAMES * NumChannels);
+    period.resize(PERIOD_FRAMES * NumChannels);
+    blockAt = blockSize = 0;
+    Start();
+}
+
+/**
+* Start playing a buffer while it is rendered
+*
+* @param buffer
+*/
+void MorsePlayer::Play(shared_ptr<const PcmBuffer> buffer)
+{
+    lock_guard<mutex> lock(control);
+    Halt();
+    source = move(buffer);
+    taken = 0;
+    NumChannels = source->GetChannels();
+    Sps = source->GetSps();
+    timing.reset();
+    table.reset();
+    render.reset();
+    ramp.reset();
+    ring.reset();
+    Start();
+}
+
+/**
+* Open the sink and start the threads
+*/
+void MorsePlayer::Start()
+{
+    stopping.store(false);
+    paused.store(false);
+    underruns.store(0);
+    sink.Open(NumChannels, Sps);
+
+    // the first block is in the ring before the output thread looks
+    bool done = source ? true : Fill();
+    rendered.store(done, memory_order_release);
+    finished.store(false, memory_order_release);
+    if (!done) renderer = thread(&MorsePlayer::RenderWork, this);
+    output = thread(&MorsePlayer::OutputWork, this);
+}
+
+/**
+* Render into the ring until it is full or the message is done
+*
+* @return bool - every frame is in the ring
+*/
+bool MorsePlayer::Fill()
+{
+    for (;;)
+    {
+        if (blockAt == blockSize)
+        {
+            if (render->Done()) return true;
+            blockSize = render->Render(block.data(), BLOCK_FRAMES) * NumChannels;
+            blockAt = 0;
+        }
+        // the ring and the block hold whole frames, so does every write
+        size_t n = ring->Write(block.data() + blockAt, blockSize - blockAt);
+        blockAt += n;
+        if (blockAt < blockSize) return false;
+    }
+}
+
+/**
+* Output thread: next frames for the sink, from the buffer or the ring
+*
+* @param frames - set to the first frame
+* @param end - no frames will follow once these are taken
+* @return size_t - frames at frames
+*/
+size_t MorsePlayer::Take(const int16_t*& frames, bool& end)
+{
+    if (source)
+    {
+        // closed before ready, a closed buffer has published its last frame
+        end = source->IsClosed();
+        size_t n = static_cast<size_t>(min<uint64_t>(source->GetReady() - taken, PERIOD_FRAMES));
+        frames = source->GetData() + taken * NumChannels;
+        taken += n;
+        return n;
+    }
+    // samples rendered before rendered is seen are in the ring
+    end = rendered.load(memory_order_acquire);
+    frames = period.data();
+    return ring->Read(period.data(), period.size()) / NumChannels;
+}
+
+/**
+* Render thread, sleeps while the ring is full
+*/
+void MorsePlayer::RenderWork()
+{
+    while (!stopping.load(memory_order_acquire))
+    {
+        if (Fill())
+        {
+            rendered.store(true, memory_order_release);
+            return;
+        }
+        this_thread::sleep_for(chrono::microseconds(IDLE_MICROSECONDS));
+    }
+}
+
+/**
+* Output thread: ring to sink, until the message is played out or Stop
+*/
+void MorsePlayer::OutputWork()
+{
+    const int16_t* frames = nullptr;
+    size_t have = 0; // frames at frames not yet taken by the sink
+    bool held = false;
+    for (;;)
+    {
+        if (stopping.load(memory_order_acquire))
+        {
+            sink.Flush();
+            break;
+        }
+        bool hold = paused.load(memory_order_acquire);
+        if (hold != held)
+        {
+            sink.Pause(hold);
+            held = hold;
+        }
+        if (hold)
+        {
+            this_thread::sleep_for(chrono::microseconds(IDLE_MICROSECONDS));
+            continue;
+        }
+        if (have == 0)
+        {
+            bool end;
+            have = Take(frames, end);
+            if (have == 0)
+            {
+                if (end) break;
+                underruns.fetch_add(1, memory_order_relaxed);
+                this_thread::sleep_for(chrono::microseconds(IDLE_MICROSECONDS));
+                continue;
+            }
+        }
+        size_t n = sink.Write(frames, have);
+        frames += n * NumChannels;
+        have -= n;
+        if (n == 0) this_thread::sleep_for(chrono::microseconds(IDLE_MICROSECONDS));
+    }
+    sink.Close();
+    finished.store(true, memory_order_release);
+}
+
+/**
+* Hold playback
+*/
+void MorsePlayer::Pause()
+{
+    paused.store(true, memory_order_release);
+}
+
+/**
+* Go on after Pause
+*/
+void MorsePlayer::Resume()
+{
+    paused.store(false, memory_order_release);
+}
+
+/**
+* End playback now, drops what the sink has queued
+*/
+void MorsePlayer::Stop()
+{
+    lock_guard<mutex> lock(control);
+    Halt();
+}
+
+/**
+* Wait until the message has been played out
+*/
+void MorsePlayer::Wait()
+{
+    while (IsPlaying()) this_thread::sleep_for(chrono::milliseconds(1));
+    lock_guard<mutex> lock(control);
+    if (renderer.joinable()) renderer.join();
+    if (output.joinable()) output.join();
+}
+
+/**
+* End the threads, the caller holds control
+*/
+void MorsePlayer::Halt()
+{
+    stopping.store(true, memory_order_release);
+    if (renderer.joinable()) renderer.join();
+    if (output.joinable()) output.join();
+}
+
+bool MorsePlayer::IsPlaying() const
+{
+    return !finished.load(memory_order_acquire);
+}
+
+bool MorsePlayer::IsPaused() const
+{
+    return paused.load(memory_order_acquire);
+}
+
+uint64_t MorsePlayer::GetPlayed() const
+{
+    return sink.GetPlayed();
+}
+
+uint64_t MorsePlayer::GetFrameCount() const
+{
+    if (source) return source->GetFrameCount();
+    return render ? render->GetFrameCount() : 0;
+}
+
+uint64_t MorsePlayer::GetUnderruns() const
+{
+    return underruns.load(memory_order_relaxed);
+}
@@ -0,0 +1,237 @@
+#define _USE_MATH_DEFINES // Required for MSVC/Windows
+
+#include "morseramp.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <type_traits>
+
+/**
+* C++ KeyRamp Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Is the keying shaped
+*
+* @return bool
+*/
+bool Envelope::IsActive() const
+{
+    return shape != RAMP_NONE && rise > 0.0;
+}
+
+/**
+* Get the settings as text
+*
+* @return string
+*/
+string Envelope::GetName() const
+{
+    ostringstream name;
+    name << ((shape == RAMP_BLACKMAN) ? "blackman" : "cosine") << rise << "ms";
+    return name.str();
+}
+
+/**
+* Constructor, the gain is taken at the middle of every sample so the
+* rise and the fall are mirror images
+*
+* @param envelope
+* @param samples_per_second
+*/
+KeyRamp::KeyRamp(const Envelope& envelope, double samples_per_second)
+    : Settings(envelope), Sps(samples_per_second)
+{
+    if (!Settings.IsActive()) return;
+    size_t length = static_cast<size_t>(llround(Settings.rise * Sps / 1000.0));
+    rise.resize(length);
+    for (size_t k = 0; k < length; ++k)
+    {
+        double x = (k + 0.5) / length; // 0 to 1 over the rise
+        double g = (Settings.shape == RAMP_BLACKMAN)
+            ? 0.42 - 0.5 * cos(M_PI * x) + 0.08 * cos(2.0 * M_PI * x)
+            : 0.5 - 0.5 * cos(M_PI * x);
+        rise[k] = static_cast<float>(g);
+    }
+    fall.assign(rise.rbegin(), rise.rend());
+}
+
+/**
+* Multiply n frames by n gains, a plain loop over contiguous arrays that
+* the compiler vectorizes; 16 bit samples round half away from zero
+*
+* @param out
+* @param g
+* @param n
+* @param channels
+*/
+template <typename T>
+static void Scale(T* out, const float* g, size_t n, int channels)
+{
+    if (channels == 1)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            if constexpr (is_same<T, float>::value) out[i] *= g[i];
+            else
+            {
+                float v = out[i] * g[i];
+                out[i] = static_cast<T>(v + copysign(0.5f, v));
+            }
+        }
+        return;
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (int c = 0; c < channels; ++c)
+        {
+            T& x = out[i * channels + c];
+            if constexpr (is_same<T, float>::value) x *= g[i];
+            else
+            {
+                float v = x * g[i];
+                x = static_cast<T>(v + copysign(0.5f, v));
+            }
+        }
+    }
+}
+
+/**
+* Multiply the edge frames of a short mark without a kept table, the same
+* gains GetCoarse gives, a stack buffer at a time
+*
+* @param out
+* @param rise
+* @param at
+* @param length
+* @param edge
+* @param n
+* @param channels
+*/
+template <typename T>
+static void ScaleCoarse(T* out, const vector<float>& rise, uint64_t at, uint64_t length, uint64_t edge, size_t n, int channels)
+{
+    const uint64_t full = rise.size();
+    const uint64_t fall = length - edge;
+    float g[64];
+    size_t i = 0;
+    while (i < n)
+    {
+        if (at + i >= edge && at + i < fall)
+        {
+            i = static_cast<size_t>(min<uint64_t>(fall - at, n)); // steady part
+            continue;
+        }
+        size_t m = 0;
+        for (; m < 64 && i + m < n; ++m)
+        {
+            uint64_t k = at + i + m;
+            if (k < edge) g[m] = rise[k * full / edge];
+            else if (k >= fall) g[m] = rise[(edge - 1 - (k - fall)) * full / edge];
+            else break;
+        }
+        Scale(out + i * channels, g, m, channels);
+        i += m;
+    }
+}
+
+/**
+* Get the rise and fall of a short mark, the rise table read at a coarser
+* step, made on first use
+*
+* @param edge - rise length, less than the full rise
+* @return const float* - edge rise gains then edge fall gains, nullptr when too many are kept
+*/
+const float* KeyRamp::GetCoarse(uint64_t edge) const
+{
+    auto it = coarse.find(edge);
+    if (it != coarse.end()) return it->second.data();
+    if (coarse.size() >= MAX_COARSE) return nullptr;
+
+    const uint64_t full = rise.size();
+    vector<float> table(static_cast<size_t>(edge) * 2);
+    for (uint64_t k = 0; k < edge; ++k)
+    {
+        table[k] = rise[k * full / edge];
+        table[edge * 2 - 1 - k] = table[k];
+    }
+    return coarse.emplace(edge, move(table)).first->second.data();
+}
+
+/**
+* Multiply the frames of out that lie on the edges of the mark
+*
+* @param out
+* @param at
+* @param length
+* @param n
+* @param channels
+*/
+template <typename T>
+void KeyRamp::Edges(T* out, uint64_t at, uint64_t length, size_t n, int channels) const
+{
+    const uint64_t full = rise.size();
+    const uint64_t edge = GetEdge(length);
+    if (edge == 0 || n == 0) return;
+    const uint64_t end = at + n;
+
+    // short marks read the tables at a coarser step
+    const float* up = rise.data();
+    const float* down = fall.data();
+    if (edge < full)
+    {
+        const float* table = GetCoarse(edge);
+        if (!table)
+        {
+            ScaleCoarse(out, rise, at, length, edge, n, channels);
+            return;
+        }
+        up = table;
+        down = table + edge;
+    }
+    if (at < edge)
+    {
+        Scale(out, up + at, static_cast<size_t>(min(end, edge) - at), channels);
+    }
+    uint64_t from = max(at, length - edge);
+    if (from < end)
+    {
+        Scale(out + (from - at) * channels, down + (from - (length - edge)), static_cast<size_t>(end - from), channels);
+    }
+}
+
+void KeyRamp::Apply(int16_t* out, uint64_t at, uint64_t length, size_t n, int channels) const
+{
+    Edges(out, at, length, n, channels);
+}
+
+void KeyRamp::Apply(float* out, uint64_t at, uint64_t length, size_t n, int channels) const
+{
+    Edges(out, at, length, n, channels);
+}
+
+/**
+* Get the rise length in samples
+*
+* @return size_t
+*/
+size_t KeyRamp::GetLength() const
+{
+    return rise.size();
+}
+
+/**
+* Get the rise length for a mark, at most half the mark
+*
+* @param length
+* @return uint64_t
+*/
+uint64_t KeyRamp::GetEdge(uint64_t length) const
+{
+    return min<uint64_t>(rise.size(), length / 2);
+}
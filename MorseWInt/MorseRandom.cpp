@@ -0,0 +1,202 @@
+#include "morserandom.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/**
+* C++ MorseRandom Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+static inline uint64_t Rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+* Constructor, sets up the ziggurat tables of 128 layers
+*
+* @param seed
+*/
+MorseRandom::MorseRandom(uint64_t seed)
+{
+    const double m1 = 2147483648.0;
+    double dn = 3.442619855899, tn = dn;
+    const double vn = 9.91256303526217e-3;
+    double q = vn / exp(-0.5 * dn * dn);
+    kn[0] = static_cast<uint32_t>((dn / q) * m1);
+    kn[1] = 0;
+    wn[0] = static_cast<float>(q / m1);
+    wn[127] = static_cast<float>(dn / m1);
+    fn[0] = 1.0f;
+    fn[127] = static_cast<float>(exp(-0.5 * dn * dn));
+    for (int i = 126; i >= 1; --i)
+    {
+        dn = sqrt(-2.0 * log(vn / dn + exp(-0.5 * dn * dn)));
+        kn[i + 1] = static_cast<uint32_t>((dn / tn) * m1);
+        tn = dn;
+        fn[i] = static_cast<float>(exp(-0.5 * dn * dn));
+        wn[i] = static_cast<float>(dn / m1);
+    }
+    Seed(seed);
+}
+
+/**
+* Start again from a seed, every lane state comes from splitmix64
+*
+* @param seed
+*/
+void MorseRandom::Seed(uint64_t seed)
+{
+    uint64_t x = seed;
+    auto split = [&x]()
+    {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    };
+    for (int j = 0; j < LANES; ++j)
+    {
+        s0[j] = split();
+        s1[j] = split();
+        s2[j] = split();
+        s3[j] = split();
+    }
+    used = BATCH;
+}
+
+/**
+* Run every lane for BATCH / LANES steps, the lanes are independent so
+* each step is one vector operation over them
+*/
+void MorseRandom::Refill()
+{
+    for (size_t at = 0; at < BATCH; at += LANES)
+    {
+        for (int j = 0; j < LANES; ++j)
+        {
+            words[at + j] = Rotl(s0[j] + s3[j], 23) + s0[j];
+            uint64_t t = s1[j] << 17;
+            s2[j] ^= s0[j];
+            s3[j] ^= s1[j];
+            s1[j] ^= s2[j];
+            s0[j] ^= s3[j];
+            s2[j] ^= t;
+            s3[j] = Rotl(s3[j], 45);
+        }
+    }
+    used = 0;
+}
+
+/**
+* Get one 64 bit random word
+*
+* @return uint64_t
+*/
+uint64_t MorseRandom::Next()
+{
+    if (used == BATCH) Refill();
+    return words[used++];
+}
+
+/**
+* Get a uniform value from the top 53 bits, never 0 or 1
+*
+* @return double
+*/
+double MorseRandom::Uniform()
+{
+    return (static_cast<double>(Next() >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+/**
+* Normal value from a 32 bit word: the layer is the low 7 bits, inside
+* the rectangle of the layer the word times its width is the value
+*
+* @param word
+* @return float
+*/
+inline float MorseRandom::FromWord(uint32_t word)
+{
+    int32_t hz = static_cast<int32_t>(word);
+    uint32_t iz = word & 127;
+    uint32_t mag = (hz < 0) ? 0u - word : word;
+    if (mag < kn[iz]) return static_cast<float>(hz) * wn[iz];
+    return Tail(hz, iz);
+}
+
+/**
+* Fill out with n standard normal values, two per 64 bit word
+*
+* @param out
+* @param n
+*/
+void MorseRandom::Normal(float* out, size_t n)
+{
+    size_t i = 0;
+    while (i + 1 < n)
+    {
+        if (used == BATCH) Refill();
+        // taken out first, the slow path may refill words
+        size_t take = min((n - i) / 2, BATCH - used);
+        uint64_t w[BATCH];
+        memcpy(w, words + used, take * sizeof(uint64_t));
+        used += take;
+        for (size_t k = 0; k < take; ++k)
+        {
+            out[i + 2 * k] = FromWord(static_cast<uint32_t>(w[k]));
+            out[i + 2 * k + 1] = FromWord(static_cast<uint32_t>(w[k] >> 32));
+        }
+        i += 2 * take;
+    }
+    if (i < n) out[i] = Normal();
+}
+
+/**
+* Get one standard normal value
+*
+* @return float
+*/
+float MorseRandom::Normal()
+{
+    return FromWord(static_cast<uint32_t>(Next() >> 32));
+}
+
+/**
+* Ziggurat slow path, about 1 in 100 values: a wedge between two layers
+* is accepted against the density, layer 0 is the tail beyond r
+*
+* @param hz
+* @param iz
+* @return float
+*/
+float MorseRandom::Tail(int32_t hz, uint32_t iz)
+{
+    const double r = 3.442619855899;
+    for (;;)
+    {
+        double x = hz * static_cast<double>(wn[iz]);
+        if (iz == 0)
+        {
+            double y;
+            do
+            {
+                x = -log(Uniform()) / r;
+                y = -log(Uniform());
+            } while (y + y < x * x);
+            return static_cast<float>((hz > 0) ? r + x : -r - x);
+        }
+        if (fn[iz] + Uniform() * (fn[iz - 1] - fn[iz]) < exp(-0.5 * x * x)) return static_cast<float>(x);
+
+        uint32_t word = static_cast<uint32_t>(Next() >> 32);
+        hz = static_cast<int32_t>(word);
+        iz = word & 127;
+        uint32_t mag = (hz < 0) ? 0u - word : word;
+        if (mag < kn[iz]) return static_cast<float>(hz) * wn[iz];
+    }
+}
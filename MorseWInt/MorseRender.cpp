@@ -0,0 +1,557 @@
+#define _USE_MATH_DEFINES // Required for MSVC/Windows
+
+#include "morserender.h"
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <limits>
+#include <algorithm>
+
+/**
+* C++ ToneTable and MorseRender Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param tone
+* @param samples_per_second
+* @param amplitude
+*/
+ToneTable::ToneTable(double tone, double samples_per_second, double amplitude)
+{
+    Tone = tone;
+    Sps = samples_per_second;
+    Amp = amplitude * static_cast<double>(numeric_limits<int16_t>::max());
+    omega = (2.0 * M_PI * Tone) / Sps;
+
+    // tone and sps in millihertz, the waveform repeats after sps / gcd samples
+    long long num = llround(Tone * 1000.0);
+    long long den = llround(Sps * 1000.0);
+    if (num <= 0 || den <= 0) return;
+    long long period = den / gcd(num, den);
+    if (period > static_cast<long long>(MAX_PERIOD)) return;
+
+    table.resize(static_cast<size_t>(period));
+    for (size_t k = 0; k < table.size(); ++k)
+    {
+        table[k] = Quantize(sin(omega * static_cast<double>(k)));
+    }
+}
+
+/**
+* Scale and clip one oscillator sample
+*
+* @param sample
+* @return int16_t
+*/
+int16_t ToneTable::Quantize(double sample) const
+{
+    constexpr int16_t maxInt16 = numeric_limits<int16_t>::max();
+    double scaled = sample * Amp;
+    if (scaled > maxInt16) scaled = maxInt16;
+    else if (scaled < -maxInt16) scaled = -maxInt16;
+    return static_cast<int16_t>(scaled);
+}
+
+/**
+* Write n tone samples starting at oscillator sample index
+*
+* @param out
+* @param index
+* @param n
+* @param channels
+*/
+void ToneTable::Fill(int16_t* out, uint64_t index, size_t n, int channels) const
+{
+    const bool stereo = (channels == 2);
+    if (!table.empty())
+    {
+        // Fast path: copy from the period table
+        const size_t period = table.size();
+        size_t p = static_cast<size_t>(index % period);
+        while (n > 0)
+        {
+            size_t chunk = min(n, period - p);
+            const int16_t* src = table.data() + p;
+            if (stereo)
+            {
+                for (size_t i = 0; i < chunk; ++i)
+                {
+                    out[i * 2] = src[i];
+                    out[i * 2 + 1] = src[i];
+                }
+                out += chunk * 2;
+            }
+            else
+            {
+                memcpy(out, src, chunk * sizeof(int16_t));
+                out += chunk;
+            }
+            n -= chunk;
+            p = 0;
+        }
+        return;
+    }
+
+    // Tone generation: recursive oscillator (no sin per-sample)
+    const double coeff = 2.0 * cos(omega);
+    double phase = fmod(omega * static_cast<double>(index), 2.0 * M_PI);
+    double y_prev = sin(phase);
+    double y_cur = sin(phase + omega);
+    for (size_t i = 0; i < n; ++i)
+    {
+        int16_t outSample = Quantize((i == 0) ? y_prev : y_cur);
+        if (stereo)
+        {
+            out[i * 2] = outSample;
+            out[i * 2 + 1] = outSample;
+        }
+        else
+        {
+            out[i] = outSample;
+        }
+        if (i > 0)
+        {
+            double y_next = coeff * y_cur - y_prev;
+            y_prev = y_cur;
+            y_cur = y_next;
+        }
+    }
+}
+
+double ToneTable::GetTone() const { return Tone; }
+double ToneTable::GetSps() const { return Sps; }
+size_t ToneTable::GetPeriod() const { return table.size(); }
+
+/**
+* Constructor
+*
+* @param offset
+* @param samples_per_second
+* @param amplitude
+*/
+IqTable::IqTable(double offset, double samples_per_second, double amplitude)
+{
+    Offset = offset;
+    Sps = samples_per_second;
+    Amp = amplitude;
+    omega = (2.0 * M_PI * Offset) / Sps;
+
+    // offset and sps in millihertz, an offset of 0 is a period of 1
+    long long num = llabs(llround(Offset * 1000.0));
+    long long den = llround(Sps * 1000.0);
+    if (den <= 0) return;
+    long long cycle = den / gcd(num, den);
+    if (cycle > static_cast<long long>(MAX_PERIOD)) return;
+
+    // short periods are repeated up to ANCHOR samples, so copies stay long
+    period = static_cast<size_t>(cycle);
+    size_t length = period * ((ANCHOR + period - 1) / period);
+    table.resize(length * 2);
+    for (size_t k = 0; k < length; ++k)
+    {
+        table[k * 2] = static_cast<float>(Amp * cos(omega * static_cast<double>(k)));
+        table[k * 2 + 1] = static_cast<float>(Amp * sin(omega * static_cast<double>(k)));
+    }
+}
+
+/**
+* Write n I/Q pairs starting at oscillator sample index
+*
+* @param out
+* @param index
+* @param n
+*/
+void IqTable::Fill(float* out, uint64_t index, size_t n) const
+{
+    if (!table.empty())
+    {
+        // Fast path: copy from the period table
+        const size_t length = table.size() / 2;
+        size_t p = static_cast<size_t>(index % period);
+        while (n > 0)
+        {
+            size_t chunk = min(n, length - p);
+            memcpy(out, table.data() + p * 2, chunk * 2 * sizeof(float));
+            out += chunk * 2;
+            n -= chunk;
+            p = 0;
+        }
+        return;
+    }
+
+    // Phasor lanes: lane j holds sample i + j and turns by LANES steps,
+    // the phase is set exactly again every ANCHOR samples
+    const float cr = static_cast<float>(cos(omega * LANES));
+    const float ci = static_cast<float>(sin(omega * LANES));
+    float zr[LANES], zi[LANES];
+    for (size_t i = 0; i < n; i += ANCHOR)
+    {
+        for (int j = 0; j < LANES; ++j)
+        {
+            double phase = fmod(omega * static_cast<double>(index + i + j), 2.0 * M_PI);
+            zr[j] = static_cast<float>(Amp * cos(phase));
+            zi[j] = static_cast<float>(Amp * sin(phase));
+        }
+        size_t end = min(n, i + ANCHOR);
+        size_t k = i;
+        for (; k + LANES <= end; k += LANES)
+        {
+            float* o = out + k * 2;
+            for (int j = 0; j < LANES; ++j)
+            {
+                o[j * 2] = zr[j];
+                o[j * 2 + 1] = zi[j];
+                float r = zr[j] * cr - zi[j] * ci;
+                zi[j] = zr[j] * ci + zi[j] * cr;
+                zr[j] = r;
+            }
+        }
+        for (int j = 0; k < end; ++k, ++j)
+        {
+            out[k * 2] = zr[j];
+            out[k * 2 + 1] = zi[j];
+        }
+    }
+}
+
+/**
+* Convert n floats of full scale 1.0 to 16 bit, rounding to nearest
+*
+* @param in
+* @param out
+* @param n
+*/
+void IqTable::ToCs16(const float* in, int16_t* out, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        float v = in[i] * 32767.0f;
+        v = (v < -32767.0f) ? -32767.0f : v;
+        v = (v > 32767.0f) ? 32767.0f : v;
+        out[i] = static_cast<int16_t>(v + copysign(0.5f, v));
+    }
+}
+
+double IqTable::GetOffset() const { return Offset; }
+double IqTable::GetSps() const { return Sps; }
+size_t IqTable::GetPeriod() const { return period; }
+
+/**
+* Constructor
+*
+* @param timing
+* @param table
+* @param wpm
+* @param channels
+*/
+MorseRender::MorseRender(const MorseTiming& timing, const ToneTable& table, double wpm, int channels)
+    : timing(timing), table(table)
+{
+    NumChannels = (channels == 2) ? 2 : 1;
+    unitSamples = MorseTiming::SamplesPerUnit(wpm, table.GetSps());
+    Rewind();
+}
+
+/**
+* Start again at the beginning of the timeline
+*/
+void MorseRender::Rewind()
+{
+    run = 0;
+    toneIndex = 0;
+    position = 0;
+    if (impair) impair->Rewind();
+    LoadRun();
+}
+
+/**
+* Render through a channel impairment simulator
+*
+* @param impairment
+*/
+void MorseRender::SetImpairment(MorseImpair* impairment)
+{
+    impair = impairment;
+    Rewind();
+}
+
+/**
+* Shape the rise and fall of every mark
+*
+* @param keyramp
+*/
+void MorseRender::SetRamp(const KeyRamp* keyramp)
+{
+    ramp = keyramp;
+    edges.clear();
+    edgeSlot.clear();
+    markReady = false;
+}
+
+/**
+* Get a shaped rise or fall that starts at oscillator sample index, made
+* on first use from the tone table and the ramp
+*
+* @param index
+* @param edge
+* @param fall
+* @return const int16_t*
+*/
+const int16_t* MorseRender::GetEdge(uint64_t index, uint64_t edge, bool fall)
+{
+    if (edgeSlot.empty()) edgeSlot.assign(table.GetPeriod() * 2, -1);
+    size_t key = static_cast<size_t>(index % table.GetPeriod()) * 2 + (fall ? 1 : 0);
+    if (edgeSlot[key] >= 0) return edges[edgeSlot[key]].data();
+    if (edges.size() >= MAX_EDGES) return nullptr;
+
+    vector<int16_t> shaped(static_cast<size_t>(edge) * NumChannels);
+    table.Fill(shaped.data(), index, static_cast<size_t>(edge), NumChannels);
+    // a mark of two edges: the rise is its first half, the fall its second
+    ramp->Apply(shaped.data(), fall ? edge : 0, edge * 2, static_cast<size_t>(edge), NumChannels);
+    edgeSlot[key] = static_cast<int32_t>(edges.size());
+    edges.push_back(move(shaped));
+    return edges.back().data();
+}
+
+/**
+* Render n samples of the current mark with shaped edges: the rise and
+* the fall are copied from the edge cache, the steady part in between
+* from the tone table. Short marks and tones without a period table are
+* multiplied instead. The edges are looked up once per mark, a mark
+* rendered in small blocks pays for them once
+*
+* @param out
+* @param n
+*/
+void MorseRender::RenderMark(int16_t* out, size_t n)
+{
+    const uint64_t at = length - left;
+    if (!markReady)
+    {
+        const uint64_t start = toneIndex - at; // oscillator index at the start of the mark
+        markEdge = ramp->GetEdge(length);
+        markRise = markFall = nullptr;
+        if (markEdge > 0 && markEdge == ramp->GetLength() && table.GetPeriod() > 0)
+        {
+            markRise = GetEdge(start, markEdge, false);
+            markFall = GetEdge(start + length - markEdge, markEdge, true);
+        }
+        markReady = true;
+    }
+    const uint64_t edge = markEdge;
+    const uint64_t fall = length - edge;
+    const int16_t* up = markRise;
+    const int16_t* down = markFall;
+    if (!up || !down)
+    {
+        table.Fill(out, toneIndex, n, NumChannels);
+        ramp->Apply(out, at, length, n, NumChannels);
+        return;
+    }
+
+    size_t k = 0;
+    if (at < edge)
+    {
+        k = static_cast<size_t>(min<uint64_t>(n, edge - at));
+        memcpy(out, up + at * NumChannels, k * NumChannels * sizeof(int16_t));
+    }
+    if (k < n && at + k < fall)
+    {
+        size_t m = static_cast<size_t>(min<uint64_t>(n - k, fall - (at + k)));
+        table.Fill(out + k * NumChannels, toneIndex + k, m, NumChannels);
+        k += m;
+    }
+    if (k < n)
+    {
+        memcpy(out + k * NumChannels, down + (at + k - fall) * NumChannels, (n - k) * NumChannels * sizeof(int16_t));
+    }
+}
+
+/**
+* Load the sample count of the current run, skipping empty runs
+*/
+void MorseRender::LoadRun()
+{
+    const vector<KeyRun>& runs = timing.GetRuns();
+    left = 0;
+    while (run < runs.size())
+    {
+        left = impair ? impair->GetLength(run) : static_cast<uint64_t>(runs[run].units) * unitSamples;
+        if (left > 0) break;
+        ++run;
+    }
+    length = left;
+    markReady = false;
+}
+
+/**
+* Render up to frames frames into out
+*
+* @param out
+* @param frames
+* @return size_t
+*/
+size_t MorseRender::Render(int16_t* out, size_t frames)
+{
+    if (impair && !impair->CleanTone()) return RenderImpaired(out, frames);
+    const vector<KeyRun>& runs = timing.GetRuns();
+    size_t written = 0;
+    while (written < frames && run < runs.size())
+    {
+        size_t n = static_cast<size_t>(min<uint64_t>(left, frames - written));
+        int16_t* dst = out + written * NumChannels;
+        if (runs[run].key)
+        {
+            if (ramp) RenderMark(dst, n);
+            else table.Fill(dst, toneIndex, n, NumChannels);
+            toneIndex += n;
+        }
+        else
+        {
+            // Fast path: fill zeros for silence
+            memset(dst, 0, n * NumChannels * sizeof(int16_t));
+        }
+        written += n;
+        left -= n;
+        if (left == 0)
+        {
+            ++run;
+            LoadRun();
+        }
+    }
+    // noise and jitter only: the tone is the clean one, the noise goes on top
+    if (impair) impair->AddNoise(out, position, written, NumChannels);
+    position += written;
+    return written;
+}
+
+/**
+* Render up to frames complex baseband frames into out, interleaved I/Q
+*
+* @param iq
+* @param out
+* @param frames
+* @return size_t
+*/
+size_t MorseRender::RenderIq(const IqTable& iq, float* out, size_t frames)
+{
+    const vector<KeyRun>& runs = timing.GetRuns();
+    size_t written = 0;
+    while (written < frames && run < runs.size())
+    {
+        size_t n = static_cast<size_t>(min<uint64_t>(left, frames - written));
+        float* dst = out + written * 2;
+        if (runs[run].key)
+        {
+            iq.Fill(dst, toneIndex, n);
+            if (ramp) ramp->Apply(dst, length - left, length, n, 2);
+            toneIndex += n;
+        }
+        else
+        {
+            fill(dst, dst + n * 2, 0.0f);
+        }
+        written += n;
+        left -= n;
+        if (left == 0)
+        {
+            ++run;
+            LoadRun();
+        }
+    }
+    position += written;
+    return written;
+}
+
+/**
+* Render up to frames frames through the impairment simulator, a float
+* block at a time
+*
+* @param out
+* @param frames
+* @return size_t
+*/
+size_t MorseRender::RenderImpaired(int16_t* out, size_t frames)
+{
+    const vector<KeyRun>& runs = timing.GetRuns();
+    size_t written = 0;
+    while (written < frames && run < runs.size())
+    {
+        size_t chunk = min(frames - written, MorseImpair::BLOCK_FRAMES);
+        float* x = impair->GetBlock();
+        size_t filled = 0;
+        while (filled < chunk && run < runs.size())
+        {
+            size_t n = static_cast<size_t>(min<uint64_t>(left, chunk - filled));
+            if (runs[run].key)
+            {
+                impair->Key(x + filled, position + written + filled, n);
+                if (ramp) ramp->Apply(x + filled, length - left, length, n, 1);
+            }
+            else
+            {
+                fill(x + filled, x + filled + n, 0.0f);
+            }
+            filled += n;
+            left -= n;
+            if (left == 0)
+            {
+                ++run;
+                LoadRun();
+            }
+        }
+        impair->Finish(out + written * NumChannels, position + written, filled, NumChannels);
+        written += filled;
+    }
+    position += written;
+    return written;
+}
+
+bool MorseRender::Done() const
+{
+    return run >= timing.GetRuns().size();
+}
+
+uint64_t MorseRender::GetFrameCount() const
+{
+    if (impair) return impair->GetFrameCount();
+    return timing.GetUnits() * unitSamples;
+}
+
+uint64_t MorseRender::GetPosition() const
+{
+    return position;
+}
+
+/**
+* Go on at oscillator sample index
+*
+* @param index
+*/
+void MorseRender::SetToneIndex(uint64_t index)
+{
+    toneIndex = index;
+    markReady = false;
+}
+
+uint64_t MorseRender::GetToneIndex() const
+{
+    return toneIndex;
+}
+
+int MorseRender::GetChannels() const
+{
+    return NumChannels;
+}
+
+const ToneTable& MorseRender::GetTable() const
+{
+    return table;
+}
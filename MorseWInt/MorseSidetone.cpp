@@ -0,0 +1,181 @@
+#include "morsesidetone.h"
+#include <algorithm>
+
+/**
+* C++ MorseSidetone Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor, the code of every character is looked up once here so a
+* keystroke costs no regex and no map search
+*
+* @param sink
+* @param tone
+* @param wpm
+* @param samples_per_second
+* @param uppercase
+* @param envelope
+*/
+MorseSidetone::MorseSidetone(MorseSink& sink, double tone, double wpm, double samples_per_second, bool uppercase, const Envelope* envelope)
+    : sink(sink), Wpm(wpm), Sps(samples_per_second), table(tone, samples_per_second, 0.8), keys(KEY_QUEUE)
+{
+    Morse m(uppercase);
+    for (int c = 33; c < 127; ++c)
+    {
+        codes[c] = m.morse_encode(string(1, static_cast<char>(c)));
+    }
+    if (envelope && envelope->IsActive()) ramp = make_unique<KeyRamp>(*envelope, Sps);
+    block.resize(BLOCK_FRAMES);
+}
+
+MorseSidetone::~MorseSidetone()
+{
+    Stop();
+}
+
+/**
+* Open the sink and start the worker
+*/
+void MorseSidetone::Start()
+{
+    Stop();
+    sink.Open(1, Sps);
+    stopping.store(false);
+    toneIndex = 0;
+    worker = thread(&MorseSidetone::Work, this);
+}
+
+/**
+* Send a character
+*
+* @param c
+* @return bool
+*/
+bool MorseSidetone::Key(char c)
+{
+    Keystroke k;
+    k.c = c;
+    k.at = chrono::steady_clock::now();
+    return keys.Write(&k, 1) == 1;
+}
+
+/**
+* Wait until every character typed is sent
+*/
+void MorseSidetone::Drain()
+{
+    while (worker.joinable() && !IsIdle()) this_thread::sleep_for(chrono::milliseconds(1));
+}
+
+/**
+* Stop at once
+*/
+void MorseSidetone::Stop()
+{
+    stopping.store(true, memory_order_release);
+    if (worker.joinable()) worker.join();
+}
+
+/**
+* Worker: one character after the other, the sink is closed on Stop
+*/
+void MorseSidetone::Work()
+{
+    // a character typed while the one before is sent waits for its end
+    chrono::steady_clock::time_point ready = chrono::steady_clock::now();
+    Keystroke k;
+    while (!stopping.load(memory_order_acquire))
+    {
+        busy.store(true, memory_order_relaxed);
+        if (keys.Read(&k, 1) == 0)
+        {
+            busy.store(false, memory_order_release);
+            this_thread::sleep_for(chrono::microseconds(IDLE_MICROSECONDS));
+            continue;
+        }
+        if (Send(k, ready)) ready = chrono::steady_clock::now();
+    }
+    sink.Flush();
+    sink.Close();
+    busy.store(false, memory_order_release);
+}
+
+/**
+* Render one character and its letter space into the sink
+*
+* @param k
+* @param ready - end of the character before
+* @return bool - false for characters without code
+*/
+bool MorseSidetone::Send(const Keystroke& k, chrono::steady_clock::time_point ready)
+{
+    // a space adds to the letter space before it, as morse_encode does
+    const string& code = codes[static_cast<unsigned char>(k.c)];
+    if (code.empty() && k.c != ' ') return false;
+    string timeline = code + " ";
+
+    MorseTiming timing(timeline.c_str());
+    MorseRender render(timing, table, Wpm, 1);
+    if (ramp) render.SetRamp(ramp.get());
+    render.SetToneIndex(toneIndex);
+
+    chrono::steady_clock::time_point start = max(k.at, ready);
+    bool first = true;
+    while (!render.Done())
+    {
+        size_t n = render.Render(block.data(), BLOCK_FRAMES);
+        const int16_t* frames = block.data();
+        while (n > 0)
+        {
+            if (stopping.load(memory_order_acquire)) return true;
+            size_t w = sink.Write(frames, n);
+            if (w == 0)
+            {
+                this_thread::sleep_for(chrono::microseconds(IDLE_MICROSECONDS));
+                continue;
+            }
+            if (first)
+            {
+                int64_t us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+                lastLatency.store(us, memory_order_relaxed);
+                if (us > maxLatency.load(memory_order_relaxed)) maxLatency.store(us, memory_order_relaxed);
+                first = false;
+            }
+            frames += w;
+            n -= w;
+        }
+    }
+    toneIndex = render.GetToneIndex();
+    sent.fetch_add(1, memory_order_relaxed);
+    return true;
+}
+
+/**
+* Is nothing queued or being sent
+*
+* @return bool
+*/
+bool MorseSidetone::IsIdle() const
+{
+    return !busy.load(memory_order_acquire) && keys.Size() == 0;
+}
+
+uint64_t MorseSidetone::GetSent() const
+{
+    return sent.load(memory_order_relaxed);
+}
+
+double MorseSidetone::GetLastLatency() const
+{
+    return lastLatency.load(memory_order_relaxed) / 1000.0;
+}
+
+double MorseSidetone::GetMaxLatency() const
+{
+    return maxLatency.load(memory_order_relaxed) / 1000.0;
+}
@@ -0,0 +1,314 @@
+#include "morsesink.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#ifdef _WIN32
+#pragma comment(lib, "winmm.lib")
+#endif
+
+/**
+* C++ NullSink, WavSink and WaveOutSink Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param realtime
+* @param bufferFrames
+*/
+NullSink::NullSink(bool realtime, size_t bufferFrames)
+    : realtime(realtime), bufferFrames(bufferFrames)
+{
+}
+
+void NullSink::Open(int channels, double samples_per_second)
+{
+    (void)channels;
+    Sps = samples_per_second;
+    written = playedBefore = 0;
+    paused = false;
+    played.store(0, memory_order_relaxed);
+    since = chrono::steady_clock::now();
+}
+
+/**
+* Frames the clock has played, an empty buffer holds the clock back
+*
+* @return uint64_t
+*/
+uint64_t NullSink::Clock()
+{
+    if (!realtime || paused) return min(playedBefore, written);
+    auto now = chrono::steady_clock::now();
+    uint64_t p = playedBefore + static_cast<uint64_t>(chrono::duration<double>(now - since).count() * Sps);
+    if (p > written)
+    {
+        // ran dry, the clock starts again with the next frames
+        playedBefore = written;
+        since = now;
+        p = written;
+    }
+    played.store(p, memory_order_relaxed);
+    return p;
+}
+
+/**
+* Take up to n frames, in real time mode as many as the buffer has room for
+*
+* @param frames
+* @param n
+* @return size_t
+*/
+size_t NullSink::Write(const int16_t* frames, size_t n)
+{
+    (void)frames;
+    if (realtime)
+    {
+        uint64_t queued = written - Clock();
+        n = static_cast<size_t>(min<uint64_t>(n, bufferFrames - min<uint64_t>(queued, bufferFrames)));
+    }
+    written += n;
+    if (!realtime) played.store(written, memory_order_relaxed);
+    return n;
+}
+
+void NullSink::Pause(bool hold)
+{
+    if (hold == paused) return;
+    if (hold) playedBefore = Clock();
+    else since = chrono::steady_clock::now();
+    paused = hold;
+}
+
+void NullSink::Flush()
+{
+    written = Clock();
+}
+
+/**
+* Wait until the clock has played every frame
+*/
+void NullSink::Close()
+{
+    paused = false;
+    while (realtime && Clock() < written)
+    {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    played.store(written, memory_order_relaxed);
+}
+
+uint64_t NullSink::GetPlayed() const
+{
+    return played.load(memory_order_relaxed);
+}
+
+/**
+* Constructor
+*
+* @param path
+*/
+WavSink::WavSink(const string& path)
+{
+    FullPath = path;
+}
+
+/**
+* Open the file and write a header with empty sizes
+*
+* @param channels
+* @param samples_per_second
+*/
+void WavSink::Open(int channels, double samples_per_second)
+{
+    NumChannels = channels;
+    written = 0;
+    played.store(0, memory_order_relaxed);
+
+    out.open(FullPath, ios::binary);
+    if (!out.is_open())
+    {
+        cerr << "Failed to open file: " << FullPath << '\n';
+        throw runtime_error("Error opening file or directory");
+    }
+    uint32_t size = 0, fmt_size = 16, rate = static_cast<uint32_t>(samples_per_second);
+    uint16_t format = 1, nchannels = static_cast<uint16_t>(channels), bits = 16;
+    uint16_t align = static_cast<uint16_t>(channels * 2);
+    uint32_t bytes_per_sec = rate * align;
+    out.write("RIFF", 4);
+    out.write(reinterpret_cast<const char*>(&size), 4);
+    out.write("WAVEfmt ", 8);
+    out.write(reinterpret_cast<const char*>(&fmt_size), 4);
+    out.write(reinterpret_cast<const char*>(&format), 2);
+    out.write(reinterpret_cast<const char*>(&nchannels), 2);
+    out.write(reinterpret_cast<const char*>(&rate), 4);
+    out.write(reinterpret_cast<const char*>(&bytes_per_sec), 4);
+    out.write(reinterpret_cast<const char*>(&align), 2);
+    out.write(reinterpret_cast<const char*>(&bits), 2);
+    out.write("data", 4);
+    out.write(reinterpret_cast<const char*>(&size), 4);
+}
+
+size_t WavSink::Write(const int16_t* frames, size_t n)
+{
+    out.write(reinterpret_cast<const char*>(frames), n * NumChannels * sizeof(int16_t));
+    written += n;
+    played.store(written, memory_order_relaxed);
+    return n;
+}
+
+void WavSink::Pause(bool paused)
+{
+    (void)paused; // a file does not play in time
+}
+
+void WavSink::Flush()
+{
+}
+
+/**
+* Fill in the riff and data sizes and close the file
+*/
+void WavSink::Close()
+{
+    if (!out.is_open()) return;
+    uint32_t data_size = static_cast<uint32_t>(written * NumChannels * sizeof(int16_t));
+    uint32_t riff_size = data_size + 36;
+    out.seekp(4);
+    out.write(reinterpret_cast<const char*>(&riff_size), 4);
+    out.seekp(40);
+    out.write(reinterpret_cast<const char*>(&data_size), 4);
+    out.close();
+}
+
+uint64_t WavSink::GetPlayed() const
+{
+    return played.load(memory_order_relaxed);
+}
+
+#ifdef _WIN32
+/**
+* Constructor
+*
+* @param periodMs
+*/
+WaveOutSink::WaveOutSink(int periodMs)
+    : periodMs(periodMs)
+{
+    memset(headers, 0, sizeof headers);
+}
+
+WaveOutSink::~WaveOutSink()
+{
+    if (device)
+    {
+        Flush();
+        Close();
+    }
+}
+
+/**
+* Open the default device and prepare the buffers
+*
+* @param channels
+* @param samples_per_second
+*/
+void WaveOutSink::Open(int channels, double samples_per_second)
+{
+    NumChannels = channels;
+    WAVEFORMATEX wfx = {};
+    wfx.wFormatTag = WAVE_FORMAT_PCM;
+    wfx.nChannels = static_cast<WORD>(channels);
+    wfx.wBitsPerSample = 16;
+    wfx.nBlockAlign = static_cast<WORD>(channels * 2);
+    wfx.nSamplesPerSec = static_cast<DWORD>(samples_per_second);
+    wfx.nAvgBytesPerSec = wfx.nSamplesPerSec * wfx.nBlockAlign;
+    if (waveOutOpen(&device, WAVE_MAPPER, &wfx, 0, 0, CALLBACK_NULL) != MMSYSERR_NOERROR)
+    {
+        device = NULL;
+        cerr << "Failed to open audio device\n";
+        throw runtime_error("Error opening audio device");
+    }
+    periodFrames = max<size_t>(64, static_cast<size_t>(samples_per_second * periodMs / 1000.0));
+    for (int b = 0; b < BUFFERS; ++b)
+    {
+        buffers[b].assign(periodFrames * channels, 0);
+        memset(&headers[b], 0, sizeof(WAVEHDR));
+        headers[b].lpData = reinterpret_cast<LPSTR>(buffers[b].data());
+        headers[b].dwBufferLength = static_cast<DWORD>(periodFrames * channels * sizeof(int16_t));
+        waveOutPrepareHeader(device, &headers[b], sizeof(WAVEHDR));
+        headers[b].dwFlags |= WHDR_DONE; // free to fill
+    }
+    next = 0;
+}
+
+/**
+* Fill the next buffer the device is done with and queue it
+*
+* @param frames
+* @param n
+* @return size_t
+*/
+size_t WaveOutSink::Write(const int16_t* frames, size_t n)
+{
+    WAVEHDR& h = headers[next];
+    if (!(h.dwFlags & WHDR_DONE)) return 0;
+    n = min(n, periodFrames);
+    memcpy(buffers[next].data(), frames, n * NumChannels * sizeof(int16_t));
+    h.dwBufferLength = static_cast<DWORD>(n * NumChannels * sizeof(int16_t));
+    h.dwFlags &= ~WHDR_DONE;
+    waveOutWrite(device, &h, sizeof(WAVEHDR));
+    next = (next + 1) % BUFFERS;
+    return n;
+}
+
+void WaveOutSink::Pause(bool paused)
+{
+    if (paused) waveOutPause(device);
+    else waveOutRestart(device);
+}
+
+/**
+* Drop the queued buffers, the device marks them done
+*/
+void WaveOutSink::Flush()
+{
+    waveOutReset(device);
+}
+
+/**
+* Wait for the queued buffers, then release the device
+*/
+void WaveOutSink::Close()
+{
+    if (!device) return;
+    for (int b = 0; b < BUFFERS; ++b)
+    {
+        while (!(headers[b].dwFlags & WHDR_DONE)) Sleep(1);
+        waveOutUnprepareHeader(device, &headers[b], sizeof(WAVEHDR));
+    }
+    waveOutClose(device);
+    device = NULL;
+}
+
+/**
+* Get the frames played so far from the device position
+*
+* @return uint64_t
+*/
+uint64_t WaveOutSink::GetPlayed() const
+{
+    if (!device) return 0;
+    MMTIME t = {};
+    t.wType = TIME_SAMPLES;
+    waveOutGetPosition(device, &t, sizeof t);
+    return t.u.sample;
+}
+#endif
@@ -0,0 +1,256 @@
+#include "morseskimmer.h"
+#include "morsetiming.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/**
+* C++ MorseSkimmer Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param samples_per_second
+* @param wpm
+* @param uppercase
+*/
+MorseSkimmer::MorseSkimmer(double samples_per_second, double wpm, bool uppercase)
+    : morse(uppercase), Sps(samples_per_second),
+    N(max<size_t>(MorseFft::Pow2(static_cast<size_t>(samples_per_second / BIN_HZ)), 64)),
+    Hop(N / 4), Channels(N / 2 + 1), fft(N)
+{
+    window.resize(N);
+    MorseFft::Hann(window.data(), N);
+    frame.resize(N);
+    bins.resize(Channels);
+    input.resize(N);
+
+    double binHz = GetBinHz();
+    Lo = max<size_t>(2, static_cast<size_t>(MIN_TONE / binHz));
+    Hi = min(Channels - 3, static_cast<size_t>(MAX_TONE / binHz));
+
+    // same envelope timing as MorseDecoder, peak halves in about 2 seconds
+    peakDecay = pow(0.5, 1.0 / (2.0 * Sps / Hop));
+
+    level.assign(Channels, 0.0f);
+    peak.assign(Channels, 0.0f);
+    powerSum.assign(Channels, 0.0);
+    key.assign(Channels, 0);
+    run.assign(Channels, 0);
+    change.assign(Channels, 0);
+
+    double unit = static_cast<double>(MorseTiming::SamplesPerUnit((wpm > 0.0) ? wpm : 20.0, Sps)) / Hop;
+    classifiers.assign(Channels, MorseClassifier(unit));
+    word.resize(Channels);
+    code.resize(Channels);
+    text.resize(Channels);
+}
+
+/**
+* Feed mono samples, one filter bank output every Hop samples
+*
+* @param mono
+* @param n
+*/
+void MorseSkimmer::Process(const int16_t* mono, size_t n)
+{
+    while (n > 0)
+    {
+        size_t take = min(n, N - filled);
+        memcpy(input.data() + filled, mono, take * sizeof(int16_t));
+        filled += take;
+        mono += take;
+        n -= take;
+        if (filled == N)
+        {
+            Transform();
+            Keying();
+            memmove(input.data(), input.data() + Hop, (N - Hop) * sizeof(int16_t));
+            filled = N - Hop;
+        }
+    }
+}
+
+/**
+* Flush all channels
+*/
+void MorseSkimmer::Finish()
+{
+    for (size_t c = 0; c < Channels; ++c)
+    {
+        if (run[c] > 0) Run(c, key[c] != 0, run[c]);
+        run[c] = 0;
+        classifiers[c].Flush();
+        Drain(c);
+        EndWord(c);
+        while (!code[c].empty() && code[c].back() == ' ') code[c].pop_back();
+        while (!text[c].empty() && text[c].back() == ' ') text[c].pop_back();
+    }
+}
+
+/**
+* Decode a whole wav file
+*
+* @param reader
+*/
+void MorseSkimmer::Decode(MorseWavReader& reader)
+{
+    vector<int16_t> buffer(READ_FRAMES);
+    size_t n;
+    while ((n = reader.Read(buffer.data(), buffer.size())) > 0)
+    {
+        Process(buffer.data(), n);
+    }
+    Finish();
+}
+
+/**
+* Get signals found, local maxima of the average spectrum above the
+* lower quartile bin
+*
+* @return vector
+*/
+vector<MorseSkimmer::Signal> MorseSkimmer::GetSignals() const
+{
+    vector<Signal> signals;
+    double binHz = GetBinHz();
+    if (hops == 0) return signals;
+
+    vector<double> power(powerSum.begin() + Lo, powerSum.begin() + Hi + 1);
+    nth_element(power.begin(), power.begin() + power.size() / 4, power.end());
+    double noise = max(power[power.size() / 4], 1e-9);
+
+    for (size_t c = Lo; c <= Hi; ++c)
+    {
+        double p = powerSum[c];
+        if (p <= powerSum[c - 1] || p < powerSum[c + 1] || p < MIN_SNR * noise || text[c].empty()) continue;
+
+        // Gaussian interpolation of the carrier frequency, as MorseDecoder::EstimateTone
+        double a = log(powerSum[c - 1] + 1e-12), b = log(p), d = log(powerSum[c + 1] + 1e-12);
+        double den = a - 2.0 * b + d;
+        double delta = (den < 0.0) ? 0.5 * (a - d) / den : 0.0;
+
+        Signal s;
+        s.tone = (c + delta) * binHz;
+        s.snr = p / noise;
+        s.wpm = 1.2 * Sps / (classifiers[c].GetUnit() * Hop);
+        s.morse = code[c];
+        s.text = text[c];
+        signals.push_back(s);
+    }
+    return signals;
+}
+
+/**
+* Get channel width in Hz
+*
+* @return double
+*/
+double MorseSkimmer::GetBinHz() const
+{
+    return Sps / N;
+}
+
+/**
+* Windowed transform of the last N samples into channel levels
+*/
+void MorseSkimmer::Transform()
+{
+    for (size_t i = 0; i < N; ++i) frame[i] = input[i] * window[i];
+    fft.Real(frame.data(), bins.data());
+    const double scale = 2.0 / N;
+    for (size_t c = 0; c < Channels; ++c) level[c] = static_cast<float>(abs(bins[c]) * scale);
+}
+
+/**
+* Key every channel on its level. The noise is the median level over the
+* band, taken from the lower quartile so a crowded band does not lift it.
+* A channel keys up below half way between the noise and its own decaying
+* peak (0.4 / 0.6 hysteresis as MorseDecoder). To key down it must also be
+* KEY_SNR times the noise and not far below the bins next to it, so Hann
+* sidelobes of a strong neighbour stay key up. A change must hold DEBOUNCE
+* hops, which drops the one hop clicks of hard keyed neighbours.
+*/
+void MorseSkimmer::Keying()
+{
+    const float decay = static_cast<float>(peakDecay);
+    sorted.assign(level.begin() + Lo, level.begin() + Hi + 1);
+    nth_element(sorted.begin(), sorted.begin() + sorted.size() / 4, sorted.end());
+    const float noise = sorted[sorted.size() / 4] * 1.55f; // Rayleigh lower quartile to median
+    const float gate = static_cast<float>(KEY_SNR) * noise;
+    hops++;
+
+    for (size_t c = Lo; c <= Hi; ++c)
+    {
+        float l = level[c];
+        powerSum[c] += static_cast<double>(l) * l;
+        float p = max(l, peak[c] * decay);
+        peak[c] = p;
+
+        bool k = key[c] != 0;
+        float threshold = noise + (p - noise) * (k ? 0.4f : 0.6f);
+        float side = static_cast<float>(SIDE_RATIO) * max(max(level[c - 2], level[c - 1]), max(level[c + 1], level[c + 2]));
+        bool down = l > threshold && (k || (l > gate && l >= side));
+
+        run[c]++;
+        if (down == k) change[c] = 0;
+        else if (++change[c] == DEBOUNCE)
+        {
+            Run(c, k, run[c] - DEBOUNCE);
+            run[c] = DEBOUNCE;
+            key[c] = down;
+            change[c] = 0;
+        }
+    }
+}
+
+/**
+* Pass a run of one channel to its classifier
+*
+* @param c
+* @param down
+* @param length
+*/
+void MorseSkimmer::Run(size_t c, bool down, uint32_t length)
+{
+    if (length == 0) return;
+    classifiers[c].Add(down, static_cast<double>(length));
+    Drain(c);
+}
+
+/**
+* Take completed characters of one channel
+*
+* @param c
+*/
+void MorseSkimmer::Drain(size_t c)
+{
+    string elements;
+    int gap;
+    while (classifiers[c].Next(elements, gap))
+    {
+        if (!word[c].empty()) word[c] += ' ';
+        word[c] += elements;
+        code[c] += elements + " ";
+        if (gap == RUN_WORD_GAP) EndWord(c);
+    }
+}
+
+/**
+* Word gap of one channel, decode the word with the Morse tables
+*
+* @param c
+*/
+void MorseSkimmer::EndWord(size_t c)
+{
+    if (word[c].empty()) return;
+    text[c] += morse.morse_decode(word[c]) + " ";
+    code[c] += " ";
+    word[c].clear();
+}
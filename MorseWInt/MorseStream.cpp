@@ -0,0 +1,168 @@
+#include "morsestream.h"
+#include <memory>
+#include <stdexcept>
+
+/**
+* C++ MorseStream Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param morsecode
+* @param tone
+* @param wpm
+* @param samples_per_second
+* @param modus
+* @param raw
+* @param out
+* @param impairment
+* @param envelope
+*/
+MorseStream::MorseStream(const char* morsecode, double tone, double wpm, double samples_per_second, int modus, bool raw, FILE* out, const Impairment* impairment, const Envelope* envelope)
+{
+    Out = out;
+    Raw = raw;
+    NumChannels = (modus == 2) ? 2 : 1;
+    Sps = samples_per_second;
+
+    MorseTiming timing(morsecode);
+    ToneTable table(tone, Sps, 0.8);
+    MorseRender render(timing, table, wpm, NumChannels);
+    unique_ptr<MorseImpair> impair;
+    if (impairment && impairment->IsActive())
+    {
+        impair = make_unique<MorseImpair>(*impairment, timing, tone, wpm, Sps, 0.8);
+        render.SetImpairment(impair.get());
+    }
+    unique_ptr<KeyRamp> ramp;
+    if (envelope && envelope->IsActive())
+    {
+        ramp = make_unique<KeyRamp>(*envelope, Sps);
+        render.SetRamp(ramp.get());
+    }
+
+    if (!Raw) WriteStreamHeader(Out, NumChannels, Sps, 16);
+
+    block.resize(BLOCK_FRAMES * NumChannels);
+    while (!render.Done())
+    {
+        size_t frames = render.Render(block.data(), BLOCK_FRAMES);
+        Write(block.data(), frames * NumChannels * sizeof(int16_t));
+        fflush(Out); // hand every block to the reader right away
+        PcmCount += frames;
+    }
+}
+
+/**
+* Constructor for complex baseband
+*
+* @param morsecode
+* @param offset
+* @param wpm
+* @param samples_per_second
+* @param cs16
+* @param out
+* @param envelope
+*/
+MorseStream::MorseStream(const char* morsecode, double offset, double wpm, double samples_per_second, bool cs16, FILE* out, const Envelope* envelope)
+{
+    Out = out;
+    Raw = true;
+    NumChannels = 1;
+    Sps = samples_per_second;
+
+    MorseTiming timing(morsecode);
+    ToneTable table(0.0, Sps, 0.0); // not sounded, the timeline keys iq
+    IqTable iq(offset, Sps, 0.8);
+    MorseRender render(timing, table, wpm, NumChannels);
+    unique_ptr<KeyRamp> ramp;
+    if (envelope && envelope->IsActive())
+    {
+        ramp = make_unique<KeyRamp>(*envelope, Sps);
+        render.SetRamp(ramp.get());
+    }
+
+    vector<float> samples(BLOCK_FRAMES * 2);
+    if (cs16) block.resize(BLOCK_FRAMES * 2);
+    while (!render.Done())
+    {
+        size_t frames = render.RenderIq(iq, samples.data(), BLOCK_FRAMES);
+        if (cs16)
+        {
+            IqTable::ToCs16(samples.data(), block.data(), frames * 2);
+            Write(block.data(), frames * 2 * sizeof(int16_t));
+        }
+        else
+        {
+            Write(samples.data(), frames * 2 * sizeof(float));
+        }
+        fflush(Out); // hand every block to the reader right away
+        PcmCount += frames;
+    }
+}
+
+/**
+* Get number of frames written
+*
+* @return uint64_t
+*/
+uint64_t MorseStream::GetPcmCount()
+{
+    return PcmCount;
+}
+
+/**
+* Write a WAV header with unknown riff and data sizes, readers like sox,
+* ffmpeg and aplay then read until end of stream
+*
+* @param out
+* @param channels
+* @param sps
+* @param bits
+*/
+void MorseStream::WriteStreamHeader(FILE* out, int channels, double sps, int bits)
+{
+    uint32_t unknown = 0xFFFFFFFF;
+    uint32_t fmt_size = 16;
+    uint16_t format = 1; // WAVE_FORMAT_PCM
+    uint16_t nchannels = static_cast<uint16_t>(channels);
+    uint32_t rate = static_cast<uint32_t>(sps);
+    uint16_t align = static_cast<uint16_t>(channels * bits / 8);
+    uint32_t bytes_per_sec = rate * align;
+    uint16_t nbits = static_cast<uint16_t>(bits);
+
+    bool ok = true;
+    ok &= fwrite("RIFF", 1, 4, out) == 4;
+    ok &= fwrite(&unknown, 4, 1, out) == 1;
+    ok &= fwrite("WAVEfmt ", 1, 8, out) == 8;
+    ok &= fwrite(&fmt_size, 4, 1, out) == 1;
+    ok &= fwrite(&format, 2, 1, out) == 1;
+    ok &= fwrite(&nchannels, 2, 1, out) == 1;
+    ok &= fwrite(&rate, 4, 1, out) == 1;
+    ok &= fwrite(&bytes_per_sec, 4, 1, out) == 1;
+    ok &= fwrite(&align, 2, 1, out) == 1;
+    ok &= fwrite(&nbits, 2, 1, out) == 1;
+    ok &= fwrite("data", 1, 4, out) == 4;
+    ok &= fwrite(&unknown, 4, 1, out) == 1;
+    if (!ok) throw runtime_error("Error writing to output stream");
+}
+
+/**
+* Write bytes
+*
+* @param data
+* @param size
+*/
+void MorseStream::Write(const void* data, size_t size)
+{
+    if (size > 0 && fwrite(data, 1, size, Out) != size)
+    {
+        throw runtime_error("Error writing to output stream");
+    }
+}
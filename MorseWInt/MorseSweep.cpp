@@ -0,0 +1,108 @@
+#include "morsesweep.h"
+#include <chrono>
+#include <sstream>
+
+/**
+* C++ MorseSweep Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param text
+* @param uppercase
+*/
+MorseSweep::MorseSweep(const string& text, bool uppercase)
+    : MorseCode(Encode(text, uppercase)), timing(MorseCode.c_str())
+{
+}
+
+/**
+* Encode text once
+*
+* @param text
+* @param uppercase
+* @return string
+*/
+string MorseSweep::Encode(const string& text, bool uppercase)
+{
+    Morse m(uppercase);
+    return m.morse_encode(text);
+}
+
+/**
+* Get the shared oscillator table for tone and sps
+*
+* @param tone
+* @param sps
+* @return ToneTable
+*/
+const ToneTable& MorseSweep::GetTable(double tone, double sps)
+{
+    auto key = make_pair(tone, sps);
+    auto it = tables.find(key);
+    if (it == tables.end())
+    {
+        it = tables.emplace(key, make_unique<ToneTable>(tone, sps, 0.8)).first;
+    }
+    return *it->second;
+}
+
+/**
+* Render every tone x wpm x sps combination to a wav file
+*
+* @param tones
+* @param wpms
+* @param spss
+* @param modus
+*/
+void MorseSweep::Run(const vector<double>& tones, const vector<double>& wpms, const vector<double>& spss, int modus)
+{
+    auto start = chrono::steady_clock::now();
+    for (double sps : spss)
+    {
+        for (double tone : tones)
+        {
+            const ToneTable& table = GetTable(tone, sps);
+            for (double wpm : wpms)
+            {
+                MorseRender render(timing, table, wpm, modus);
+                ostringstream name;
+                name << tone << "hz_" << wpm << "wpm_" << sps;
+                MorseWav mw(render, wpm, false, name.str());
+                files.push_back(mw.GetFullPath());
+                seconds += (double)mw.GetPcmCount() / sps;
+                cout << " " << mw.GetFullPath() << " (" << (mw.GetWaveSize() / 1024.0) << " kB)\n";
+            }
+        }
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << files.size() << " WAV files, " << seconds << " s audio in " << elapsed << " s";
+    if (elapsed > 0.0) cout << " (" << (seconds / elapsed) << "x real time)";
+    cout << "\n";
+}
+
+/**
+* Get morse code string
+*
+* @return string
+*/
+string MorseSweep::GetMorseCode()
+{
+    return MorseCode;
+}
+
+/**
+* Get written wav files
+*
+* @return vector
+*/
+const vector<string>& MorseSweep::GetFiles()
+{
+    return files;
+}
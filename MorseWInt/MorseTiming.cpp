@@ -0,0 +1,103 @@
+#include "morsetiming.h"
+#include <cmath>
+
+/**
+* C++ MorseTiming Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Constructor
+*
+* @param morsecode
+*/
+MorseTiming::MorseTiming(const char* morsecode)
+{
+	char c;
+	while ((c = *morsecode++) != '\0')
+	{
+		if (c == '.') Dit();
+		if (c == '-') Dah();
+		if (c == ' ') Space();
+	}
+}
+
+/**
+* Get keying runs
+*
+* @return vector
+*/
+const vector<KeyRun>& MorseTiming::GetRuns() const
+{
+	return runs;
+}
+
+/**
+* Get total length in morse units
+*
+* @return uint64_t
+*/
+uint64_t MorseTiming::GetUnits() const
+{
+	return units;
+}
+
+/**
+* Get number of morse units with key down
+*
+* @return uint64_t
+*/
+uint64_t MorseTiming::GetMarkUnits() const
+{
+	return markUnits;
+}
+
+/**
+* Get number of samples per morse unit
+* Note 60 seconds = 1 minute and 50 elements = 1 morse word.
+*
+* @param wpm
+* @param sps
+* @return size_t
+*/
+size_t MorseTiming::SamplesPerUnit(double wpm, double sps)
+{
+	if (wpm <= 0.0 || sps <= 0.0) return 0;
+	return static_cast<size_t>(round((1.2 / wpm) * sps));
+}
+
+/**
+* Append units of tone or silence, merging with the previous run
+*
+* @param key
+* @param n
+*/
+void MorseTiming::Append(bool key, uint32_t n)
+{
+	if (!runs.empty() && runs.back().key == key)
+	{
+		runs.back().units += n;
+	}
+	else
+	{
+		runs.push_back({ key, n });
+	}
+	units += n;
+	if (key) markUnits += n;
+}
+
+/**
+* Define dit, dah and space.
+*
+* The rules of 1/3/7 and 1/2/4 timing conventions
+* symbol space is one silence
+* letter space is two silences
+* word space is four silences
+*/
+void MorseTiming::Dit() { Append(true, 1); Append(false, 1); }
+void MorseTiming::Dah() { Append(true, 3); Append(false, 1); }
+void MorseTiming::Space() { Append(false, 2); }
@@ -8,32 +8,140 @@ using namespace std;
 /**
 * Constructor
 */
-MorseWav::MorseWav(const char* morsecode, double tone, double wpm, double samples_per_second, int modus, bool show)
+MorseWav::MorseWav(const char* morsecode, double tone, double wpm, double samples_per_second, int modus, bool show, MorseCache* cache, int format, const Impairment* impairment, const Envelope* envelope, MorsePlayer* player)
 {
+    Format = format;
     MorseWav::CreateFullPath();
     MorseCode = morsecode;
-    NumChannels = modus;
+    NumChannels = IsIq() ? 1 : modus; // complex baseband is one channel of I/Q pairs
     Wpm = wpm;
     Tone = tone;
     Sps = samples_per_second;
+    this->show = show;
 
     // Note 60 seconds = 1 minute and 50 elements = 1 morse word.
     Eps = Wpm / 1.2;    // elements per second (frequency of morse coding)
     Bit = 1.2 / Wpm;    // seconds per element (period of morse coding)
 
 	cout << "wave: " << Sps << " Hz (-sps:" << Sps << ")\n";
-	cout << "tone: " << Tone << " Hz (-tone:" << Tone << ")\n";
+	if (IsIq()) cout << "offset: " << Tone << " Hz (-offset:" << Tone << ")\n";
+	else cout << "tone: " << Tone << " Hz (-tone:" << Tone << ")\n";
 	cout << "code: " << Eps << " Hz (-wpm:" << Wpm << ")\n";
 
-    MorseWav::MorseTones(MorseCode);
-    MorseWav::WriteWav(pcm);
+    MorseTiming timing(MorseCode);
+    ToneTable table(IsIq() ? 0.0 : Tone, Sps, Amplitude); // complex baseband keys an IqTable instead
+    MorseRender render(timing, table, Wpm, NumChannels);
+    unique_ptr<MorseImpair> impair;
+    if (impairment && impairment->IsActive() && IsIq())
+    {
+        cout << "channel: impairments apply to audio formats only\n";
+    }
+    else if (impairment && impairment->IsActive())
+    {
+        // the same seed gives the same file, so impaired files are cached too
+        cout << "channel: " << impairment->GetName() << "\n";
+        impair = make_unique<MorseImpair>(*impairment, timing, Tone, Wpm, Sps, Amplitude);
+        render.SetImpairment(impair.get());
+    }
+
+    unique_ptr<KeyRamp> ramp;
+    if (envelope && envelope->IsActive())
+    {
+        cout << "keying: " << envelope->GetName() << "\n";
+        ramp = make_unique<KeyRamp>(*envelope, Sps);
+        render.SetRamp(ramp.get());
+    }
+
+    // play while rendering: sound starts with the first block, the file is
+    // written from the same blocks while it plays
+    if (player && show && !IsIq())
+    {
+        this->player = player;
+        live = make_shared<PcmBuffer>(render.GetFrameCount(), NumChannels, Sps);
+    }
 
+    string key;
+    if (cache)
+    {
+        // identical code and settings give an identical file, skip rendering on a hit
+        string format = GetFormatName();
+        if (impair) format += "_" + impairment->GetName();
+        if (ramp) format += "_" + envelope->GetName();
+        key = MorseCache::Key(MorseCode, Tone, Wpm, Sps, NumChannels, format);
+        if (cache->Fetch(key, FullPath))
+        {
+            cached = true;
+            if (live) MorseWav::MorseTones(render); // rendered for the player only
+            PcmCount = static_cast<long>(render.GetFrameCount());
+            WaveSize = static_cast<long>(filesystem::file_size(FullPath));
+            MorseWav::Report();
+            return;
+        }
+    }
+    try
+    {
+        if (Format == FORMAT_FLAC)
+        {
+            MorseWav::WriteFlac(render);
+        }
+        else if (Format == FORMAT_MULAW || Format == FORMAT_ALAW || Format == FORMAT_IMA_ADPCM)
+        {
+            MorseWav::WriteCodec(render);
+        }
+        else if (IsIq())
+        {
+            MorseWav::WriteIq(render);
+        }
+        else
+        {
+            MorseWav::WritePcm(render);
+        }
+    }
+    catch (...)
+    {
+        if (live) live->Close(); // the player ends with what it has
+        throw;
+    }
+    if (cache) cache->Store(key, FullPath);
+    MorseWav::Report();
+}
+
+/**
+* Constructor for a prepared renderer, the timeline and oscillator table
+* are owned by the caller and can be shared between many wav files
+*/
+MorseWav::MorseWav(MorseRender& render, double wpm, bool show, const string& name)
+{
+    MorseWav::CreateFullPath(name);
+    MorseCode = "";
+    NumChannels = render.GetChannels();
+    Wpm = wpm;
+    Tone = render.GetTable().GetTone();
+    Sps = render.GetTable().GetSps();
+    this->show = show;
+    Eps = Wpm / 1.2;
+    Bit = 1.2 / Wpm;
+
+    render.Rewind();
+    MorseWav::WritePcm(render);
+}
+
+/**
+* Print summary and open media player
+*/
+void MorseWav::Report()
+{
+    if (live) live->Close();
 	int mod = (NumChannels == 2) ? 2 : 1;
-	cout << PcmCount * mod << " PCM samples";
+	cout << PcmCount * mod << (IsIq() ? " I/Q samples" : " PCM samples");
 	cout << " (" << ((double)PcmCount / Sps) << " s @ " << (Sps / 1e3) << " kHz)";
-	cout << " written to\n " << FullPath << " (" << (WaveSize / 1024.0) << " kB)\n";
+	cout << (cached ? " from cache to\n " : " written to\n ") << FullPath << " (" << (WaveSize / 1024.0) << " kB)\n";
 
-    if (show)
+    if (live)
+    {
+        cout << "playing while written\n";
+    }
+    else if (show)
     {
         /* IF SHELLAPI DOES NOT WORK, USE SYSTEM COMMAND
 		 * BUT THIS OPENS A NEW CONSOLE WINDOW WHICH IS ANNOYING
@@ -55,15 +163,51 @@ string MorseWav::GetFullPath()
 	return FullPath;
 }
 
-void MorseWav::CreateFullPath()
+/**
+* Get output directory
+*/
+string MorseWav::GetSaveDir()
+{
+    return SaveDir;
+}
+
+/**
+* Was the file served from the render cache
+*/
+bool MorseWav::IsCached()
+{
+    return cached;
+}
+
+void MorseWav::CreateFullPath(const string& name)
 {
     string filename = "morse_";
     filename += to_string(time(NULL));
-    filename += ".wav";
+    if (!name.empty()) filename += "_" + name;
+    if (Format == FORMAT_FLAC) filename += ".flac";
+    else if (IsIq()) filename += "." + GetFormatName();
+    else filename += ".wav";
 
     FullPath = SaveDir + filename;
 }
 
+/**
+* Get format name, used for cache keys
+*/
+string MorseWav::GetFormatName()
+{
+    switch (Format)
+    {
+    case FORMAT_FLAC: return "flac";
+    case FORMAT_MULAW: return "mulaw";
+    case FORMAT_ALAW: return "alaw";
+    case FORMAT_IMA_ADPCM: return "ima_adpcm";
+    case FORMAT_IQ_CF32: return "cf32";
+    case FORMAT_IQ_CS16: return "cs16";
+    default: return "pcm16";
+    }
+}
+
 /**
 * Get GetPcmCount
 */
@@ -81,146 +225,267 @@ long MorseWav::GetWaveSize()
 }
 
 /**
-* Get binary morse code (dit/dah) for a given character.
-* Generate one quantum of silence or tone in PCM/WAV array.
-* sine wave: y(t) = amplitude * sin(2 * PI * frequency * time), time = s / sample_rate
+* Morse code tone generator
+* Renders the whole keying timeline block by block into the player's
+* buffer, for a file that is only played
 *
-* @param silence
+* @param render
 */
-void MorseWav::Tones(int silence)
+void MorseWav::MorseTones(MorseRender& render)
 {
-    double seconds = Bit;   // seconds to generate for this quantum
-    size_t numsamples = static_cast<size_t>(round(seconds * Sps)); // samples per channel
-    if (numsamples == 0) return;
-
-    const bool stereo = (NumChannels == 2);
-    size_t samplesToAdd = numsamples * (stereo ? 2u : 1u);
-
-    // Resize once up-front and write by index (avoids push_back overhead and reallocations)
-    size_t old = pcm.size();
-    pcm.resize(old + samplesToAdd);
+    PcmCount = 0;
+    while (!render.Done())
+    {
+        size_t n = render.Render(live->GetWrite(), LIVE_FRAMES);
+        live->Publish(n);
+        MorseWav::Publish(nullptr, 0);
+        PcmCount += static_cast<long>(n);
+    }
+}
 
-    constexpr double twoPi = 2.0 * M_PI;
-    constexpr int16_t maxInt16 = numeric_limits<int16_t>::max();
-    const double amp = Amplitude * static_cast<double>(maxInt16);
+/**
+* Hand a rendered block to the player, block may be nullptr when the
+* frames were rendered into the buffer in place; a player that cannot
+* start leaves the file alone
+*
+* @param block
+* @param frames
+*/
+void MorseWav::Publish(const int16_t* block, size_t frames)
+{
+    if (!live) return;
+    if (block) live->Append(block, frames);
+    if (!player) return;
+    try
+    {
+        player->Play(live);
+    }
+    catch (const exception& e)
+    {
+        cerr << "Failed to start playback: " << e.what() << '\n';
+    }
+    player = nullptr; // started, the next blocks are only published
+}
 
-    if (silence == 0)
+/**
+* Create SaveDir if it does not exist
+*/
+void MorseWav::CreateSaveDir()
+{
+    // Try to create the directory
+    if (_mkdir(SaveDir.c_str()) == 0)
     {
-        // Fast path: fill zeros for silence
-        if (stereo)
+        cerr << "Directory created successfully.\n";
+    }
+    else
+    {
+        if (errno == EEXIST)
         {
-            for (size_t i = 0; i < numsamples; ++i)
-            {
-                pcm[old + i * 2]     = 0;
-                pcm[old + i * 2 + 1] = 0;
-            }
+            cerr << "Directory already exists.\n";
         }
         else
         {
-            for (size_t i = 0; i < numsamples; ++i)
-            {
-                pcm[old + i] = 0;
-            }
+            cerr << "Error creating directory\n";
+            throw runtime_error("Error creating directory");
+            //exit(1);
         }
-        PcmCount += static_cast<long>(numsamples); // PcmCount counts frames (samples-per-channel)
-        return;
+    }
+}
+
+/**
+* Render and encode a FLAC file block by block, no full PCM array is needed
+*
+* @param render
+*/
+void MorseWav::WriteFlac(MorseRender& render)
+{
+    MorseWav::CreateSaveDir();
+
+    ofstream out(FullPath, ios::binary);
+    if (!out.is_open())
+    {
+        cerr << "Failed to open file: " << FullPath << '\n';
+        throw runtime_error("Error opening file or directory");
     }
 
-    // Tone generation: efficient recursive oscillator (no sin per-sample)
-    const double omega = (twoPi * Tone) / Sps;
-    const double coeff = 2.0 * cos(omega);
+    FlacEncoder flac(out, NumChannels, static_cast<uint32_t>(Sps), render.GetFrameCount());
+    vector<int16_t> block(FlacEncoder::BLOCK_SIZE * NumChannels);
+    PcmCount = 0;
+    while (!render.Done())
+    {
+        size_t frames = render.Render(block.data(), FlacEncoder::BLOCK_SIZE);
+        MorseWav::Publish(block.data(), frames);
+        flac.Write(block.data(), frames);
+        PcmCount += static_cast<long>(frames);
+    }
+    flac.Finish();
+    WaveSize = static_cast<long>(out.tellp());
+    out.close();
+}
 
-    // initialize two starting values for the recurrence using the persistent phase
-    double y_prev = sin(phase);
-    double y_cur  = sin(phase + omega);
+/**
+* Render and write a mu-law, A-law or IMA ADPCM wav file block by block
+*
+* @param render
+*/
+void MorseWav::WriteCodec(MorseRender& render)
+{
+    uint32_t frames = static_cast<uint32_t>(render.GetFrameCount());
+    uint32_t data_size, fmt_size, riff_size, fact_size = 4;
+    WORD samplesPerBlock = 0;
+    size_t blockFrames = 4096;
+    size_t blockBytes = 0;
 
-    if (stereo)
+	WAVEFORMATEX wfx = { 0 }; // mmeapi.h
+    wfx.nChannels = NumChannels;
+    wfx.nSamplesPerSec = (DWORD)Sps;
+    if (Format == FORMAT_IMA_ADPCM)
     {
-        for (size_t i = 0; i < numsamples; ++i)
-        {
-            double sample = (i == 0) ? y_prev : y_cur;
-            double scaled = sample * amp;
-            if (scaled > maxInt16) scaled = maxInt16;
-            else if (scaled < -maxInt16) scaled = -maxInt16;
-            int16_t outSample = static_cast<int16_t>(scaled);
-
-            pcm[old + i * 2]     = outSample;
-            pcm[old + i * 2 + 1] = outSample;
-
-            double y_next = coeff * y_cur - y_prev;
-            y_prev = y_cur;
-            y_cur = y_next;
-        }
+        size_t align = MorseCodec::ImaBlockAlign(NumChannels, Sps);
+        blockFrames = MorseCodec::ImaSamplesPerBlock(align, NumChannels);
+        blockBytes = align;
+        samplesPerBlock = (WORD)blockFrames;
+        wfx.wFormatTag = MorseCodec::TAG_IMA_ADPCM;
+        wfx.wBitsPerSample = 4;
+        wfx.nBlockAlign = (WORD)align;
+        wfx.nAvgBytesPerSec = (DWORD)(Sps * align / blockFrames);
+        wfx.cbSize = 2; // wSamplesPerBlock follows
+        data_size = (uint32_t)(((frames + blockFrames - 1) / blockFrames) * align);
     }
     else
     {
-        for (size_t i = 0; i < numsamples; ++i)
-        {
-            double sample = (i == 0) ? y_prev : y_cur;
-            double scaled = sample * amp;
-            if (scaled > maxInt16) scaled = maxInt16;
-            else if (scaled < -maxInt16) scaled = -maxInt16;
-            int16_t outSample = static_cast<int16_t>(scaled);
+        wfx.wFormatTag = (Format == FORMAT_MULAW) ? MorseCodec::TAG_MULAW : MorseCodec::TAG_ALAW;
+        wfx.wBitsPerSample = 8;
+        wfx.nBlockAlign = wfx.nChannels;
+        wfx.nAvgBytesPerSec = wfx.nSamplesPerSec * wfx.nBlockAlign;
+        wfx.cbSize = 0;
+        data_size = frames * NumChannels;
+    }
+    fmt_size = sizeof wfx + wfx.cbSize;
+    riff_size = 4 + (8 + fmt_size) + (8 + fact_size) + (8 + data_size + (data_size & 1));
+    WaveSize = riff_size + 8;
 
-            pcm[old + i] = outSample;
+    MorseWav::CreateSaveDir();
 
-            double y_next = coeff * y_cur - y_prev;
-            y_prev = y_cur;
-            y_cur = y_next;
-        }
+    ofstream out(FullPath, ios::binary);
+    if (!out.is_open())
+    {
+        cerr << "Failed to open file: " << FullPath << '\n';
+        throw runtime_error("Error opening file or directory");
     }
 
-    PcmCount += static_cast<long>(numsamples); // increment frames (samples per channel)
+    // RIFF header
+    out.write("RIFF", 4);
+    out.write(reinterpret_cast<const char*>(&riff_size), 4);
+    out.write("WAVE", 4);
+
+    // fmt subchunk
+    out.write("fmt ", 4);
+    out.write(reinterpret_cast<const char*>(&fmt_size), 4);
+    out.write(reinterpret_cast<const char*>(&wfx), sizeof wfx);
+    if (wfx.cbSize) out.write(reinterpret_cast<const char*>(&samplesPerBlock), 2);
+
+    // fact subchunk, number of samples per channel
+    out.write("fact", 4);
+    out.write(reinterpret_cast<const char*>(&fact_size), 4);
+    out.write(reinterpret_cast<const char*>(&frames), 4);
 
-    // advance phase by the generated duration so next Tones() call is continuous
-    double phaseAdvance = numsamples * omega;
-    phase += phaseAdvance;
-    // keep phase normalized to [0, 2*pi)
-    while (phase >= twoPi) phase -= twoPi;
-    while (phase < 0.0) phase += twoPi;
+    // data subchunk
+    out.write("data", 4);
+    out.write(reinterpret_cast<const char*>(&data_size), 4);
+
+    vector<int16_t> block(blockFrames * NumChannels);
+    vector<uint8_t> coded(max(blockBytes, blockFrames * NumChannels));
+    MorseCodec codec(NumChannels);
+    PcmCount = 0;
+    while (!render.Done())
+    {
+        size_t n = render.Render(block.data(), blockFrames);
+        MorseWav::Publish(block.data(), n);
+        size_t bytes;
+        if (Format == FORMAT_IMA_ADPCM)
+        {
+            codec.ImaBlock(block.data(), n, coded.data(), blockBytes);
+            bytes = blockBytes;
+        }
+        else
+        {
+            bytes = n * NumChannels;
+            if (Format == FORMAT_MULAW) MorseCodec::MuLaw(block.data(), coded.data(), bytes);
+            else MorseCodec::ALaw(block.data(), coded.data(), bytes);
+        }
+        out.write(reinterpret_cast<const char*>(coded.data()), bytes);
+        PcmCount += static_cast<long>(n);
+    }
+    if (data_size & 1) out.put(0); // chunks are word aligned
+
+    out.flush();
+    out.close();
 }
 
 /**
-* Define dit, dah and space.
+* Render and write raw complex baseband block by block, cf32 or cs16
+* interleaved I/Q at Sps with the keyed carrier at Tone hertz offset
 *
-* The rules of 1/3/7 and 1/2/4 timing conventions
-* Mobile (micro)phones will compress space tones, better do it yourself:
-* symbol space is one silence
-* letter space is two silences
-* word space is four silences
+* @param render
 */
-void MorseWav::Dit() { Tones(1); Tones(0); }
-void MorseWav::Dah() { Tones(1); Tones(1); Tones(1); Tones(0); }
-void MorseWav::Space() { Tones(0); Tones(0); }
+void MorseWav::WriteIq(MorseRender& render)
+{
+    const size_t blockFrames = 4096;
+    const bool cs16 = (Format == FORMAT_IQ_CS16);
+    MorseWav::CreateSaveDir();
+
+    ofstream out(FullPath, ios::binary);
+    if (!out.is_open())
+    {
+        cerr << "Failed to open file: " << FullPath << '\n';
+        throw runtime_error("Error opening file or directory");
+    }
+
+    IqTable iq(Tone, Sps, Amplitude);
+    vector<float> block(blockFrames * 2);
+    vector<int16_t> packed(cs16 ? blockFrames * 2 : 0);
+    PcmCount = 0;
+    while (!render.Done())
+    {
+        size_t n = render.RenderIq(iq, block.data(), blockFrames);
+        if (cs16)
+        {
+            IqTable::ToCs16(block.data(), packed.data(), n * 2);
+            out.write(reinterpret_cast<const char*>(packed.data()), n * 2 * sizeof(int16_t));
+        }
+        else
+        {
+            out.write(reinterpret_cast<const char*>(block.data()), n * 2 * sizeof(float));
+        }
+        PcmCount += static_cast<long>(n);
+    }
+    out.flush();
+    WaveSize = static_cast<long>(out.tellp());
+    out.close();
+}
 
 /**
-* Morse code tone generator
-* 
-* @param code
+* Is the format complex baseband
+*
+* @return bool
 */
-void MorseWav::MorseTones(const char* code)
+bool MorseWav::IsIq()
 {
-    char c;
-    while ((c = *code++) != '\0')
-    {
-        //printf("%c", c);
-        if (c == '.') Dit();
-        if (c == '-') Dah();
-        if (c == ' ') Space();
-    }
+    return Format == FORMAT_IQ_CF32 || Format == FORMAT_IQ_CS16;
 }
 
 /**
-* Write wav file
+* Render and write a 16 bit PCM wav file block by block, the header goes
+* first as the frame count is known. With a player the blocks are
+* rendered into its buffer and published before they are written
 *
-* @param filename
-* @param pcmData
+* @param render
 */
-void MorseWav::WriteWav(const vector<int16_t> &pcmdata)
+void MorseWav::WritePcm(MorseRender& render)
 {
     long data_size, wave_size, riff_size;
     int fmt_size = 16;
-    FILE* file = NULL;
 
 	WAVEFORMATEX wfx = { 0 }; // mmeapi.h
     wfx.wFormatTag = WAVE_FORMAT_PCM;
@@ -232,36 +497,18 @@ void MorseWav::WriteWav(const vector<int16_t> &pcmdata)
     wfx.cbSize = 0;
 
     wave_size = sizeof wfx;
-    data_size = (PcmCount * wfx.wBitsPerSample * wfx.nChannels) / 8;
+    data_size = static_cast<long>((render.GetFrameCount() * wfx.wBitsPerSample * wfx.nChannels) / 8);
     riff_size = fmt_size + wave_size + data_size; // 36 + data_size
 	WaveSize = riff_size + 8; // 44 + dataSize
 
-    // Try to create the directory
-    if (_mkdir(SaveDir.c_str()) == 0)
-    {
-        cerr << "Directory created successfully.\n";
-    }
-    else
-    {
-        if (errno == EEXIST)
-        {
-            cerr << "Directory already exists.\n";
-        }
-        else
-        {
-            cerr << "Error creating directory\n";
-            throw runtime_error("Error creating directory");
-            //exit(1);
-        }
-    }
+    MorseWav::CreateSaveDir();
+
     // Open file for binary writing
     ofstream out(FullPath, ios::binary);
     if (!out.is_open())
     {
         cerr << "Failed to open file: " << FullPath << '\n';
-        // optionally inspect errno: perror("open");
         throw runtime_error("Error opening file or directory");
-        //exit(1);
     }
 
     // RIFF header
@@ -277,7 +524,22 @@ void MorseWav::WriteWav(const vector<int16_t> &pcmdata)
     // data subchunk
     out.write("data", 4);
     out.write(reinterpret_cast<const char*>(&data_size), 4);
-    out.write(reinterpret_cast<const char*>(pcmdata.data()), data_size);
+
+    const size_t blockFrames = live ? LIVE_FRAMES : 4096;
+    vector<int16_t> block(live ? 0 : blockFrames * NumChannels);
+    PcmCount = 0;
+    while (!render.Done())
+    {
+        int16_t* pcmdata = live ? live->GetWrite() : block.data();
+        size_t n = render.Render(pcmdata, blockFrames);
+        if (live)
+        {
+            live->Publish(n);
+            MorseWav::Publish(nullptr, 0);
+        }
+        out.write(reinterpret_cast<const char*>(pcmdata), n * NumChannels * sizeof(int16_t));
+        PcmCount += static_cast<long>(n);
+    }
 
     out.flush();
     out.close();
@@ -0,0 +1,292 @@
+#include "morsewavreader.h"
+#define NOMINMAX
+#include <windows.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+/**
+* C++ MorseWavReader Class
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+// one sample of each format as float, before the 1 / full scale factor
+struct SampleU8 { static const int Bytes = 1; static float Get(const uint8_t* p) { return static_cast<float>(static_cast<int>(p[0]) - 128); } };
+struct SampleS16 { static const int Bytes = 2; static float Get(const uint8_t* p) { int16_t s; memcpy(&s, p, 2); return s; } };
+struct SampleS24 { static const int Bytes = 3; static float Get(const uint8_t* p) { return static_cast<float>(static_cast<int32_t>((p[0] << 8) | (p[1] << 16) | (static_cast<uint32_t>(p[2]) << 24)) >> 8); } };
+struct SampleS32 { static const int Bytes = 4; static float Get(const uint8_t* p) { int32_t s; memcpy(&s, p, 4); return static_cast<float>(s); } };
+struct SampleF32 { static const int Bytes = 4; static float Get(const uint8_t* p) { float s; memcpy(&s, p, 4); return s; } };
+
+/**
+* Mix frames down to mono. Mono and stereo get their own loops with a
+* constant stride, which the compiler vectorizes
+*
+* @param in
+* @param out
+* @param frames
+* @param channels
+* @param scale - 1 / full scale
+*/
+template <typename Sample>
+static void Mix(const uint8_t* in, float* out, size_t frames, int channels, float scale)
+{
+    const int B = Sample::Bytes;
+    if (channels == 1)
+    {
+        for (size_t i = 0; i < frames; ++i) out[i] = Sample::Get(in + i * B) * scale;
+    }
+    else if (channels == 2)
+    {
+        scale *= 0.5f;
+        for (size_t i = 0; i < frames; ++i) out[i] = (Sample::Get(in + i * 2 * B) + Sample::Get(in + i * 2 * B + B)) * scale;
+    }
+    else
+    {
+        scale /= channels;
+        for (size_t i = 0; i < frames; ++i)
+        {
+            const uint8_t* p = in + i * channels * B;
+            float sum = 0.0f;
+            for (int ch = 0; ch < channels; ++ch) sum += Sample::Get(p + ch * B);
+            out[i] = sum * scale;
+        }
+    }
+}
+
+/**
+* Constructor
+*
+* @param path
+*/
+MorseWavReader::MorseWavReader(const string& path)
+{
+    File = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (File == INVALID_HANDLE_VALUE)
+    {
+        File = nullptr;
+        cerr << "Failed to open file: " << path << '\n';
+        throw runtime_error("Error opening file or directory");
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(File, &size) || size.QuadPart < 12)
+    {
+        Close();
+        throw runtime_error("Not a RIFF file");
+    }
+    FileSize = static_cast<uint64_t>(size.QuadPart);
+    Mapping = CreateFileMappingA(File, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (Mapping == NULL)
+    {
+        Close();
+        throw runtime_error("Failed to map file: " + path);
+    }
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    Granularity = info.dwAllocationGranularity;
+
+    try
+    {
+        const uint8_t* p = Map(0, 12);
+        if (memcmp(p, "RIFF", 4) != 0) throw runtime_error("Not a RIFF file");
+        if (memcmp(p + 8, "WAVE", 4) != 0) throw runtime_error("Not a WAVE file");
+
+        bool fmt = false;
+        uint64_t at = 12;
+        while (at + 8 <= FileSize)
+        {
+            p = Map(at, 8);
+            uint32_t chunk;
+            memcpy(&chunk, p + 4, 4);
+            if (memcmp(p, "fmt ", 4) == 0)
+            {
+                if (chunk < 16 || at + 8 + chunk > FileSize) throw runtime_error("Bad wav fmt chunk");
+                uint8_t f[40] = { 0 };
+                memcpy(f, Map(at + 8, min<uint32_t>(chunk, sizeof f)), min<uint32_t>(chunk, sizeof f));
+
+                uint16_t tag, channels, bits;
+                uint32_t rate;
+                memcpy(&tag, f, 2);
+                memcpy(&channels, f + 2, 2);
+                memcpy(&rate, f + 4, 4);
+                memcpy(&bits, f + 14, 2);
+                if (tag == 0xFFFE && chunk >= 40) memcpy(&tag, f + 24, 2); // WAVE_FORMAT_EXTENSIBLE sub format
+                bool pcm = tag == 1 && (bits == 8 || bits == 16 || bits == 24 || bits == 32);
+                bool ieee = tag == 3 && bits == 32;
+                if ((!pcm && !ieee) || channels < 1 || rate == 0)
+                {
+                    throw runtime_error("Unsupported wav format, use 8/16/24/32 bit PCM or 32 bit float");
+                }
+                NumChannels = channels;
+                Bits = bits;
+                Float = ieee;
+                Sps = rate;
+                FrameBytes = static_cast<size_t>(NumChannels) * Bits / 8;
+                fmt = true;
+            }
+            else if (memcmp(p, "data", 4) == 0)
+            {
+                if (!fmt) throw runtime_error("Wav data chunk before fmt chunk");
+                DataStart = at + 8;
+                // open ended or cut short: read what the file holds
+                uint64_t end = (chunk == 0xFFFFFFFF) ? FileSize : min(FileSize, DataStart + chunk);
+                DataEnd = DataStart + (end - DataStart) / FrameBytes * FrameBytes;
+                Frames = (DataEnd - DataStart) / FrameBytes;
+                Position = DataStart;
+                convert.resize(CONVERT_FRAMES);
+                return;
+            }
+            at += 8 + static_cast<uint64_t>(chunk) + (chunk & 1);
+        }
+        throw runtime_error("Wav file has no data chunk");
+    }
+    catch (...)
+    {
+        Close();
+        throw;
+    }
+}
+
+MorseWavReader::~MorseWavReader()
+{
+    Close();
+}
+
+/**
+* Read up to frames mono samples, -1.0 to 1.0
+*
+* @param out
+* @param frames
+* @return size_t
+*/
+size_t MorseWavReader::Read(float* out, size_t frames)
+{
+    size_t done = 0;
+    while (done < frames && Position + FrameBytes <= DataEnd)
+    {
+        const uint8_t* p = Map(Position, FrameBytes);
+        uint64_t mapped = (min(ViewEnd, DataEnd) - Position) / FrameBytes;
+        size_t n = static_cast<size_t>(min<uint64_t>(frames - done, mapped));
+        Convert(p, out + done, n);
+        Position += static_cast<uint64_t>(n) * FrameBytes;
+        done += n;
+    }
+    return done;
+}
+
+/**
+* Read up to frames mono samples, 16 bit
+*
+* @param out
+* @param frames
+* @return size_t
+*/
+size_t MorseWavReader::Read(int16_t* out, size_t frames)
+{
+    size_t done = 0;
+    while (done < frames)
+    {
+        size_t n = Read(convert.data(), min(frames - done, convert.size()));
+        if (n == 0) break;
+        // truncate like the integer mix down did, 8 and 16 bit input stays exact
+        for (size_t i = 0; i < n; ++i)
+        {
+            float s = convert[i] * 32768.0f;
+            out[done + i] = static_cast<int16_t>(max(-32768.0f, min(32767.0f, s)));
+        }
+        done += n;
+    }
+    return done;
+}
+
+/**
+* Go back to the first frame
+*/
+void MorseWavReader::Rewind()
+{
+    Position = DataStart;
+}
+
+int MorseWavReader::GetChannels() const
+{
+    return NumChannels;
+}
+
+int MorseWavReader::GetBits() const
+{
+    return Bits;
+}
+
+bool MorseWavReader::IsFloat() const
+{
+    return Float;
+}
+
+double MorseWavReader::GetSps() const
+{
+    return Sps;
+}
+
+uint64_t MorseWavReader::GetFrameCount() const
+{
+    return Frames;
+}
+
+/**
+* Pointer to bytes at a file offset, the view moves when they are not in
+* it. Views start on the allocation granularity and span VIEW_BYTES or to
+* end of file
+*
+* @param offset
+* @param bytes
+* @return const uint8_t*
+*/
+const uint8_t* MorseWavReader::Map(uint64_t offset, size_t bytes)
+{
+    if (offset + bytes > FileSize) throw runtime_error("Wav file is truncated");
+    if (View != nullptr && offset >= ViewStart && offset + bytes <= ViewEnd) return View + (offset - ViewStart);
+
+    if (View != nullptr) UnmapViewOfFile(View);
+    View = nullptr;
+    uint64_t start = offset - offset % Granularity;
+    uint64_t end = min(FileSize, max<uint64_t>(start + VIEW_BYTES, offset + bytes));
+    View = static_cast<const uint8_t*>(MapViewOfFile(Mapping, FILE_MAP_READ,
+        static_cast<DWORD>(start >> 32), static_cast<DWORD>(start & 0xFFFFFFFF), static_cast<size_t>(end - start)));
+    if (View == nullptr) throw runtime_error("Failed to map wav view");
+    ViewStart = start;
+    ViewEnd = end;
+    return View + (offset - ViewStart);
+}
+
+/**
+* Convert frames of the file format to normalized mono
+*
+* @param in
+* @param out
+* @param frames
+*/
+void MorseWavReader::Convert(const uint8_t* in, float* out, size_t frames) const
+{
+    if (Float) Mix<SampleF32>(in, out, frames, NumChannels, 1.0f);
+    else if (Bits == 8) Mix<SampleU8>(in, out, frames, NumChannels, 1.0f / 128.0f);
+    else if (Bits == 16) Mix<SampleS16>(in, out, frames, NumChannels, 1.0f / 32768.0f);
+    else if (Bits == 24) Mix<SampleS24>(in, out, frames, NumChannels, 1.0f / 8388608.0f);
+    else Mix<SampleS32>(in, out, frames, NumChannels, 1.0f / 2147483648.0f);
+}
+
+/**
+* Unmap the view and close the handles
+*/
+void MorseWavReader::Close()
+{
+    if (View != nullptr) UnmapViewOfFile(View);
+    if (Mapping != nullptr) CloseHandle(Mapping);
+    if (File != nullptr) CloseHandle(File);
+    View = nullptr;
+    Mapping = nullptr;
+    File = nullptr;
+}
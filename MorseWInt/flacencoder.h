@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+/**
+* C++ FlacEncoder Class
+*
+* Lossless FLAC encoder for 16 bit morse audio, no external libraries.
+* Silence blocks become CONSTANT subframes, tone blocks use the best FIXED
+* predictor or an LPC predictor (a pure sine is predicted almost exactly by
+* order 2), identical stereo channels are coded as left/side.
+* STREAMINFO carries the MD5 of the samples, so any decoder can verify the
+* round trip is bit exact.
+*/
+class FlacEncoder
+{
+public:
+	static const uint32_t BLOCK_SIZE = 1024; // samples per channel per frame
+	static const int MAX_LPC_ORDER = 8;
+	static const int QLP_PRECISION = 15;     // bits per quantized lpc coefficient
+
+private:
+	/**
+	* MSB first bit writer for one frame
+	*/
+	struct BitWriter
+	{
+		std::vector<uint8_t> bytes;
+		uint64_t acc = 0; // pending bits
+		int count = 0;    // number of pending bits
+		void Put(uint32_t value, int bits);
+		void PutSigned(int32_t value, int bits);
+		void PutRice(uint32_t value, int k);
+		void Align();
+		void Clear();
+	};
+
+	/**
+	* MD5 of the raw little endian samples, stored in STREAMINFO
+	*/
+	struct Md5
+	{
+		uint32_t state[4];
+		uint64_t length = 0;
+		uint8_t buffer[64];
+		Md5();
+		void Update(const uint8_t* data, size_t size);
+		void Final(uint8_t digest[16]);
+		void Transform(const uint8_t block[64]);
+	};
+
+	std::ostream& Out;             // seekable output stream
+	std::streampos Start;          // position of the "fLaC" marker
+	int NumChannels;               // 1 = mono, 2 = stereo
+	uint32_t Sps;                  // samples per second
+	uint64_t TotalFrames;          // samples per channel in the stream
+	uint64_t Samples = 0;          // samples per channel encoded
+	uint64_t FrameNumber = 0;      // frames written
+	uint32_t MinFrameBytes = 0xFFFFFF;
+	uint32_t MaxFrameBytes = 0;
+	std::vector<int16_t> pending;  // interleaved samples of the current block
+	std::vector<int32_t> channel[2];
+	std::vector<int32_t> residual;
+	std::vector<uint32_t> folded;  // zigzag residual for rice estimates
+	BitWriter frame;
+	Md5 md5;
+
+public:
+	/**
+	* Constructor, writes the stream marker and STREAMINFO
+	*
+	* @param out - binary, seekable
+	* @param channels
+	* @param samples_per_second
+	* @param total_frames - samples per channel, 0 if unknown
+	*/
+	FlacEncoder(std::ostream& out, int channels, uint32_t samples_per_second, uint64_t total_frames);
+	~FlacEncoder() = default;
+
+	/**
+	* Encode interleaved 16 bit samples
+	*
+	* @param pcm
+	* @param frames
+	*/
+	void Write(const int16_t* pcm, size_t frames);
+
+	/**
+	* Encode the last partial block and rewrite STREAMINFO with sizes and MD5
+	*/
+	void Finish();
+
+private:
+	void WriteStreamInfo(const uint8_t md5sum[16]);
+	void EncodeFrame(const int16_t* pcm, uint32_t n);
+	void EncodeSubframe(const int32_t* x, uint32_t n, int bps);
+	uint64_t ResidualBits(const int32_t* r, uint32_t n, int order, int& partitionOrder);
+	void WriteResidual(const int32_t* r, uint32_t n, int order, int partitionOrder);
+	bool FixedResidual(const int32_t* x, uint32_t n, int order);
+	int Levinson(const int32_t* x, uint32_t n, double lpc[MAX_LPC_ORDER][MAX_LPC_ORDER]);
+	static void Quantize(const double* lpc, int order, int32_t* qlp, int& shift);
+	bool LpcResidual(const int32_t* x, uint32_t n, int order, const int32_t* qlp, int shift);
+	static uint8_t Crc8(const uint8_t* data, size_t size);
+	static uint16_t Crc16(const uint8_t* data, size_t size);
+};
@@ -13,8 +13,24 @@
 #include "morse.h"
 #include "help.h"
 #include "morsewav.h"
+#include "morsesweep.h"
+#include "morsecache.h"
+#include "morsestream.h"
+#include "morsekeying.h"
+#include "morsebin.h"
+#include "morsedecoder.h"
+#include "morseskimmer.h"
+#include "morsebatch.h"
+#include "morselive.h"
+#include "morsemixer.h"
+#include "morseplayer.h"
+#include "morsesidetone.h"
 #include <vector>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 #include <thread>
+#include <chrono>
 #include <atomic>
 #include <cmath>
 #include <cstdint>
@@ -25,6 +41,7 @@
 #include <strsafe.h>
 #include <fcntl.h>
 #include <io.h>
+#include <conio.h> // _getch for live keying
 
 #define WM_MWAV_DONE (WM_USER + 1)
 
@@ -39,7 +56,7 @@ enum
     CID_ENCODE = 100, CID_DECODE = 101, CID_EDIT = 102, CID_MORSE = 103, CID_BIN = 104,
     CID_HEX = 105, CID_HEXBIN = 106, CID_M2WS = 107, CID_M2WM = 108, CID_WAVOUT = 109, CID_HELP = 110,
     CID_TONE = 111, CID_WPM = 112, CID_SPS = 113, CID_PROG = 114, CID_PLAY = 115, CID_PAUSE = 116, CID_STOP = 117,
-	CID_TRACK = 118, CID_UPPERCASE = 119
+	CID_TRACK = 118, CID_UPPERCASE = 119, CID_SIDETONE = 120
 };
 
 // Global handles to child controls
@@ -51,6 +68,7 @@ HWND hSps = NULL;
 HWND hProg = NULL;
 HWND hCountLabel = NULL;
 HWND hUpperCase = NULL;
+HWND hSidetone = NULL;
 
 // ------------------ Global Variables ----------------
 
@@ -61,6 +79,11 @@ string FullPath = ""; // full path to save file
 
 // config options
 const bool SHOW_EXTERNAL_MEDIAPLAYER = true; // play sound with visible external media player or not - CONSOLE MODUS ONLY
+const bool PLAY_WHILE_RENDERING = true; // play wav output in-process from the first rendered block instead of the external media player afterwards
+const bool USE_RENDER_CACHE = true; // reuse earlier wav files with identical morse code and settings
+const uintmax_t RENDER_CACHE_MAX_BYTES = 512ull * 1024 * 1024; // render cache size limit, least recently used files are removed
+unique_ptr<MorseCache> render_cache; // render cache in SaveDir\cache, created at startup, released after the render threads are done
+vector<HANDLE> render_threads; // GUI: running WAV render threads, waited for at exit
 
 // -------------------- Global Window Handles ----------------
 
@@ -82,6 +105,34 @@ int words_per_minute = 33;
 int samples_per_second = 44100;
 int lowercase = 0; // 0 = default (uppercase), 1 = enable lowercase mode
 
+int audio_format = FORMAT_PCM16; // output file format: -flac, -mulaw, -alaw, -adpcm, -cf32, -cs16
+double iq_offset = 0.0; // ew/ewm with -cf32/-cs16: keyed carrier offset from the centre frequency in Hz (-offset:Hz)
+int stream_out = 0; // 0 = wav file in SaveDir, 1 = wav to stdout (-stdout), 2 = raw pcm to stdout (-raw)
+int keying_format = KEYING_BINARY; // ek output: binary .mkey, -csv or -json
+int keying_unit = KEYING_SAMPLES; // ek durations in samples, -us for microseconds
+long long mbin_char = -1; // db: first character to decode (-char:N), -1 = from the start
+long long mbin_word = -1; // db: first word to decode (-word:N)
+long long mbin_count = 0; // db: number of characters or words (-n:N), 0 = to the end
+int matched_filter = 0; // dw: 1 = matched filter front end instead of Goertzel (-mf)
+int beam_width = 0; // dw: beam search hypotheses (-beam or -beam:K), 0 = greedy classifier
+string bigram_path = ""; // dw: text file the beam search bigram model is trained on (-lm:path)
+string chars_path = ""; // dw: character records file (-chars:path), .jsonl or binary .mchr
+int batch_threads = 0; // dd: decoding threads (-threads:N), 0 = one per core
+string batch_out = ""; // dd: directory for one .txt per wav (-out:dir), "" = results to stdout
+int mix_dither = 0; // em: 1 = TPDF dither to 16 bit (-dither), 0 = rounding
+Envelope envelope; // ew/ewm: keying ramps (-ramp:ms[,blackman]), hard keying by default
+Impairment impairment; // ew/ewm: channel simulation (-snr, -fade, -rician, -qsb, -drift, -jitter, -seed), off by default
+string play_sink = ""; // ep: "" = sound card, "null" = timed null output (-sink:null), else a wav path (-sink:path)
+WaveOutSink sound_out; // GUI: sound card for PLAY
+MorsePlayer player(sound_out); // GUI: in-process playback, PLAY/PAUSE/STOP
+WaveOutSink sidetone_out(5); // GUI: sound card for live keying, short buffers
+unique_ptr<MorseSidetone> sidetone; // GUI: live keying while the sidetone box is checked
+
+// sweep settings, comma separated lists (-hz:600,880 -wpm:20,30 -sps:8000,44100)
+string tone_list = "";
+string wpm_list = "";
+string sps_list = "";
+
 // ----------------- MorseWInt Data Structures ----------------
 
 struct WavThreadParams 
@@ -93,6 +144,9 @@ struct WavThreadParams
     int channels;
 	bool showExternal;
 	bool saveDirOk;
+    MorseCache* cache;
+    int format;
+    MorsePlayer* player;
     HWND hwnd;
 };
 
@@ -105,6 +159,7 @@ struct WavThreadResult
     size_t waveSize;
     size_t pcmCount;
     int channels;
+    bool cached;
 };
 
 struct ConsoleWavParams
@@ -115,13 +170,20 @@ struct ConsoleWavParams
     double sps;
     int channels;
     bool showExternal;
+    MorseCache* cache;
+    int format;
+    const Impairment* impairment;
+    const Envelope* envelope;
+    MorsePlayer* player;
 };
 
 // ---------------- MorseWInt Helper Functions ----------------
 
 string arg_string(char* arg);
+vector<double> parse_list(const string& list, double defaultVal);
 
-static void AttachToNewConsole();
+static void AttachToNewConsole(bool keepStdout);
+static FILE* OpenStdoutBinary();
 static bool HasConsole();
 static void MakeMorseSafe(double& tone, int& wpm, int& sps);
 
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "morsedecoder.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+enum BatchStage
+{
+	STAGE_OPEN = 0,   // wav header and mapping
+	STAGE_TONE = 1,   // tone estimate, when no tone is given
+	STAGE_READ = 2,   // samples to mono 16 bit
+	STAGE_DECODE = 3, // decoder setup, Process and Finish
+	STAGE_WRITE = 4,  // per file output
+	STAGE_COUNT = 5
+};
+
+/**
+* C++ MorseBatch Class
+*
+* Decodes many wav files on a pool of threads. The files are dealt round
+* robin to one queue per thread; a thread takes the lowest file from the
+* front of its own queue and, once that is empty, steals the highest from
+* the back of another, so one long recording does not leave the others
+* idle. Every thread keeps a decoder per sample rate (Morse tables, beam
+* search tables, bigram model) and its read buffer from file to file, a
+* decoder is reset and tuned to the next file instead of built again.
+* Results are written in file order as soon as a file and all files
+* before it are done, or each to its own text file.
+*/
+class MorseBatch
+{
+public:
+	struct Result
+	{
+		std::string path;
+		std::string morse;  // decoded morse code
+		std::string text;   // decoded text
+		double tone = 0.0;  // Hz
+		double wpm = 0.0;   // speed at the end
+		double seconds = 0.0; // audio length
+		std::string error;  // empty if decoded
+	};
+
+private:
+	struct Queue
+	{
+		std::mutex lock;
+		std::deque<size_t> files;
+	};
+
+	// per thread, kept between files
+	struct Worker
+	{
+		std::map<double, std::unique_ptr<MorseDecoder>> decoders; // per sample rate
+		std::vector<int16_t> buffer;
+		double stage[STAGE_COUNT] = { 0.0 }; // seconds
+	};
+
+	double Tone;             // Hz, 0 = estimate per file
+	double Wpm;
+	bool Uppercase;
+	bool Matched;
+	int BeamWidth;
+	std::string Bigram;      // bigram training text
+	std::string OutDir;      // "" = results to the stream
+
+	std::vector<Result> results;
+	std::vector<std::string> outPaths;
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<uint8_t> done;
+	std::mutex doneLock;
+	std::condition_variable doneSignal;
+
+	size_t Threads = 0;
+	size_t failed = 0;
+	double audio = 0.0;      // seconds decoded
+	double wall = 0.0;       // seconds of Run
+	double stageSeconds[STAGE_COUNT] = { 0.0 };
+
+public:
+	/**
+	* Constructor, decoder settings as for one file
+	*
+	* @param tone - Hz, 0 = estimate per file
+	* @param wpm
+	* @param uppercase
+	* @param matched_filter
+	* @param beam_width
+	*/
+	MorseBatch(double tone, double wpm, bool uppercase, bool matched_filter = false, int beam_width = 0);
+	~MorseBatch() = default;
+
+	/**
+	* Train the bigram model of every decoder, needs beam_width > 0
+	*
+	* @param text
+	*/
+	void TrainBigram(const std::string& text);
+
+	/**
+	* Write each result to dir\stem.txt instead of the stream
+	*
+	* @param dir
+	*/
+	void SetOutDir(const std::string& dir);
+
+	/**
+	* Wav files of a directory and its subdirectories, sorted, or the
+	* paths in a list file, one per line
+	*
+	* @param path
+	* @return std::vector<std::string>
+	*/
+	static std::vector<std::string> ListFiles(const std::string& path);
+
+	/**
+	* Decode the files
+	*
+	* @param files
+	* @param threads - 0 = one per core
+	* @param out - results in file order, errors
+	*/
+	void Run(const std::vector<std::string>& files, size_t threads, std::ostream& out);
+
+	/**
+	* Write files/s, audio hours/s and the time spent per stage
+	*
+	* @param out
+	*/
+	void Report(std::ostream& out) const;
+
+private:
+	void Work(size_t id, Worker& worker);
+	bool Take(size_t id, size_t& file);
+	void Decode(Worker& worker, size_t file);
+	void Write(Worker& worker, size_t file);
+	void Print(std::ostream& out, Result& result) const;
+};
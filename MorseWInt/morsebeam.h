@@ -0,0 +1,124 @@
+#pragma once
+
+#include "morse.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+* C++ MorseBeam Class
+*
+* Beam search back end for key down / key up runs. Every hypothesis is
+* one labeling of the runs so far (dit / dah, element / character / word
+* gap) that spells valid Morse characters, with its own dit length. A run
+* extends every hypothesis by each label its character allows, scored by
+* the timing log likelihood (log normal around 1, 3 and 5 or more units,
+* as MorseWav sends them) plus an optional character bigram model; the
+* Width best are kept, one per (character so far, last character).
+* Hypotheses live in a fixed arena and carry their last characters in a
+* fixed buffer, the oldest is committed once the best hypothesis holds
+* half of it, so memory is bounded and there is no allocation per run.
+*/
+class MorseBeam
+{
+public:
+	static const int DEFAULT_WIDTH = 16;
+	static const int LAG = 32;              // uncommitted characters per hypothesis
+	static const int NODES = 512;           // Morse trie, node n has children 2n (dit) and 2n + 1 (dah)
+	static const uint16_t SPACE = 0;        // word space in the character buffer
+	static constexpr float SIGMA = 0.35f;   // timing spread, log units
+	static constexpr float ALPHA = 0.2f;    // dit length update weight
+	static constexpr float LM_WEIGHT = 0.2f;   // bigram against timing
+	static constexpr float UNKNOWN_COST = 10.0f; // a character the tables do not know
+
+private:
+	struct Hyp
+	{
+		float score;
+		float unit;                 // dit length
+		uint16_t node;              // trie node of the current character, 1 = none
+		uint16_t last;              // last character or SPACE, for the bigram model
+		uint16_t count;             // characters in chars
+		uint16_t chars[LAG];        // ring, starts at the beam wide base
+	};
+
+	Morse morse;
+	int Width;
+	std::vector<std::string> symbol;   // character of a trie node, empty if none
+	std::vector<uint8_t> prefix;       // node starts at least one character
+	std::vector<uint8_t> letter;       // node to bigram alphabet index
+	int letters = 0;                   // alphabet size, with space and unknown
+	std::vector<float> bigram;         // log P(next | last), empty = off
+
+	std::vector<Hyp> beam;             // Width
+	std::vector<Hyp> next;             // candidates, 4 * Width
+	int size = 0;                      // hypotheses in beam
+	int candidates = 0;                // hypotheses in next
+	int base = 0;                      // ring position of the oldest character
+
+	std::string MorseCode;
+	std::string Text;
+
+public:
+	/**
+	* Constructor
+	*
+	* @param unit - starting dit length, hypotheses start at several speeds around it
+	* @param uppercase - Morse table variant
+	* @param width - hypotheses kept
+	*/
+	MorseBeam(double unit, bool uppercase, int width = DEFAULT_WIDTH);
+	~MorseBeam() = default;
+
+	/**
+	* Train the character bigram model on sample text
+	*
+	* @param text
+	*/
+	void TrainBigram(const std::string& text);
+
+	/**
+	* Start over on new input, the tables and bigram model are kept
+	*
+	* @param unit - starting dit length
+	*/
+	void Reset(double unit);
+
+	/**
+	* Add a key down or key up run
+	*
+	* @param key
+	* @param length
+	*/
+	void Add(bool key, double length);
+
+	/**
+	* End of input, commit the best hypothesis
+	*/
+	void Flush();
+
+	/**
+	* Get committed morse code, like Morse::morse_encode
+	*/
+	const std::string& GetMorseCode() const;
+
+	/**
+	* Get committed text
+	*/
+	const std::string& GetText() const;
+
+	/**
+	* Get dit length of the best hypothesis
+	*/
+	double GetUnit() const;
+
+private:
+	void Extend(const Hyp& h, bool key, float length);
+	void Push(const Hyp& h, uint16_t node, float cost, float unitLength, uint16_t emit, bool space);
+	void Prune();
+	void Commit(int keep);
+	void Close(Hyp& h);
+	void Append(Hyp& h, uint16_t c);
+	void Emit(uint16_t c);
+	static float Cost(float length, float expected);
+};
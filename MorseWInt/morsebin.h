@@ -0,0 +1,125 @@
+#pragma once
+
+#include "morse.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+* C++ MorseBin Class
+*
+* Bit-packed binary morse container (.mbin).
+* Every symbol is a 4 bit length followed by its elements (0 = dit, 1 = dah),
+* a word space is a symbol of length 0. A sparse index holds the bit offset
+* of every INDEX_INTERVAL-th symbol, so a reader can seek to a character or
+* a word and decode from there without scanning the whole file.
+*
+* Layout, little endian:
+*   "MBIN" version(1) table(1) interval(2) symbols(4) words(4) entries(4) bits(8)
+*   entries x { symbol(4) word(4) bit(8) }
+*   payload, (bits + 7) / 8 bytes, MSB first
+*/
+class MorseBin
+{
+public:
+	static const uint8_t VERSION = 1;
+	static const uint16_t INDEX_INTERVAL = 256; // symbols per index entry
+	static const int LENGTH_BITS = 4;           // symbol length prefix
+
+private:
+	/**
+	* Index entry, position of symbol number "symbol"
+	*/
+	struct IndexEntry
+	{
+		uint32_t symbol; // symbol number
+		uint32_t word;   // word spaces before the symbol
+		uint64_t bit;    // bit offset in the payload
+	};
+
+	bool uppercase;                 // table variant, false = with lowercase a-z
+	uint16_t interval = INDEX_INTERVAL;
+	uint32_t symbols = 0;           // characters and word spaces
+	uint32_t words = 0;             // number of words
+	uint64_t bits = 0;              // payload length in bits
+	std::vector<IndexEntry> index;
+	std::vector<uint8_t> payload;
+
+public:
+	/**
+	* Constructor
+	*
+	* @param uppercase - table variant used for encoding
+	*/
+	MorseBin(bool uppercase);
+	~MorseBin() = default;
+
+	/**
+	* Encode text with the Morse tables
+	*
+	* @param text
+	*/
+	void Encode(const std::string& text);
+
+	/**
+	* Decode all symbols
+	*
+	* @return string
+	*/
+	std::string Decode();
+
+	/**
+	* Decode count characters (word spaces included) from character first
+	*
+	* @param first
+	* @param count
+	* @return string
+	*/
+	std::string DecodeChars(uint32_t first, uint32_t count);
+
+	/**
+	* Decode count words from word first
+	*
+	* @param first
+	* @param count
+	* @return string
+	*/
+	std::string DecodeWords(uint32_t first, uint32_t count);
+
+	/**
+	* Save container
+	*
+	* @param path
+	*/
+	void Save(const std::string& path);
+
+	/**
+	* Load container, the table variant comes from the header
+	*
+	* @param path
+	*/
+	void Load(const std::string& path);
+
+	/**
+	* Get serialized container
+	*/
+	std::vector<uint8_t> GetBytes() const;
+
+	/**
+	* Read serialized container
+	*
+	* @param data
+	* @param size
+	*/
+	void SetBytes(const uint8_t* data, size_t size);
+
+	uint32_t GetSymbolCount() const;
+	uint32_t GetWordCount() const;
+	bool IsUppercase() const;
+
+private:
+	void PutBits(uint32_t value, int n);
+	uint32_t GetBits(uint64_t& bit, int n) const;
+	std::string ReadSymbol(uint64_t& bit) const;
+	std::string DecodeRange(uint64_t bit, uint32_t count, bool stopAtWords);
+};
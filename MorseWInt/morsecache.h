@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <mutex>
+#include <filesystem>
+
+/**
+* C++ MorseCache Class
+*
+* On-disk cache of rendered files, addressed by a hash of everything that
+* changes the output (morse code, tone, wpm, sps, channels and format).
+* A hit copies the cached file, so nothing is rendered.
+* The least recently used entries are removed when the cache gets too big.
+*/
+class MorseCache
+{
+private:
+	std::filesystem::path Dir; // cache directory
+	uintmax_t MaxBytes;        // size limit of all cached files
+	uint64_t hits = 0;         // lookups served from cache (persistent)
+	uint64_t misses = 0;       // lookups that had to render (persistent)
+	uint64_t evictions = 0;    // files removed to stay under MaxBytes (persistent)
+	std::mutex lock;
+
+public:
+	/**
+	* Constructor
+	*
+	* @param dir
+	* @param max_bytes
+	*/
+	MorseCache(const std::string& dir, uintmax_t max_bytes);
+	~MorseCache() = default;
+
+	/**
+	* Build the cache key for a render
+	*
+	* @param morsecode
+	* @param tone
+	* @param wpm
+	* @param sps
+	* @param channels
+	* @param format - output format and oscillator options
+	*/
+	static std::string Key(const std::string& morsecode, double tone, double wpm, double sps, int channels, const std::string& format);
+
+	/**
+	* Put a cached copy of key at dest, returns false on a miss
+	*
+	* @param key
+	* @param dest
+	*/
+	bool Fetch(const std::string& key, const std::string& dest);
+
+	/**
+	* Add a rendered file to the cache and evict old entries
+	*
+	* @param key
+	* @param src
+	*/
+	void Store(const std::string& key, const std::string& src);
+
+	/**
+	* Get statistics line: hits, misses, evictions, size
+	*/
+	std::string GetStats();
+
+	uint64_t GetHits();
+	uint64_t GetMisses();
+
+private:
+	std::filesystem::path EntryPath(const std::string& key, const std::string& ext);
+	static bool Copy(const std::filesystem::path& from, const std::filesystem::path& to);
+	void Evict();
+	void LoadStats();
+	void SaveStats();
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+enum CharLogFormat
+{
+	CHARLOG_BINARY = 0, // varint records, .mchr
+	CHARLOG_JSONL = 1   // one JSON object per line
+};
+
+/**
+* One decoded character: where its marks start and end in the input, in
+* samples at the wav rate, and how clear its timing was, 0 to 1
+*/
+struct CharRecord
+{
+	std::string text;
+	uint64_t start;
+	uint64_t end;
+	float confidence;
+	bool space;         // a word gap follows
+};
+
+/**
+* C++ MorseCharLog Class
+*
+* Writes the character records of MorseDecoder as they come.
+*
+* Binary layout (.mchr), numbers are LEB128 varints after the header:
+*   "MCHR" version(1) rate
+*   then per record: start_delta duration confidence(1) length text
+* start_delta is from the start of the previous record, confidence is
+* 0 to 255, length is the text bytes times 2 plus 1 if a word gap follows.
+*
+* JSON lines (.jsonl):
+*   {"char":"A","start":1200,"end":4800,"confidence":0.87,"space":false}
+*/
+class MorseCharLog
+{
+public:
+	static const uint8_t VERSION = 1;
+	static const size_t BUFFER_SIZE = 1 << 16; // bytes written per fwrite
+
+private:
+	FILE* Out = nullptr;
+	int Format;
+	std::vector<char> buffer;
+	size_t used = 0;         // bytes pending in buffer
+	uint64_t last = 0;       // start of the previous record
+
+public:
+	/**
+	* Constructor, creates the file and writes the header
+	*
+	* @param path
+	* @param format
+	* @param samples_per_second
+	*/
+	MorseCharLog(const std::string& path, int format, double samples_per_second);
+	~MorseCharLog();
+	MorseCharLog(const MorseCharLog&) = delete;
+	MorseCharLog& operator=(const MorseCharLog&) = delete;
+
+	/**
+	* Append one record
+	*
+	* @param record
+	*/
+	void Add(const CharRecord& record);
+
+	/**
+	* Write what is pending and close the file
+	*/
+	void Close();
+
+	/**
+	* Get file extension for a format
+	*
+	* @param format
+	*/
+	static const char* GetExtension(int format);
+
+private:
+	void Put(const char* s, size_t n);
+	void Flush();
+};
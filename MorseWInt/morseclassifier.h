@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum RunClass
+{
+	RUN_DIT = 0,
+	RUN_DAH = 1,
+	RUN_ELEMENT_GAP = 2, // gap inside a character
+	RUN_CHAR_GAP = 3,    // gap between characters
+	RUN_WORD_GAP = 4     // gap between words
+};
+
+/**
+* C++ MorseClassifier Class
+*
+* Online dit / dah and gap classifier for variable speed code.
+* One dit length estimate is followed with an exponentially weighted
+* update by every run, scaled by its class (dah 3, character gap 3).
+* Gaps split at 2 and 4 units (MorseWav sends 1, 3 and 5). The marks of
+* a character are classified when it ends: a character with dits and
+* dahs splits at the geometric middle of its own shortest and longest
+* mark, so it needs no speed at all, and a character of one kind is
+* compared with the dit estimate. A character far off the estimate
+* restarts it at the new speed.
+* The first runs are held back and the starting speed is found by
+* splitting their marks in two groups (2-means on the log length).
+* Every character carries where its marks start and end and a
+* confidence: how far its least certain run is from a class boundary,
+* against how far an ideal run would be.
+* O(1) per run and constant memory; lengths in any unit (samples, blocks).
+*/
+class MorseClassifier
+{
+public:
+	static constexpr double ALPHA = 0.25; // dit estimate update weight
+	static const int WARMUP_MARKS = 8;    // marks held back to find the starting speed
+	static const int WARMUP_RUNS = 32;
+	static const int MAX_ELEMENTS = 16;   // longer characters are cut
+
+	/**
+	* Completed character
+	*/
+	struct Symbol
+	{
+		std::string elements; // . and -
+		int gap;              // RUN_CHAR_GAP or RUN_WORD_GAP after it
+		double start;         // first mark, in run lengths from the first run
+		double end;           // end of the last mark
+		double confidence;    // 0 to 1, smallest timing margin of its runs
+	};
+
+private:
+	struct Run
+	{
+		bool key;
+		double length;
+		double start;
+	};
+
+	double unit;                   // dit length estimate
+	double position = 0.0;         // total length of the runs added
+	double charStart = 0.0;        // first mark of the current character
+	double charEnd = 0.0;          // end of its last mark
+	double gapMargin = 1.0;        // smallest element gap margin in it
+	bool locked = false;           // starting speed found
+	Run warmup[WARMUP_RUNS];
+	int warmupRuns = 0;
+	int warmupMarks = 0;
+	double marks[MAX_ELEMENTS];    // marks of the current character
+	int count = 0;
+	std::vector<Symbol> ready;     // at most one warmup worth of characters
+	size_t readyAt = 0;            // next one to take
+	bool lastKey = false;          // key state of the last run
+
+public:
+	/**
+	* Constructor
+	*
+	* @param unit - dit length used when the first runs do not tell
+	*/
+	MorseClassifier(double unit);
+	~MorseClassifier() = default;
+
+	/**
+	* Add a key down or key up run. A key up run right after another
+	* continues that gap, which has been classified already
+	*
+	* @param key
+	* @param length
+	*/
+	void Add(bool key, double length);
+
+	/**
+	* End of input, complete the last character
+	*/
+	void Flush();
+
+	/**
+	* Get next completed character
+	*
+	* @param elements - . and -
+	* @param gap - RUN_CHAR_GAP or RUN_WORD_GAP
+	* @return bool - false if none is ready
+	*/
+	bool Next(std::string& elements, int& gap);
+
+	/**
+	* Get next completed character with its position and confidence
+	*
+	* @param symbol
+	* @return bool - false if none is ready
+	*/
+	bool Next(Symbol& symbol);
+
+	/**
+	* Get current dit length estimate
+	*/
+	double GetUnit() const;
+
+	/**
+	* Is the starting speed found, GetUnit is the hint before
+	*/
+	bool IsLocked() const;
+
+private:
+	void Lock();
+	void Online(bool key, double length, double start);
+	void EndCharacter(int gap, double margin);
+	void Update(double unitLength);
+	static double Margin(double ratio, double ideal);
+};
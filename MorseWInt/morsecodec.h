@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+* C++ MorseCodec Class
+*
+* Compact wav codecs for MorseWav:
+* G.711 mu-law and A-law (8 bit) from 16 bit lookup tables,
+* IMA ADPCM (4 bit) in standard wav blocks with a 4 byte header per channel.
+*/
+class MorseCodec
+{
+public:
+	// wav format tags (mmreg.h)
+	static const uint16_t TAG_ALAW = 0x0006;
+	static const uint16_t TAG_MULAW = 0x0007;
+	static const uint16_t TAG_IMA_ADPCM = 0x0011;
+
+private:
+	int NumChannels;  // 1 = mono, 2 = stereo
+	int pred[2];      // ADPCM predictor per channel
+	int index[2];     // ADPCM step index per channel
+
+public:
+	/**
+	* Constructor, ADPCM state
+	*
+	* @param channels
+	*/
+	MorseCodec(int channels);
+	~MorseCodec() = default;
+
+	/**
+	* G.711 mu-law, n samples
+	*
+	* @param in
+	* @param out
+	* @param n
+	*/
+	static void MuLaw(const int16_t* in, uint8_t* out, size_t n);
+
+	/**
+	* G.711 A-law, n samples
+	*
+	* @param in
+	* @param out
+	* @param n
+	*/
+	static void ALaw(const int16_t* in, uint8_t* out, size_t n);
+
+	/**
+	* ADPCM block size in bytes, the usual 256 / 512 / 1024 per channel by rate
+	*
+	* @param channels
+	* @param sps
+	*/
+	static size_t ImaBlockAlign(int channels, double sps);
+
+	/**
+	* ADPCM samples per channel in one block
+	*
+	* @param block_align
+	* @param channels
+	*/
+	static size_t ImaSamplesPerBlock(size_t block_align, int channels);
+
+	/**
+	* Encode one ADPCM block, a short last block is padded with silence
+	*
+	* @param in - interleaved frames
+	* @param frames - at most ImaSamplesPerBlock
+	* @param out - block_align bytes
+	* @param block_align
+	*/
+	void ImaBlock(const int16_t* in, size_t frames, uint8_t* out, size_t block_align);
+
+private:
+	uint8_t ImaNibble(int channel, int sample);
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+/**
+* C++ MorseDecimator Class
+*
+* Mixes audio down to complex baseband around the tone and cuts the
+* sample rate to about OUT_RATE, where a CW signal still fits easily.
+* The first stage is a polyphase FIR that decimates by R: a triangle
+* (a second order CIC) of 2R - 1 taps, shifted to the tone. It is built
+* from two sums per block of R samples, so mixing and filtering are four
+* short dot products over contiguous samples against fixed tables, and a
+* phasor per block restores the tone phase. The second stage is a
+* Blackman windowed half-band FIR that decimates by 2 and removes what
+* the triangle lets through near half its output rate.
+*/
+class MorseDecimator
+{
+public:
+	static constexpr double OUT_RATE = 1500.0;  // about, between 1 and 2 kHz
+	static const int HALF_BAND_TAPS = 31;       // 4k + 3
+
+private:
+	double Tone;
+	double Sps;
+	size_t R;                  // first stage factor
+	std::vector<float> mixI, mixQ;        // conjugated tone over one block
+	std::vector<float> rampI, rampQ;      // the same times the position in the block
+	std::vector<float> input;  // samples not yet in a block
+	std::complex<double> phasor = 1.0;    // tone phase at the block start, conjugated
+	std::complex<double> rotate;          // phasor step per block
+	std::complex<double> lastA = 0.0, lastB = 0.0;  // sums of the previous block
+
+	std::vector<float> halfBand;          // odd taps 1, 3, ... from the middle
+	float center;                         // middle tap
+	std::vector<float> midI, midQ;        // first stage outputs, newest last
+	bool odd = false;                     // half band output on the next one
+
+public:
+	/**
+	* Constructor
+	*
+	* @param tone - Hz, moved to 0 Hz
+	* @param samples_per_second
+	*/
+	MorseDecimator(double tone, double samples_per_second);
+	~MorseDecimator() = default;
+
+	/**
+	* Feed mono samples, baseband samples are appended
+	*
+	* @param mono
+	* @param n
+	* @param out
+	*/
+	void Process(const int16_t* mono, size_t n, std::vector<std::complex<float>>& out);
+
+	/**
+	* Size the buffers for Process calls of up to frames samples
+	*
+	* @param frames
+	*/
+	void Reserve(size_t frames);
+
+	/**
+	* Push silence through both stages to get the last samples out
+	*
+	* @param out
+	*/
+	void Flush(std::vector<std::complex<float>>& out);
+
+	/**
+	* Get output samples per second
+	*/
+	double GetRate() const;
+
+	/**
+	* Get input samples per output sample
+	*/
+	size_t GetFactor() const;
+
+	/**
+	* Get group delay of both stages, input samples
+	*/
+	double GetDelay() const;
+
+private:
+	void Stage1(std::vector<std::complex<float>>& out);
+	void Stage2(float i, float q, std::vector<std::complex<float>>& out);
+};
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "morse.h"
+#include "morsewavreader.h"
+#include "morseclassifier.h"
+#include "morsematchedfilter.h"
+#include "morsedecimator.h"
+#include "morsebeam.h"
+#include "morsecharlog.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+* C++ MorseDecoder Class
+*
+* Audio to text. A streaming Goertzel filter measures the tone level in
+* blocks of a quarter morse unit at the fastest speed, the level is
+* thresholded into key down / key up runs and MorseClassifier sorts the
+* runs into dits, dahs and gaps while following the speed (MorseWav sends
+* dit 1, dah 3, element gap 1, character gap 3, word gap 5).
+* The resulting morse code is turned into text with the Morse tables.
+* For weak signals the Goertzel blocks can be replaced by a matched
+* filter (MorseMatchedFilter, correlation with a dit long tone at the
+* given speed), sampled at the same block rate. At high sample rates the
+* audio is first mixed down to complex baseband around the tone at about
+* 1.5 kHz (MorseDecimator), where a block is a plain sum of samples and
+* the matched filter a running sum over one dit. The runs can go to a
+* beam search over their labeling (MorseBeam) instead of the classifier,
+* which keeps several readings until the timing settles.
+* With the classifier, every character can also come out as a record of
+* where it starts and ends in the input and how clear its timing was.
+* Once the speed is known, a key up of WORD_FLUSH_UNITS is passed on as a
+* word gap before it ends, so the last character of a word is out that
+* long after its last mark.
+*/
+class MorseDecoder
+{
+public:
+	static const int BLOCKS_PER_UNIT = 4;  // Goertzel blocks per morse unit at MAX_WPM
+	static constexpr double MAX_WPM = 50.0; // fastest speed, as MorseWav allows
+	static const size_t READ_FRAMES = 8192;
+	static constexpr double MIN_TONE = 20.0;   // tone search range, as MorseWav allows
+	static constexpr double MAX_TONE = 8000.0;
+	static constexpr double DECIMATE_SPS = 32000.0;        // decimate from this rate for Goertzel blocks
+	static constexpr double DECIMATE_SPS_MATCHED = 6000.0; // and for the matched filter
+	static constexpr double WORD_FLUSH_UNITS = 5.0;  // key up this long is passed on as a word gap
+
+private:
+	Morse morse;
+	double Tone;            // detector frequency
+	double Sps;             // samples per second
+	double Rate;            // detector samples per second, Sps or after decimation
+	double Wpm;             // expected speed, the classifier starts here
+	size_t BlockSize;       // detector samples per block
+	MorseClassifier classifier;
+
+	// Goertzel state
+	double coeff;
+	double s1 = 0.0, s2 = 0.0;
+	size_t inBlock = 0;
+
+	// matched filter front end, instead of Goertzel when set
+	std::unique_ptr<MorseMatchedFilter> matched;
+	std::vector<double> levels;
+
+	// decimating front end, the detector runs on baseband when set
+	std::unique_ptr<MorseDecimator> decimator;
+	std::vector<std::complex<float>> baseband;
+	std::complex<double> blockSum = 0.0;
+	std::vector<std::complex<float>> dit;   // last dit of baseband, matched filter
+	std::complex<double> ditSum = 0.0;
+	size_t ditAt = 0;
+
+	// beam search back end, instead of the classifier when set
+	std::unique_ptr<MorseBeam> beam;
+
+	// envelope and keying state
+	double peak = 0.0;      // decaying peak level
+	double floor = 0.0;     // rising noise floor
+	double peakDecay;       // per block
+	bool key = false;
+	uint64_t runBlocks = 0; // length of the current run
+	uint64_t runSent = 0;   // blocks of it passed on early
+	double flushBlocks = 0.0; // WORD_FLUSH_UNITS at the current speed
+
+	// character records, classifier only
+	bool Records = false;
+	bool KeepText = true;   // collect MorseCode and Text
+	double BlockSamples;    // input samples per block
+	double Delay;           // input samples the detector lags
+	std::vector<CharRecord> records;
+	size_t recordAt = 0;    // next one to take
+	std::unordered_map<std::string, std::string> symbols; // elements to text, up to 8 elements
+
+	std::string MorseCode;  // . - and spaces, like Morse::morse_encode
+	std::string Text;
+	std::string word;       // characters of the current word, space separated
+
+public:
+	/**
+	* Constructor
+	*
+	* @param tone - Hz
+	* @param samples_per_second
+	* @param wpm - starting words per minute, <= 0 uses 20
+	* @param uppercase - Morse table variant
+	* @param matched_filter - correlate with a dit at wpm instead of Goertzel blocks
+	* @param beam_width - hypotheses of the beam search back end, 0 = classifier
+	*/
+	MorseDecoder(double tone, double samples_per_second, double wpm, bool uppercase, bool matched_filter = false, int beam_width = 0);
+	~MorseDecoder() = default;
+
+	/**
+	* Train the character bigram model of the beam search back end
+	*
+	* @param text
+	*/
+	void TrainBigram(const std::string& text);
+
+	/**
+	* Start over on a new recording at the same sample rate. The Morse
+	* tables, beam search tables and bigram model are kept, the front end
+	* is tuned to the new tone
+	*
+	* @param tone - Hz
+	*/
+	void Reset(double tone);
+
+	/**
+	* Keep a record of every decoded character, see NextRecord. Every
+	* character of up to 8 elements is decoded once here, so taking
+	* records allocates nothing
+	*
+	* @param keep
+	*/
+	void KeepRecords(bool keep);
+
+	/**
+	* Collect the morse code and text, on by default. Streaming readers of
+	* the records turn it off so memory stays constant
+	*
+	* @param keep
+	*/
+	void KeepTextOutput(bool keep);
+
+	/**
+	* Get next character record, they are ready a character gap after the
+	* character ends
+	*
+	* @param record
+	* @return bool - false if none is ready
+	*/
+	bool NextRecord(CharRecord& record);
+
+	/**
+	* Size the buffers for Process calls of up to frames samples, so that
+	* streaming allocates nothing
+	*
+	* @param frames
+	*/
+	void Reserve(size_t frames);
+
+	/**
+	* Feed mono samples
+	*
+	* @param mono
+	* @param n
+	*/
+	void Process(const int16_t* mono, size_t n);
+
+	/**
+	* Flush the last run, character and word
+	*/
+	void Finish();
+
+	/**
+	* Decode a whole wav file
+	*
+	* @param reader
+	*/
+	void Decode(MorseWavReader& reader);
+
+	/**
+	* Decode a whole wav file, character records go to the log as they
+	* are ready
+	*
+	* @param reader
+	* @param log
+	*/
+	void Decode(MorseWavReader& reader, MorseCharLog& log);
+
+	/**
+	* Estimate the dominant tone from the first seconds of a wav, the reader
+	* is rewound afterwards
+	*
+	* @param reader
+	* @param seconds
+	* @return double - Hz, 0 if no tone was found
+	*/
+	static double EstimateTone(MorseWavReader& reader, double seconds = 10.0);
+
+	/**
+	* Estimate the dominant tone: Hann windowed power spectrum averaged
+	* over frames of about 0.1 s, peak refined by interpolation of the
+	* log power of the neighbouring bins
+	*
+	* @param mono
+	* @param n
+	* @param samples_per_second
+	* @return double - Hz, 0 if no tone was found
+	*/
+	static double EstimateTone(const int16_t* mono, size_t n, double samples_per_second);
+
+	/**
+	* Get decoded morse code
+	*/
+	const std::string& GetMorseCode() const;
+
+	/**
+	* Get decoded text
+	*/
+	const std::string& GetText() const;
+
+	/**
+	* Get current speed estimate
+	*/
+	double GetWpm() const;
+
+private:
+	void Baseband(std::complex<float> z);
+	void Block(double level);
+	void Run(bool down, uint64_t blocks);
+	void Drain();
+	void Record(const MorseClassifier::Symbol& symbol);
+	void EndWord();
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+/**
+* C++ MorseFft Class
+*
+* Radix-2 FFT without external libraries. A real transform of N samples
+* runs as one complex transform of N / 2 points plus a split step.
+* Twiddles and the bit reversal order are computed once per size.
+*/
+class MorseFft
+{
+private:
+	size_t N;                                  // real transform size, power of two
+	size_t M;                                  // complex transform size, N / 2
+	std::vector<size_t> rev;                   // bit reversal permutation of M
+	std::vector<std::complex<double>> twiddle; // exp(-2 pi i j / M), j < M / 2
+	std::vector<std::complex<double>> split;   // exp(-2 pi i k / N), k <= M
+	std::vector<std::complex<double>> work;
+
+public:
+	/**
+	* Constructor
+	*
+	* @param n - real transform size, a power of two >= 4
+	*/
+	MorseFft(size_t n);
+	~MorseFft() = default;
+
+	/**
+	* Real forward transform
+	*
+	* @param in - N samples
+	* @param out - N / 2 + 1 bins
+	*/
+	void Real(const double* in, std::complex<double>* out);
+
+	/**
+	* In place complex transform of N / 2 points
+	*
+	* @param data
+	* @param inverse - unscaled inverse
+	*/
+	void Complex(std::complex<double>* data, bool inverse);
+
+	/**
+	* Get real transform size
+	*/
+	size_t GetSize() const;
+
+	/**
+	* Hann window
+	*
+	* @param w
+	* @param n
+	*/
+	static void Hann(double* w, size_t n);
+
+	/**
+	* Smallest power of two >= n
+	*
+	* @param n
+	*/
+	static size_t Pow2(size_t n);
+};
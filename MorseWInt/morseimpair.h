@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "morserandom.h"
+#include "morsetiming.h"
+
+/**
+* Fading models
+*/
+enum FadingModel
+{
+	FADING_NONE = 0,     // steady carrier
+	FADING_RAYLEIGH = 1, // scattered paths only
+	FADING_RICIAN = 2    // direct path plus scattered paths
+};
+
+/**
+* Channel impairment settings, all off by default
+*/
+struct Impairment
+{
+	bool noise = false;      // add white gaussian noise at snr
+	double snr = 10.0;       // dB, key down tone power over noise power in the whole band
+	int fading = FADING_NONE;
+	double doppler = 0.5;    // Hz, fading bandwidth
+	double kfactor = 4.0;    // Rician direct over scattered power
+	double qsbDepth = 0.0;   // dB, slow fading from 0 down to -depth and back
+	double qsbPeriod = 10.0; // seconds
+	double drift = 0.0;      // Hz per minute
+	double jitter = 0.0;     // run length standard deviation, part of a unit
+	uint64_t seed = 1;
+
+	/**
+	* Is any impairment set
+	*/
+	bool IsActive() const;
+
+	/**
+	* Get the settings as text, for cache keys and reports
+	*/
+	std::string GetName() const;
+};
+
+/**
+* C++ MorseImpair Class
+*
+* Channel impairment simulator for synthetic test audio, used by
+* MorseRender in place of the clean oscillator. Run lengths get timing
+* jitter up front, so the length of the file is known. The tone comes
+* from a running oscillator whose frequency drifts; its complex gain
+* (Rayleigh or Rician fading and QSB) is set at gain points up to
+* GAIN_FRAMES apart and is linear in between. Key down samples are made
+* eight at a time by a rotating phasor kept as structure of arrays, then
+* white gaussian noise is added to every sample and the block is
+* saturated to 16 bit. With noise and jitter only the tone is the clean
+* one, the renderer keys its tone table and the noise goes on the 16 bit
+* samples. The noise is a 16 bit table of NOISE_TABLE normals made once,
+* read in runs of NOISE_RUN frames from an offset hashed from the run, so
+* adding it is one saturating add per sample and it only depends on the
+* frame.
+* All random numbers come from MorseRandom streams of the seed, so the
+* same settings always give the same file.
+*/
+class MorseImpair
+{
+public:
+	static const size_t GAIN_FRAMES = 256; // longest fading and QSB gain step
+	static const size_t BLOCK_FRAMES = 4096; // frames per float block
+	static const int PHASOR_LANES = 8;
+	static const size_t NOISE_TABLE = 65536; // normals in the noise table
+	static const size_t NOISE_RUN = 64;      // frames read from one table offset
+
+private:
+	Impairment Settings;
+	double Sps;
+	double Tone;
+	double Amp;                    // key down peak, int16 units
+	double Sigma;                  // noise standard deviation, int16 units
+	std::vector<uint64_t> lengths; // run lengths in frames, jittered
+	uint64_t frames = 0;           // sum of lengths
+
+	MorseRandom fadeRandom;        // fading process
+	uint64_t noiseKey;             // hashed with the run for its table offset
+	size_t gainFrames;             // frames per gain step
+	double fadePole;               // one pole lowpass per gain step
+	double fadeNorm;               // makes up for the power lost between gain points
+	double fadeI = 0.0, fadeQ = 0.0; // scattered path state
+	uint64_t gainStep = 0;         // gain point in gainI / gainQ [1]
+	double gainI[2], gainQ[2];     // complex gain at gainStep - 1 and gainStep
+
+	std::vector<float> block;      // float samples of one block
+	std::vector<int16_t> noise;    // noise table, normals times sigma in 16 bit
+
+public:
+	/**
+	* Constructor
+	*
+	* @param settings
+	* @param timing
+	* @param tone
+	* @param wpm
+	* @param samples_per_second
+	* @param amplitude - 0.0 to 1.0
+	*/
+	MorseImpair(const Impairment& settings, const MorseTiming& timing, double tone, double wpm, double samples_per_second, double amplitude);
+	~MorseImpair() = default;
+
+	/**
+	* Get the length of a run in frames
+	*
+	* @param run
+	*/
+	uint64_t GetLength(size_t run) const;
+
+	/**
+	* Get the length of the file in frames
+	*/
+	uint64_t GetFrameCount() const;
+
+	/**
+	* Get the float block the renderer fills
+	*/
+	float* GetBlock();
+
+	/**
+	* Write n key down samples from frame position on
+	*
+	* @param out
+	* @param position
+	* @param n
+	*/
+	void Key(float* out, uint64_t position, size_t n);
+
+	/**
+	* Add noise to n samples of the block from frame position on and write
+	* them as 16 bit
+	*
+	* @param out
+	* @param position
+	* @param n
+	* @param channels
+	*/
+	void Finish(int16_t* out, uint64_t position, size_t n, int channels);
+
+	/**
+	* Add noise to n clean 16 bit frames from frame position on
+	*
+	* @param out
+	* @param position
+	* @param n
+	* @param channels
+	*/
+	void AddNoise(int16_t* out, uint64_t position, size_t n, int channels);
+
+	/**
+	* Is the key down tone the clean one: no fading, QSB or drift
+	*/
+	bool CleanTone() const;
+
+	/**
+	* Start again at the first frame with the same random numbers
+	*/
+	void Rewind();
+
+private:
+	/**
+	* Move the gain points on to step
+	*
+	* @param step
+	*/
+	void MoveGain(uint64_t step);
+
+	/**
+	* Move the fading process one gain point on
+	*/
+	void Fade();
+
+	/**
+	* Complex gain at a gain point
+	*
+	* @param step
+	* @param i
+	* @param q
+	*/
+	void Gain(uint64_t step, double& i, double& q);
+
+	/**
+	* Noise of a run of NOISE_RUN frames
+	*
+	* @param run - frame / NOISE_RUN
+	*/
+	const int16_t* NoiseRun(uint64_t run) const;
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "morsetiming.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+enum KeyingFormat
+{
+	KEYING_BINARY = 0, // varint durations, .mkey
+	KEYING_CSV = 1,    // key,start,duration lines
+	KEYING_JSON = 2    // one object with an events array
+};
+
+enum KeyingUnit
+{
+	KEYING_SAMPLES = 0,     // durations in samples at the wav rate
+	KEYING_MICROSECONDS = 1 // durations in microseconds
+};
+
+/**
+* C++ MorseKeying Class
+*
+* Key down / key up schedule of a MorseTiming, without audio.
+* Durations are taken from the same sample grid as MorseWav, microseconds
+* are rounded from sample positions so they never drift from the wav.
+*
+* Binary layout (.mkey), all numbers LEB128 varints after the header:
+*   "MKEY" version(1) unit(1) first_key(1) rate count duration...
+* rate is the sample rate or 1000000, durations alternate key state
+* starting with first_key.
+*/
+class MorseKeying
+{
+public:
+	static const uint8_t VERSION = 1;
+	static const size_t BUFFER_SIZE = 1 << 16; // bytes written per fwrite
+
+private:
+	const MorseTiming& Timing;
+	size_t UnitSamples;      // samples per morse unit
+	uint32_t Sps;            // samples per second
+	int Unit;                // KEYING_SAMPLES or KEYING_MICROSECONDS
+	std::vector<char> buffer;
+	size_t used = 0;         // bytes pending in buffer
+	FILE* Out = nullptr;
+
+public:
+	/**
+	* Constructor
+	*
+	* @param timing
+	* @param wpm
+	* @param samples_per_second
+	* @param unit
+	*/
+	MorseKeying(const MorseTiming& timing, double wpm, double samples_per_second, int unit);
+	~MorseKeying() = default;
+
+	/**
+	* Write the schedule
+	*
+	* @param out - binary mode
+	* @param format
+	*/
+	void Write(FILE* out, int format);
+
+	/**
+	* Write the schedule to a file
+	*
+	* @param path
+	* @param format
+	*/
+	void Save(const std::string& path, int format);
+
+	/**
+	* Get number of key events (runs)
+	*/
+	size_t GetEventCount() const;
+
+	/**
+	* Get file extension for a format
+	*
+	* @param format
+	*/
+	static const char* GetExtension(int format);
+
+	/**
+	* Encode an unsigned LEB128 varint, at most 10 bytes
+	*
+	* @param value
+	* @param p
+	* @return size_t - bytes written
+	*/
+	static size_t PutVarint(uint64_t value, uint8_t* p);
+
+	/**
+	* Decode an unsigned LEB128 varint, advances p
+	*
+	* @param p
+	* @param end
+	* @return uint64_t
+	*/
+	static uint64_t GetVarint(const uint8_t*& p, const uint8_t* end);
+
+private:
+	uint64_t ToUnit(uint64_t samples) const;
+	void WriteBinary();
+	void WriteText(bool json);
+	void Put(const char* s, size_t n);
+	void PutNumber(uint64_t value);
+	void Flush();
+};
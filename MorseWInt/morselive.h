@@ -0,0 +1,92 @@
+#pragma once
+
+#include "morsedecoder.h"
+#include "morsering.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+* C++ MorseLive Class
+*
+* Streaming decoder for audio as it arrives. The input thread pushes
+* mono samples into a lock-free ring, a decode thread takes them in
+* blocks of BLOCK_FRAMES and passes the characters to a second ring, the
+* reader takes them from there. The decoder gives every character a
+* word gap of MorseDecoder::WORD_FLUSH_UNITS at the latest after its last
+* mark, plus up to one block and the detector delay, so the latency is
+* bounded even when the sending stops, except for the first characters,
+* which wait until the classifier knows the speed. Nothing is allocated
+* between the constructor and End: the rings and buffers are made up
+* front, the decoder keeps no text and reuses its queues.
+*/
+class MorseLive
+{
+public:
+	static const size_t RING_FRAMES = 1 << 16;  // input ring, 1.4 s at 48 kHz
+	static const size_t CHAR_SLOTS = 1024;      // output ring
+	static const size_t BLOCK_FRAMES = 128;     // decoded at a time
+	static const int IDLE_MICROSECONDS = 500;   // decode thread sleep on an empty ring
+
+private:
+	MorseDecoder decoder;
+	MorseRing<int16_t> input;
+	MorseRing<CharRecord> output;
+	std::vector<int16_t> block;
+	std::atomic<bool> ending{ false };   // no more input
+	std::atomic<bool> done{ false };     // all input decoded
+	std::atomic<uint64_t> dropped{ 0 };  // characters the reader did not take in time
+	std::thread worker;
+
+public:
+	/**
+	* Constructor, starts the decode thread
+	*
+	* @param tone - Hz
+	* @param samples_per_second
+	* @param wpm - starting speed
+	* @param uppercase - Morse table variant
+	* @param matched_filter
+	*/
+	MorseLive(double tone, double samples_per_second, double wpm, bool uppercase, bool matched_filter = false);
+	~MorseLive();
+	MorseLive(const MorseLive&) = delete;
+	MorseLive& operator=(const MorseLive&) = delete;
+
+	/**
+	* Input thread: add mono samples, never blocks
+	*
+	* @param mono
+	* @param n
+	* @return size_t - samples taken, fewer when the ring is full
+	*/
+	size_t Push(const int16_t* mono, size_t n);
+
+	/**
+	* Input thread: end of input, the last characters follow
+	*/
+	void End();
+
+	/**
+	* Reader: get the next character
+	*
+	* @param record
+	* @return bool - false if none is ready
+	*/
+	bool Next(CharRecord& record);
+
+	/**
+	* All input is decoded and every character is in the output ring
+	*/
+	bool IsDone() const;
+
+	/**
+	* Characters lost to a full output ring
+	*/
+	uint64_t GetDropped() const;
+
+private:
+	void Work();
+	void Emit();
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "morsefft.h"
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+/**
+* C++ MorseMatchedFilter Class
+*
+* Correlates audio with a dit long tone, the filter that is matched to
+* one morse unit in white noise. The correlation runs as overlap-save FFT
+* convolution: blocks of L samples overlap by the template length minus
+* one, a real FFT of the block is multiplied with the template spectrum
+* and transformed back, the last L - M + 1 outputs are valid. The output
+* magnitude is the tone level over the last dit, sampled every Step
+* samples. About 4 log2(L) operations per sample for any template length.
+*/
+class MorseMatchedFilter
+{
+private:
+	size_t M;        // template length, samples of one dit
+	size_t L;        // FFT size
+	size_t Step;     // samples per output level
+	MorseFft forward;   // real transform of L samples
+	MorseFft inverse;   // complex transform of L points
+	std::vector<std::complex<double>> kernel;   // template spectrum
+	std::vector<std::complex<double>> spectrum;
+	std::vector<double> block;  // M - 1 old samples, then new ones
+	size_t filled;              // samples in block
+	size_t phase = 0;           // outputs until the next level
+
+public:
+	/**
+	* Constructor
+	*
+	* @param tone - Hz
+	* @param samples_per_second
+	* @param length - template length in samples, one dit
+	* @param step - samples per output level
+	*/
+	MorseMatchedFilter(double tone, double samples_per_second, size_t length, size_t step);
+	~MorseMatchedFilter() = default;
+
+	/**
+	* Feed mono samples, a level is appended every Step samples
+	*
+	* @param mono
+	* @param n
+	* @param levels
+	*/
+	void Process(const int16_t* mono, size_t n, std::vector<double>& levels);
+
+	/**
+	* Filter the samples still in the block and the tail of the last dit
+	*
+	* @param levels
+	*/
+	void Flush(std::vector<double>& levels);
+
+	/**
+	* Get template length in samples
+	*/
+	size_t GetLength() const;
+
+	/**
+	* Get FFT size
+	*/
+	size_t GetSize() const;
+
+private:
+	void Filter(size_t valid, std::vector<double>& levels);
+};
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+#include "morse.h"
+#include "morsetiming.h"
+
+/**
+* C++ MorseMixer Class
+*
+* Renders many messages at once into one mono signal, each on its own
+* tone, speed, amplitude, phase and start time, for testing skimmers.
+* Every message keeps its own keying timeline; the tones are summed in a
+* float block. Per block and message the oscillator phase is set once,
+* then each key down sample is one multiply add against a cos and a sin
+* table shared per tone, a loop the compiler vectorizes. Key up time
+* costs nothing, so the work grows with the messages times their key
+* down samples. The float block is converted to 16 bit with TPDF dither
+* or plain rounding, saturating at full scale.
+*/
+class MorseMixer
+{
+public:
+	static const size_t BLOCK_FRAMES = 1024; // frames mixed per block
+
+	/**
+	* One message of the mix
+	*/
+	struct Message
+	{
+		double tone;       // Hz
+		double wpm;
+		double amplitude;  // 0.0 to 1.0 of full scale
+		double start;      // seconds from the start of the file
+		double phase;      // degrees at time 0
+		std::string text;
+	};
+
+private:
+	/**
+	* Playing state of one message
+	*/
+	struct Voice
+	{
+		MorseTiming timing;    // keying timeline
+		const float* table;    // cos then sin of BLOCK_FRAMES steps of the tone
+		double omega;          // phase step per sample
+		double phase;          // radians at frame 0
+		float amp;             // full scale is 1.0
+		size_t unitSamples;    // samples per morse unit
+		uint64_t start;        // first frame of the message
+		uint64_t delay;        // frames of silence left before the first run
+		size_t run = 0;        // current run in timeline
+		uint64_t left = 0;     // frames left in current run
+	};
+
+	Morse morse;
+	double Sps;
+	std::vector<Voice> voices;
+	std::map<double, std::vector<float>> tables; // per tone
+	std::vector<float> mix;    // one block
+	uint64_t frames = 0;       // end of the last message
+	uint64_t position = 0;     // frames mixed so far
+	uint64_t clipped = 0;      // samples saturated at full scale
+	uint32_t noise = 0x9E3779B9u; // dither generator state
+
+public:
+	/**
+	* Constructor
+	*
+	* @param samples_per_second
+	* @param uppercase - Morse table variant
+	*/
+	MorseMixer(double samples_per_second, bool uppercase);
+	~MorseMixer() = default;
+
+	/**
+	* Add a message, must be done before mixing starts
+	*
+	* @param message
+	*/
+	void Add(const Message& message);
+
+	/**
+	* Add the messages of a text file, one per line:
+	* tone wpm amplitude start phase text, # starts a comment
+	*
+	* @param path
+	* @return size_t - messages added
+	*/
+	size_t Load(const std::string& path);
+
+	/**
+	* Mix up to n frames as float, returns number of frames written
+	*
+	* @param out
+	* @param n
+	*/
+	size_t Mix(float* out, size_t n);
+
+	/**
+	* Mix up to n frames as 16 bit PCM, returns number of frames written
+	*
+	* @param out
+	* @param n
+	* @param dither - TPDF dither, else rounding
+	*/
+	size_t Render(int16_t* out, size_t n, bool dither);
+
+	/**
+	* Mix everything into a 16 bit mono wav, or FLAC when flac is set
+	*
+	* @param path
+	* @param flac
+	* @param dither
+	* @return uint64_t - bytes written
+	*/
+	uint64_t Save(const std::string& path, bool flac, bool dither);
+
+	/**
+	* Start again at the beginning
+	*/
+	void Rewind();
+
+	bool Done() const;
+	size_t GetCount() const;
+	uint64_t GetFrameCount() const;
+	uint64_t GetClipped() const;
+	double GetSps() const;
+
+private:
+	/**
+	* Add one voice's key down samples of a block to out
+	*
+	* @param v
+	* @param out
+	* @param n
+	*/
+	void Accumulate(Voice& v, float* out, size_t n);
+
+	/**
+	* Load the sample count of the current run, skipping empty runs
+	*
+	* @param v
+	*/
+	void LoadRun(Voice& v);
+
+	/**
+	* Get the shared cos / sin table for a tone
+	*
+	* @param tone
+	*/
+	const float* GetTable(double tone);
+};
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "morsering.h"
+#include "morserender.h"
+#include "morsesink.h"
+
+/**
+* C++ PcmBuffer Class
+*
+* PCM of a whole message that is played while it is rendered. The writer
+* fills the frames in order and publishes them, readers never look past
+* the published count; the array is made once and left uninitialized,
+* so a long message costs nothing up front and published frames stay
+* where they are for anyone holding the buffer.
+*/
+class PcmBuffer
+{
+private:
+	std::unique_ptr<int16_t[]> pcm;      // interleaved, the whole message
+	int NumChannels;
+	double Sps;
+	uint64_t frames;
+	std::atomic<uint64_t> ready{ 0 };    // frames published
+	std::atomic<bool> closed{ false };   // no more frames will be published
+
+public:
+	/**
+	* Constructor
+	*
+	* @param frames
+	* @param channels
+	* @param samples_per_second
+	*/
+	PcmBuffer(uint64_t frames, int channels, double samples_per_second);
+
+	/**
+	* Writer: where the next frame goes
+	*/
+	int16_t* GetWrite();
+
+	/**
+	* Writer: publish n frames written at GetWrite
+	*
+	* @param n
+	*/
+	void Publish(size_t n);
+
+	/**
+	* Writer: copy in and publish n frames
+	*
+	* @param block
+	* @param n
+	*/
+	void Append(const int16_t* block, size_t n);
+
+	/**
+	* Writer: done, also when rendering failed half way
+	*/
+	void Close();
+
+	/**
+	* Get frames published, the frames below are complete
+	*/
+	uint64_t GetReady() const;
+	bool IsClosed() const;
+
+	const int16_t* GetData() const;
+	uint64_t GetFrameCount() const;
+	int GetChannels() const;
+	double GetSps() const;
+};
+
+/**
+* C++ MorsePlayer Class
+*
+* In-process playback, no file and no external player. A render thread
+* renders the message a block at a time into a lock-free ring, an output
+* thread takes it from there and hands it to a MorseSink. Play renders
+* the first block itself before the threads start, so the sink has sound
+* within a block of the call. Pause holds the output thread and the sink,
+* the render thread stops when the ring is full; Stop ends both threads
+* and drops what the sink has queued. Nothing is allocated while playing.
+* A PcmBuffer that another thread renders is played without the render
+* thread, the output thread follows the published frames.
+* Play and Stop may be called from any thread.
+*/
+class MorsePlayer
+{
+public:
+	static const size_t RING_FRAMES = 1 << 14;  // render ahead, 0.34 s at 48 kHz
+	static const size_t BLOCK_FRAMES = 256;     // rendered at a time
+	static const size_t PERIOD_FRAMES = 256;    // handed to the sink at a time
+	static const int IDLE_MICROSECONDS = 500;   // thread sleep on a full or empty ring
+
+private:
+	MorseSink& sink;
+	int NumChannels = 1;
+	double Sps = 0.0;
+
+	std::unique_ptr<MorseTiming> timing;
+	std::unique_ptr<ToneTable> table;
+	std::unique_ptr<MorseRender> render;
+	std::unique_ptr<KeyRamp> ramp;
+	std::unique_ptr<MorseRing<int16_t>> ring; // interleaved samples, whole frames only
+	std::shared_ptr<const PcmBuffer> source;  // played instead of rendering, or nullptr
+	uint64_t taken = 0;                       // frames of source handed to the sink
+
+	std::vector<int16_t> block;   // render thread buffer
+	size_t blockAt = 0;           // samples of block in the ring
+	size_t blockSize = 0;         // samples in block
+	std::vector<int16_t> period;  // output thread buffer
+
+	std::atomic<bool> stopping{ false }; // Stop was called
+	std::atomic<bool> paused{ false };
+	std::atomic<bool> rendered{ false }; // every frame is in the ring
+	std::atomic<bool> finished{ true };  // the sink is closed
+	std::atomic<uint64_t> underruns{ 0 }; // times the sink waited for the renderer
+	std::thread renderer;
+	std::thread output;
+	std::mutex control; // Play and Stop
+
+public:
+	/**
+	* Constructor
+	*
+	* @param sink - used by the output thread while playing
+	*/
+	explicit MorsePlayer(MorseSink& sink);
+	~MorsePlayer();
+	MorsePlayer(const MorsePlayer&) = delete;
+	MorsePlayer& operator=(const MorsePlayer&) = delete;
+
+	/**
+	* Start playing a message, stops the one playing first; throws when
+	* the sink cannot be opened
+	*
+	* @param morsecode
+	* @param tone
+	* @param wpm
+	* @param samples_per_second
+	* @param channels
+	* @param envelope - keying ramps, nullptr = hard keying
+	*/
+	void Play(const std::string& morsecode, double tone, double wpm, double samples_per_second, int channels, const Envelope* envelope = nullptr);
+
+	/**
+	* Start playing a buffer while it is rendered, stops the one playing
+	* first; throws when the sink cannot be opened
+	*
+	* @param buffer
+	*/
+	void Play(std::shared_ptr<const PcmBuffer> buffer);
+
+	/**
+	* Hold playback where it is
+	*/
+	void Pause();
+
+	/**
+	* Go on after Pause
+	*/
+	void Resume();
+
+	/**
+	* End playback now
+	*/
+	void Stop();
+
+	/**
+	* Wait until the message has been played out
+	*/
+	void Wait();
+
+	bool IsPlaying() const;
+	bool IsPaused() const;
+
+	/**
+	* Get frames played, from the sink
+	*/
+	uint64_t GetPlayed() const;
+
+	/**
+	* Get the length of the message in frames
+	*/
+	uint64_t GetFrameCount() const;
+
+	/**
+	* Get the number of times the sink was starved
+	*/
+	uint64_t GetUnderruns() const;
+
+private:
+	void Start();
+	bool Fill();
+	size_t Take(const int16_t*& frames, bool& end);
+	void RenderWork();
+	void OutputWork();
+	void Halt();
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+* Keying ramp shapes
+*/
+enum RampShape
+{
+	RAMP_NONE = 0,     // hard keying, the carrier switches at once
+	RAMP_COSINE = 1,   // raised cosine rise and fall
+	RAMP_BLACKMAN = 2  // Blackman rise and fall, lower sidebands, slower start
+};
+
+/**
+* Keying envelope settings, off by default
+*/
+struct Envelope
+{
+	int shape = RAMP_NONE;
+	double rise = 5.0; // ms, rise time and fall time
+
+	/**
+	* Is the keying shaped
+	*/
+	bool IsActive() const;
+
+	/**
+	* Get the settings as text, for cache keys and reports
+	*/
+	std::string GetName() const;
+};
+
+/**
+* C++ KeyRamp Class
+*
+* Rise and fall of a mark for one sample rate, precomputed as a gain table.
+* Only the edge samples of a mark are multiplied, by the rise table or by
+* its mirror image the fall table; the steady part in between is left
+* alone, so a shaped render costs the same as a hard keyed one but for
+* the edges.
+* A mark shorter than two rises gets a rise of half its length, read from
+* the rise table at a coarser step; these tables are made on first use
+* and kept per rise length, so one KeyRamp is for one render thread.
+*/
+class KeyRamp
+{
+public:
+	static const size_t MAX_COARSE = 64; // short rise tables kept, beyond that they are filled per call
+
+private:
+	Envelope Settings;
+	double Sps;              // samples per second
+	std::vector<float> rise; // gain from 0 to 1 over the rise, one per sample
+	std::vector<float> fall; // rise backwards
+	mutable std::unordered_map<uint64_t, std::vector<float>> coarse; // rise and fall of short marks by rise length
+
+public:
+	/**
+	* Constructor
+	*
+	* @param envelope
+	* @param samples_per_second
+	*/
+	KeyRamp(const Envelope& envelope, double samples_per_second);
+	~KeyRamp() = default;
+
+	/**
+	* Shape n frames of a mark, the first one at sample at of the mark
+	*
+	* @param out
+	* @param at
+	* @param length - mark length in samples
+	* @param n
+	* @param channels - values per frame
+	*/
+	void Apply(int16_t* out, uint64_t at, uint64_t length, size_t n, int channels) const;
+	void Apply(float* out, uint64_t at, uint64_t length, size_t n, int channels) const;
+
+	/**
+	* Get the rise length in samples
+	*/
+	size_t GetLength() const;
+
+	/**
+	* Get the rise length in samples for a mark of length samples
+	*
+	* @param length
+	*/
+	uint64_t GetEdge(uint64_t length) const;
+
+private:
+	const float* GetCoarse(uint64_t edge) const;
+	template <typename T>
+	void Edges(T* out, uint64_t at, uint64_t length, size_t n, int channels) const;
+};
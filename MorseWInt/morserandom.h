@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+* C++ MorseRandom Class
+*
+* Fast seedable random numbers for the impairment simulator. LANES
+* xoshiro256++ generators run side by side with their state kept as
+* structure of arrays, so filling a buffer is plain 64 bit adds, shifts
+* and rotates the compiler vectorizes. Normal values come from the
+* Marsaglia-Tsang ziggurat: two per 64 bit word, almost all of them a
+* table lookup, a compare and a multiply. The same seed always gives the
+* same numbers.
+*/
+class MorseRandom
+{
+public:
+	static const int LANES = 4;
+	static const size_t BATCH = 128; // 64 bit words per refill
+
+private:
+	uint64_t s0[LANES], s1[LANES], s2[LANES], s3[LANES]; // generator state per lane
+	uint64_t words[BATCH];      // generated, not used yet
+	size_t used = BATCH;        // words taken from words
+	uint32_t kn[128];           // ziggurat: layer limits
+	float wn[128];              // ziggurat: layer widths
+	float fn[128];              // ziggurat: density at the layer edges
+
+public:
+	/**
+	* Constructor
+	*
+	* @param seed
+	*/
+	MorseRandom(uint64_t seed);
+	~MorseRandom() = default;
+
+	/**
+	* Start again from a seed
+	*
+	* @param seed
+	*/
+	void Seed(uint64_t seed);
+
+	/**
+	* Get one 64 bit random word
+	*/
+	uint64_t Next();
+
+	/**
+	* Get a uniform value, 0.0 < u < 1.0
+	*/
+	double Uniform();
+
+	/**
+	* Fill out with n standard normal values
+	*
+	* @param out
+	* @param n
+	*/
+	void Normal(float* out, size_t n);
+
+	/**
+	* Get one standard normal value
+	*/
+	float Normal();
+
+private:
+	/**
+	* Run every lane for BATCH / LANES steps into words
+	*/
+	void Refill();
+
+	/**
+	* Ziggurat slow path: the wedges and the tail
+	*
+	* @param hz
+	* @param iz
+	*/
+	float Tail(int32_t hz, uint32_t iz);
+
+	/**
+	* Normal value from a 32 bit word
+	*
+	* @param hz
+	*/
+	float FromWord(uint32_t hz);
+};
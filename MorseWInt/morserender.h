@@ -0,0 +1,244 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "morsetiming.h"
+#include "morseimpair.h"
+#include "morseramp.h"
+
+/**
+* C++ ToneTable Class
+*
+* Pre-scaled 16 bit oscillator for one tone / sample rate pair.
+* sine wave: y(k) = amplitude * sin(2 * PI * frequency * k / sample_rate)
+* When the tone repeats within MAX_PERIOD samples one exact period is stored
+* and rendering is a table copy, else a recursive oscillator is used.
+*/
+class ToneTable
+{
+public:
+	static const size_t MAX_PERIOD = 1 << 18; // max table length in samples
+
+private:
+	double Tone;                // tone frequency in hertz
+	double Sps;                 // samples per second
+	double Amp;                 // peak amplitude in int16 units
+	double omega;               // phase step per sample
+	std::vector<int16_t> table; // one exact period, empty if not periodic
+
+public:
+	/**
+	* Constructor
+	*
+	* @param tone
+	* @param samples_per_second
+	* @param amplitude - 0.0 to 1.0
+	*/
+	ToneTable(double tone, double samples_per_second, double amplitude);
+	~ToneTable() = default;
+
+	/**
+	* Write n tone samples starting at oscillator sample index, interleaved for channels
+	*
+	* @param out
+	* @param index
+	* @param n
+	* @param channels
+	*/
+	void Fill(int16_t* out, uint64_t index, size_t n, int channels) const;
+
+	double GetTone() const;
+	double GetSps() const;
+	size_t GetPeriod() const;
+
+private:
+	int16_t Quantize(double sample) const;
+};
+
+/**
+* C++ IqTable Class
+*
+* Complex baseband oscillator for SDR output, interleaved I/Q floats:
+* z(k) = amplitude * e^(i * 2 * PI * offset * k / sample_rate)
+* The keyed carrier sits at offset hertz from the centre frequency, an
+* offset of 0 gives the bare keying envelope on I. Like ToneTable one
+* exact period is stored when it repeats within MAX_PERIOD samples, else
+* eight phasors turn in step, a vector operation over the lanes.
+*/
+class IqTable
+{
+public:
+	static const size_t MAX_PERIOD = ToneTable::MAX_PERIOD; // max table length in samples
+	static const int LANES = 8;                               // phasors of the oscillator
+	static const size_t ANCHOR = 1024;                        // samples between exact phases
+
+private:
+	double Offset;            // carrier offset in hertz, may be negative
+	double Sps;               // samples per second
+	double Amp;               // peak amplitude, 0.0 to 1.0
+	double omega;             // phase step per sample
+	size_t period = 0;        // samples per period, 0 if not periodic
+	std::vector<float> table; // whole periods of I/Q pairs, empty if not periodic
+
+public:
+	/**
+	* Constructor
+	*
+	* @param offset
+	* @param samples_per_second
+	* @param amplitude - 0.0 to 1.0
+	*/
+	IqTable(double offset, double samples_per_second, double amplitude);
+	~IqTable() = default;
+
+	/**
+	* Write n I/Q pairs starting at oscillator sample index
+	*
+	* @param out
+	* @param index
+	* @param n
+	*/
+	void Fill(float* out, uint64_t index, size_t n) const;
+
+	/**
+	* Convert n floats of full scale 1.0 to 16 bit, for cs16 output
+	*
+	* @param in
+	* @param out
+	* @param n
+	*/
+	static void ToCs16(const float* in, int16_t* out, size_t n);
+
+	double GetOffset() const;
+	double GetSps() const;
+	size_t GetPeriod() const;
+};
+
+/**
+* C++ MorseRender Class
+*
+* Renders a MorseTiming timeline with a ToneTable into interleaved 16 bit PCM,
+* or with an IqTable into complex baseband.
+* Rendering can be done in one go or in blocks of any size, the oscillator
+* keeps its phase over silences, just like MorseWav::Tones did.
+* With a MorseImpair set, run lengths and samples come from it instead;
+* with noise and jitter only the marks come from the tone table and the
+* noise is added to them.
+* With a KeyRamp set, the edges of every mark are shaped. A periodic tone
+* starts its marks at a few oscillator phases only, so the shaped edges
+* are kept per phase, found by the phase in one array lookup, and a
+* shaped mark is copied just like a hard one.
+*/
+class MorseRender
+{
+public:
+	static const size_t MAX_EDGES = 256; // shaped edges kept, beyond that they are multiplied
+
+private:
+	const MorseTiming& timing; // keying timeline
+	const ToneTable& table;    // oscillator
+	int NumChannels;           // 1 = mono, 2 = stereo
+	size_t unitSamples;        // samples per morse unit
+	size_t run = 0;            // current run in timeline
+	uint64_t left = 0;         // samples left in current run
+	uint64_t length = 0;       // samples in current run
+	uint64_t toneIndex = 0;    // tone samples rendered so far (oscillator phase)
+	uint64_t position = 0;     // frames rendered so far
+	MorseImpair* impair = nullptr; // channel impairments, nullptr = clean
+	const KeyRamp* ramp = nullptr; // keying envelope, nullptr = hard keying
+	std::vector<std::vector<int16_t>> edges; // shaped rises and falls, up to MAX_EDGES
+	std::vector<int32_t> edgeSlot; // index in edges by oscillator phase * 2 + fall, -1 = not made
+	bool markReady = false;        // markEdge, markRise and markFall are for the current mark
+	uint64_t markEdge = 0;         // rise length of the current mark
+	const int16_t* markRise = nullptr; // its shaped rise, nullptr = multiplied
+	const int16_t* markFall = nullptr; // its shaped fall
+
+public:
+	/**
+	* Constructor
+	*
+	* @param timing
+	* @param table
+	* @param wpm
+	* @param channels
+	*/
+	MorseRender(const MorseTiming& timing, const ToneTable& table, double wpm, int channels);
+	~MorseRender() = default;
+
+	/**
+	* Render up to frames frames into out, returns number of frames written
+	*
+	* @param out
+	* @param frames
+	*/
+	size_t Render(int16_t* out, size_t frames);
+
+	/**
+	* Render up to frames complex baseband frames into out as interleaved
+	* I/Q floats, the same timeline keys iq instead of the tone table
+	*
+	* @param iq
+	* @param out
+	* @param frames
+	*/
+	size_t RenderIq(const IqTable& iq, float* out, size_t frames);
+
+	/**
+	* Start again at the beginning of the timeline
+	*/
+	void Rewind();
+
+	/**
+	* Render through a channel impairment simulator, built for the same
+	* timeline, tone and wpm; nullptr renders clean again
+	*
+	* @param impairment
+	*/
+	void SetImpairment(MorseImpair* impairment);
+
+	/**
+	* Shape the rise and fall of every mark, the ramp must be built for
+	* the same sample rate; nullptr keys hard again
+	*
+	* @param keyramp
+	*/
+	void SetRamp(const KeyRamp* keyramp);
+
+	/**
+	* Go on at oscillator sample index, so a timeline rendered after
+	* another one starts its marks at the phase the other one stopped at
+	*
+	* @param index - GetToneIndex of the renderer before
+	*/
+	void SetToneIndex(uint64_t index);
+	uint64_t GetToneIndex() const;
+
+	bool Done() const;
+	uint64_t GetFrameCount() const;
+	uint64_t GetPosition() const;
+	int GetChannels() const;
+	const ToneTable& GetTable() const;
+
+private:
+	void LoadRun();
+	size_t RenderImpaired(int16_t* out, size_t frames);
+
+	/**
+	* Render n samples of the current mark with shaped edges
+	*
+	* @param out
+	* @param n
+	*/
+	void RenderMark(int16_t* out, size_t n);
+
+	/**
+	* Get a shaped rise or fall that starts at oscillator sample index,
+	* nullptr when the edges cannot be cached
+	*
+	* @param index
+	* @param edge
+	* @param fall
+	*/
+	const int16_t* GetEdge(uint64_t index, uint64_t edge, bool fall);
+};
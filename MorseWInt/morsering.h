@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+* C++ MorseRing Class
+*
+* Lock-free ring for one writer thread and one reader thread. The
+* capacity is a power of two, the slots are made once, Write and Read
+* copy into and out of them and never allocate. Each side owns one
+* index and only reads the other's; the release store of an index after
+* the copy and the acquire load before the next one order the data.
+*/
+template <typename T>
+class MorseRing
+{
+private:
+	std::vector<T> slots;
+	size_t mask;
+	alignas(64) std::atomic<size_t> head{ 0 };  // next write, writer owned
+	alignas(64) std::atomic<size_t> tail{ 0 };  // next read, reader owned
+
+public:
+	/**
+	* Constructor
+	*
+	* @param capacity - rounded up to a power of two
+	*/
+	explicit MorseRing(size_t capacity)
+	{
+		size_t size = 1;
+		while (size < capacity) size <<= 1;
+		slots.resize(size);
+		mask = size - 1;
+	}
+
+	/**
+	* Writer: copy in up to n items
+	*
+	* @param items
+	* @param n
+	* @return size_t - items written, fewer when the ring is full
+	*/
+	size_t Write(const T* items, size_t n)
+	{
+		size_t h = head.load(std::memory_order_relaxed);
+		size_t room = slots.size() - (h - tail.load(std::memory_order_acquire));
+		if (n > room) n = room;
+		for (size_t i = 0; i < n; ++i) slots[(h + i) & mask] = items[i];
+		head.store(h + n, std::memory_order_release);
+		return n;
+	}
+
+	/**
+	* Reader: copy out up to n items
+	*
+	* @param items
+	* @param n
+	* @return size_t - items read, 0 when the ring is empty
+	*/
+	size_t Read(T* items, size_t n)
+	{
+		size_t t = tail.load(std::memory_order_relaxed);
+		size_t ready = head.load(std::memory_order_acquire) - t;
+		if (n > ready) n = ready;
+		for (size_t i = 0; i < n; ++i) items[i] = slots[(t + i) & mask];
+		tail.store(t + n, std::memory_order_release);
+		return n;
+	}
+
+	/**
+	* Items waiting, exact on the reader side
+	*/
+	size_t Size() const
+	{
+		return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+	}
+
+	size_t Capacity() const
+	{
+		return slots.size();
+	}
+};
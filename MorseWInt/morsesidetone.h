@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "morse.h"
+#include "morsering.h"
+#include "morserender.h"
+#include "morsesink.h"
+
+/**
+* One typed character and when it was typed
+*/
+struct Keystroke
+{
+	char c = 0;
+	std::chrono::steady_clock::time_point at;
+};
+
+/**
+* C++ MorseSidetone Class
+*
+* Live keying: every character typed is encoded with the Morse table and
+* sent to the sink on its own, with the letter space after it. The
+* worker renders each character through MorseRender and goes on at the
+* oscillator phase the character before stopped at, so the output is
+* one phase continuous stream, the same samples a MorseRender of the
+* whole text would give. Nothing is sent while nobody types.
+* Latency is measured from the keystroke, or from the end of the
+* character before when typed ahead, to the first sample the sink takes.
+*/
+class MorseSidetone
+{
+public:
+	static const size_t KEY_QUEUE = 256;      // typed ahead characters
+	static const size_t BLOCK_FRAMES = 128;   // rendered at a time, 2.7 ms at 48 kHz
+	static const int IDLE_MICROSECONDS = 200; // worker sleep while nobody types or the sink is full
+
+private:
+	MorseSink& sink;
+	double Wpm;
+	double Sps;
+	std::array<std::string, 256> codes;      // morse per character, "" = not in the table
+	ToneTable table;
+	std::unique_ptr<KeyRamp> ramp;
+	MorseRing<Keystroke> keys;
+	std::vector<int16_t> block;
+	uint64_t toneIndex = 0;                  // oscillator phase, carried from character to character
+
+	std::atomic<bool> stopping{ false };
+	std::atomic<bool> busy{ false };         // a character is being sent
+	std::atomic<uint64_t> sent{ 0 };         // characters sent
+	std::atomic<int64_t> lastLatency{ 0 };   // microseconds
+	std::atomic<int64_t> maxLatency{ 0 };    // microseconds
+	std::thread worker;
+
+public:
+	/**
+	* Constructor
+	*
+	* @param sink
+	* @param tone
+	* @param wpm
+	* @param samples_per_second
+	* @param uppercase - original international morse, else with lowercase
+	* @param envelope - keying ramps, nullptr = hard keying
+	*/
+	MorseSidetone(MorseSink& sink, double tone, double wpm, double samples_per_second, bool uppercase, const Envelope* envelope = nullptr);
+	~MorseSidetone();
+	MorseSidetone(const MorseSidetone&) = delete;
+	MorseSidetone& operator=(const MorseSidetone&) = delete;
+
+	/**
+	* Open the sink and start listening, throws when the sink cannot be opened
+	*/
+	void Start();
+
+	/**
+	* Send a character, from one thread only
+	*
+	* @param c
+	* @return bool - false when too many characters are typed ahead
+	*/
+	bool Key(char c);
+
+	/**
+	* Wait until every character typed is sent
+	*/
+	void Drain();
+
+	/**
+	* Stop at once, typed ahead characters are dropped
+	*/
+	void Stop();
+
+	/**
+	* Is nothing queued or being sent
+	*/
+	bool IsIdle() const;
+
+	/**
+	* Get the number of characters sent
+	*/
+	uint64_t GetSent() const;
+
+	/**
+	* Get keystroke to first sample latency of the last character in ms
+	*/
+	double GetLastLatency() const;
+
+	/**
+	* Get the highest keystroke to first sample latency in ms
+	*/
+	double GetMaxLatency() const;
+
+private:
+	void Work();
+	bool Send(const Keystroke& k, std::chrono::steady_clock::time_point ready);
+};
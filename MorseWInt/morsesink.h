@@ -0,0 +1,178 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <mmsystem.h>
+#endif
+
+/**
+* C++ MorseSink Class
+*
+* Audio output for MorsePlayer, interleaved 16 bit frames. The output
+* thread of the player is the only caller: it opens the sink, hands it
+* frames as fast as it takes them and closes it. Write never blocks, a
+* sink that has no room takes fewer frames and the player comes back.
+*/
+class MorseSink
+{
+public:
+	virtual ~MorseSink() = default;
+
+	/**
+	* Open for a format, throws when the output cannot be opened
+	*
+	* @param channels
+	* @param samples_per_second
+	*/
+	virtual void Open(int channels, double samples_per_second) = 0;
+
+	/**
+	* Take up to n frames
+	*
+	* @param frames
+	* @param n
+	* @return size_t - frames taken, 0 when the sink is full for now
+	*/
+	virtual size_t Write(const int16_t* frames, size_t n) = 0;
+
+	/**
+	* Hold or go on playing what was written
+	*
+	* @param paused
+	*/
+	virtual void Pause(bool paused) = 0;
+
+	/**
+	* Drop what was written and is not played yet
+	*/
+	virtual void Flush() = 0;
+
+	/**
+	* Play out what was written and close
+	*/
+	virtual void Close() = 0;
+
+	/**
+	* Get the frames played so far
+	*/
+	virtual uint64_t GetPlayed() const = 0;
+};
+
+/**
+* C++ NullSink Class
+*
+* Sink without output, for tests and machines without audio. In real
+* time mode it plays like a device with a buffer of bufferFrames: it takes
+* frames only as fast as the clock plays them, stops the clock while
+* paused and closes when the clock has played everything.
+*/
+class NullSink : public MorseSink
+{
+private:
+	bool realtime;
+	size_t bufferFrames;
+	double Sps = 0.0;
+	uint64_t written = 0;                     // frames taken
+	uint64_t playedBefore = 0;                // frames played up to the last pause
+	bool paused = false;
+	std::chrono::steady_clock::time_point since; // clock start or end of the last pause
+	std::atomic<uint64_t> played{ 0 };
+
+public:
+	/**
+	* Constructor
+	*
+	* @param realtime - pace like a device, false takes everything at once
+	* @param bufferFrames - device buffer in real time mode
+	*/
+	explicit NullSink(bool realtime = false, size_t bufferFrames = 2048);
+
+	void Open(int channels, double samples_per_second) override;
+	size_t Write(const int16_t* frames, size_t n) override;
+	void Pause(bool paused) override;
+	void Flush() override;
+	void Close() override;
+	uint64_t GetPlayed() const override;
+
+private:
+	uint64_t Clock();
+};
+
+/**
+* C++ WavSink Class
+*
+* Writes what is played to a 16 bit PCM wav file, the sizes in the header
+* are filled in on Close.
+*/
+class WavSink : public MorseSink
+{
+private:
+	std::string FullPath;
+	std::ofstream out;
+	int NumChannels = 1;
+	uint64_t written = 0;
+	std::atomic<uint64_t> played{ 0 };
+
+public:
+	/**
+	* Constructor
+	*
+	* @param path
+	*/
+	explicit WavSink(const std::string& path);
+
+	void Open(int channels, double samples_per_second) override;
+	size_t Write(const int16_t* frames, size_t n) override;
+	void Pause(bool paused) override;
+	void Flush() override;
+	void Close() override;
+	uint64_t GetPlayed() const override;
+};
+
+#ifdef _WIN32
+/**
+* C++ WaveOutSink Class
+*
+* Windows audio through waveOut: BUFFERS buffers of periodMs each are
+* queued to the device, Write fills the first one the device is done
+* with. Latency is about BUFFERS * periodMs.
+*/
+class WaveOutSink : public MorseSink
+{
+public:
+	static const int BUFFERS = 4;
+
+private:
+	int periodMs;
+	int NumChannels = 1;
+	HWAVEOUT device = NULL;
+	WAVEHDR headers[BUFFERS];
+	std::vector<int16_t> buffers[BUFFERS];
+	size_t periodFrames = 0;
+	int next = 0; // buffer to fill next, the device plays them in turn
+
+public:
+	/**
+	* Constructor
+	*
+	* @param periodMs - length of one buffer
+	*/
+	explicit WaveOutSink(int periodMs = 10);
+	~WaveOutSink();
+
+	void Open(int channels, double samples_per_second) override;
+	size_t Write(const int16_t* frames, size_t n) override;
+	void Pause(bool paused) override;
+	void Flush() override;
+	void Close() override;
+	uint64_t GetPlayed() const override;
+};
+#endif
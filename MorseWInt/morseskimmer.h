@@ -0,0 +1,125 @@
+#pragma once
+
+#include "morse.h"
+#include "morsefft.h"
+#include "morseclassifier.h"
+#include "morsewavreader.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+* C++ MorseSkimmer Class
+*
+* Decodes many CW signals from one wideband recording in one pass.
+* A Hann windowed FFT filter bank (75% overlap) turns the audio into one
+* level per bin per hop, every bin is keyed and classified on its own
+* like MorseDecoder does for one tone, against the noise level of the
+* whole band. The keying state that is touched every hop is kept as
+* structure of arrays, classifiers and text only run on key changes.
+* At the end, bins that carry a carrier (a local maximum of the average
+* spectrum above the noise) are reported with their decoded text.
+*/
+class MorseSkimmer
+{
+public:
+	static const size_t READ_FRAMES = 8192;
+	static constexpr double BIN_HZ = 50.0;      // about this wide channels
+	static constexpr double KEY_SNR = 4.0;      // key down level above the median bin (amplitude)
+	static constexpr double SIDE_RATIO = 0.5;   // key down level against bins up to 2 away
+	static const uint8_t DEBOUNCE = 2;          // hops a key change must hold
+	static constexpr double MIN_SNR = 2.0;      // carrier average power above the lower quartile bin
+	static constexpr double MIN_TONE = 20.0;
+	static constexpr double MAX_TONE = 8000.0;
+
+	/**
+	* Decoded signal
+	*/
+	struct Signal
+	{
+		double tone;       // Hz
+		double snr;        // average power above the lower quartile bin
+		double wpm;        // speed at the end
+		std::string morse;
+		std::string text;
+	};
+
+private:
+	Morse morse;
+	double Sps;
+	size_t N;                 // FFT size
+	size_t Hop;               // samples per filter bank output
+	size_t Channels;          // N / 2 + 1 bins
+	size_t Lo, Hi;            // bins searched for signals, MIN_TONE to MAX_TONE
+	MorseFft fft;
+	std::vector<double> window;
+	std::vector<double> frame;
+	std::vector<std::complex<double>> bins;
+	std::vector<int16_t> input;  // last N samples
+	size_t filled = 0;           // samples in input
+	std::vector<float> sorted;   // scratch for the median noise level
+	uint64_t hops = 0;
+	double peakDecay;
+
+	// hot per channel state, structure of arrays
+	std::vector<float> level;
+	std::vector<float> peak;
+	std::vector<double> powerSum;   // average spectrum
+	std::vector<uint8_t> key;
+	std::vector<uint32_t> run;      // hops in the current run
+	std::vector<uint8_t> change;    // hops the level has disagreed with key
+
+	// cold per channel state, touched on key changes only
+	std::vector<MorseClassifier> classifiers;
+	std::vector<std::string> word;
+	std::vector<std::string> code;
+	std::vector<std::string> text;
+
+public:
+	/**
+	* Constructor
+	*
+	* @param samples_per_second
+	* @param wpm - starting speed for every channel
+	* @param uppercase - Morse table variant
+	*/
+	MorseSkimmer(double samples_per_second, double wpm, bool uppercase);
+	~MorseSkimmer() = default;
+
+	/**
+	* Feed mono samples
+	*
+	* @param mono
+	* @param n
+	*/
+	void Process(const int16_t* mono, size_t n);
+
+	/**
+	* Flush all channels
+	*/
+	void Finish();
+
+	/**
+	* Decode a whole wav file
+	*
+	* @param reader
+	*/
+	void Decode(MorseWavReader& reader);
+
+	/**
+	* Get signals found, by tone
+	*/
+	std::vector<Signal> GetSignals() const;
+
+	/**
+	* Get channel width in Hz
+	*/
+	double GetBinHz() const;
+
+private:
+	void Transform();
+	void Keying();
+	void Run(size_t c, bool down, uint32_t length);
+	void Drain(size_t c);
+	void EndWord(size_t c);
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "morsetiming.h"
+#include "morserender.h"
+
+/**
+* C++ MorseStream Class
+*
+* Streams morse audio to a FILE* (normally stdout) in fixed-size blocks while
+* it is rendered, as raw 16 bit PCM or as WAV with an open-ended header.
+* Memory use is one block, whatever the length of the message, so
+* morse ew -stdout ... | sox/ffmpeg/aplay starts playing at once.
+*/
+class MorseStream
+{
+public:
+	static const size_t BLOCK_FRAMES = 4096; // frames per written block
+
+private:
+	FILE* Out;                  // output stream, opened in binary mode
+	bool Raw;                   // true = raw PCM, false = WAV header first
+	int NumChannels;            // 1 = mono, 2 = stereo
+	double Sps;                 // samples per second
+	uint64_t PcmCount = 0;      // frames written
+	std::vector<int16_t> block; // PCM block buffer
+
+public:
+	/**
+	* Constructor, renders and writes the whole message
+	*
+	* @param morsecode
+	* @param tone
+	* @param wpm
+	* @param samples_per_second
+	* @param modus - 1 = mono, 2 = stereo
+	* @param raw
+	* @param out
+	* @param impairment - channel impairments, nullptr = clean
+	* @param envelope - keying ramps, nullptr = hard keying
+	*/
+	MorseStream(const char* morsecode, double tone, double wpm, double samples_per_second, int modus, bool raw, FILE* out, const Impairment* impairment = nullptr, const Envelope* envelope = nullptr);
+
+	/**
+	* Constructor for complex baseband, renders and writes the whole message
+	* as raw interleaved I/Q, cf32 or cs16
+	*
+	* @param morsecode
+	* @param offset - carrier offset from the centre frequency in hertz
+	* @param wpm
+	* @param samples_per_second
+	* @param cs16 - true = 16 bit I/Q, false = 32 bit float I/Q
+	* @param out
+	* @param envelope - keying ramps, nullptr = hard keying
+	*/
+	MorseStream(const char* morsecode, double offset, double wpm, double samples_per_second, bool cs16, FILE* out, const Envelope* envelope = nullptr);
+	~MorseStream() = default;
+
+	/**
+	* Get number of frames written
+	*/
+	uint64_t GetPcmCount();
+
+	/**
+	* Write a WAV header with unknown (0xFFFFFFFF) riff and data sizes
+	*
+	* @param out
+	* @param channels
+	* @param sps
+	* @param bits
+	*/
+	static void WriteStreamHeader(FILE* out, int channels, double sps, int bits);
+
+private:
+	/**
+	* Write bytes, throws when the reader has gone away
+	*
+	* @param data
+	* @param size
+	*/
+	void Write(const void* data, size_t size);
+};
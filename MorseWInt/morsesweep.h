@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include "morse.h"
+#include "morsetiming.h"
+#include "morserender.h"
+#include "morsewav.h"
+
+/**
+* C++ MorseSweep Class
+*
+* Renders one text at many tone / wpm / sps combinations.
+* The text is encoded and normalized once, the keying timeline is built once
+* and oscillator tables are shared per tone/sps pair, so every variant
+* costs little more than writing its samples.
+*/
+class MorseSweep
+{
+private:
+	std::string MorseCode;  // morse code string, encoded once
+	MorseTiming timing;     // keying timeline, built once
+	std::map<std::pair<double, double>, std::unique_ptr<ToneTable>> tables; // oscillator per tone/sps
+	std::vector<std::string> files; // written wav files
+	double seconds = 0.0;   // total audio length rendered
+
+public:
+	/**
+	* Constructor
+	*
+	* @param text
+	* @param uppercase
+	*/
+	MorseSweep(const std::string& text, bool uppercase);
+	~MorseSweep() = default;
+
+	/**
+	* Render every tone x wpm x sps combination to a wav file
+	*
+	* @param tones
+	* @param wpms
+	* @param spss
+	* @param modus - 1 = mono, 2 = stereo
+	*/
+	void Run(const std::vector<double>& tones, const std::vector<double>& wpms, const std::vector<double>& spss, int modus);
+
+	/**
+	* Get morse code string
+	*/
+	std::string GetMorseCode();
+
+	/**
+	* Get written wav files
+	*/
+	const std::vector<std::string>& GetFiles();
+
+private:
+	/**
+	* Get the shared oscillator table for tone and sps
+	*
+	* @param tone
+	* @param sps
+	*/
+	const ToneTable& GetTable(double tone, double sps);
+
+	/**
+	* Encode text once, MorseTiming needs the code in its initializer
+	*
+	* @param text
+	* @param uppercase
+	*/
+	static std::string Encode(const std::string& text, bool uppercase);
+};
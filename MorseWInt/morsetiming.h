@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+* One run of equal keying state, measured in morse units (elements)
+*/
+struct KeyRun
+{
+	bool key;       // true = tone (key down), false = silence (key up)
+	uint32_t units; // length of the run in morse units
+};
+
+/**
+* C++ MorseTiming Class
+*
+* Keying timeline of a morse code string (. - <space>).
+* The timeline is independent of tone, wpm and samples per second,
+* so it can be built once and rendered at any speed or rate.
+*/
+class MorseTiming
+{
+private:
+	std::vector<KeyRun> runs; // alternating key down / key up runs
+	uint64_t units = 0;       // total length in morse units
+	uint64_t markUnits = 0;   // morse units with key down
+
+public:
+	/**
+	* Constructor
+	*
+	* @param morsecode
+	*/
+	MorseTiming(const char* morsecode);
+	~MorseTiming() = default;
+
+	/**
+	* Get keying runs
+	*/
+	const std::vector<KeyRun>& GetRuns() const;
+
+	/**
+	* Get total length in morse units
+	*/
+	uint64_t GetUnits() const;
+
+	/**
+	* Get number of morse units with key down
+	*/
+	uint64_t GetMarkUnits() const;
+
+	/**
+	* Get number of samples per morse unit, 1.2 / wpm seconds per unit
+	*
+	* @param wpm
+	* @param sps
+	*/
+	static size_t SamplesPerUnit(double wpm, double sps);
+
+private:
+	/**
+	* Append units of tone or silence, merging with the previous run
+	*
+	* @param key
+	* @param n
+	*/
+	void Append(bool key, uint32_t n);
+
+	/**
+	* Define dit, dah and space, same rules as MorseWav
+	*/
+	void Dit();
+	void Dah();
+	void Space();
+};
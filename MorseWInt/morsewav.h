@@ -14,6 +14,7 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <memory>
 #include <cstdint>
 #include <cstddef>
 #include <algorithm>
@@ -22,11 +23,31 @@
 #include <errno.h>
 #define NOMINMAX
 #include <windows.h>
+#include "morsetiming.h"
+#include "morserender.h"
+#include "morsecache.h"
+#include "flacencoder.h"
+#include "morsecodec.h"
+#include "morseplayer.h"
+
+/**
+* Output formats
+*/
+enum MorseFormat
+{
+	FORMAT_PCM16 = 0,     // 16 bit PCM wav
+	FORMAT_FLAC = 1,      // lossless FLAC, built-in encoder
+	FORMAT_MULAW = 2,     // 8 bit G.711 mu-law wav
+	FORMAT_ALAW = 3,      // 8 bit G.711 A-law wav
+	FORMAT_IMA_ADPCM = 4, // 4 bit IMA ADPCM wav
+	FORMAT_IQ_CF32 = 5,   // raw complex baseband, interleaved 32 bit float I/Q
+	FORMAT_IQ_CS16 = 6    // raw complex baseband, interleaved 16 bit I/Q
+};
 
 class MorseWav
 {
 private:
-	const std::string SaveDir = "C:\\Users\\User\\Desktop\\wav-files-morse\\"; // output directory - use this format
+	static inline const std::string SaveDir = "C:\\Users\\User\\Desktop\\wav-files-morse\\"; // output directory - use this format
 	std::string FullPath = ""; // full path to save file
 	const char* MorseCode;     // morse code string
 	int NumChannels;           // 1 = mono, 2 = stereo
@@ -35,19 +56,26 @@ private:
 	double Sps;                // samples per second
 	double Eps;                // elements per second (frequency of morse coding)
 	double Bit;                // seconds per element (period of morse coding)
-	std::vector<int16_t> pcm;  // PCM data array
 	double Amplitude = 0.8;    // 80% of max volume (0.0 to 1.0)
 	long WaveSize;             // size of the wave file in bytes
 	long PcmCount;             // number of PCM samples
 	bool show;				   // to open media player after creation
-	// oscillator state for phase continuity between successive Tones() calls
-	double phase = 0.0;
+	bool cached = false;       // file was served from the render cache
+	int Format = FORMAT_PCM16; // output format, see MorseFormat
+	MorsePlayer* player = nullptr;   // plays the blocks as they are rendered, or nullptr
+	std::shared_ptr<PcmBuffer> live; // blocks published to the player
+	static const size_t LIVE_FRAMES = 256; // frames rendered before playback starts
 
 public:
 	/**
 	* Constructor / Destructor
 	*/
-	MorseWav(const char* morsecode, double tone, double wpm, double samples_per_second, int modus, bool show);
+	MorseWav(const char* morsecode, double tone, double wpm, double samples_per_second, int modus, bool show, MorseCache* cache = nullptr, int format = FORMAT_PCM16, const Impairment* impairment = nullptr, const Envelope* envelope = nullptr, MorsePlayer* player = nullptr);
+
+	/**
+	* Constructor for a prepared renderer (parameter sweeps), name is added to the file name
+	*/
+	MorseWav(MorseRender& render, double wpm, bool show, const std::string& name);
 	~MorseWav() = default;
 
 	/**
@@ -55,7 +83,17 @@ public:
 	*/
 	std::string GetFullPath();
 
-	void CreateFullPath();
+	void CreateFullPath(const std::string& name = "");
+
+	/**
+	* Get output directory
+	*/
+	static std::string GetSaveDir();
+
+	/**
+	* Was the file served from the render cache
+	*/
+	bool IsCached();
 
 	/**
 	* Get GetWaveSize
@@ -69,40 +107,68 @@ public:
 
 private:
 	/**
-	* Write wav file
+	* Render and write a 16 bit PCM wav file block by block
+	*
+	* @param render
+	*/
+	void WritePcm(MorseRender& render);
+
+	/**
+	* Render and encode a FLAC file block by block
 	*
-	* @param filename
-	* @param pcmData
+	* @param render
 	*/
-	void WriteWav(const std::vector<int16_t>& pcmData);
+	void WriteFlac(MorseRender& render);
 
 	/**
-	* Get binary morse code (dit/dah) for a given character.
-	* Generate one quantum of silence or tone in PCM/WAV array.
-	* sine wave: y(t) = amplitude * sin(2 * PI * frequency * time), time = s / sample_rate
+	* Render and write a mu-law, A-law or IMA ADPCM wav file block by block,
+	* with the fmt extension and fact chunk compressed formats need
 	*
-	* @param silence
+	* @param render
 	*/
-	void Tones(int silence);
+	void WriteCodec(MorseRender& render);
 
 	/**
-	* Define dit, dah, end of letter, end of word.
+	* Render and write raw cf32 or cs16 complex baseband block by block,
+	* the tone is the offset of the carrier from the centre frequency
 	*
-	* The rules of 1/3/7 and 1/2/4(more suitable for common microphones, like webcams and phones):
-	* Morse code is: tone for one unit (dit) or three units (dah)
-	* followed by the sum of one unit of silence (always),
-	* plus two units of silence (if end of letter, one space),
-	* plus four units of silence (if also end of word).
+	* @param render
 	*/
-	void Dit();
-	void Dah();
-	void Space();
+	void WriteIq(MorseRender& render);
 
 	/**
-	* Morse code tone generator
+	* Is the format complex baseband
+	*/
+	bool IsIq();
+
+	/**
+	* Create SaveDir if it does not exist
+	*/
+	void CreateSaveDir();
+
+	/**
+	* Get format name, used for cache keys
+	*/
+	std::string GetFormatName();
+
+	/**
+	* Render the whole timeline into the player's buffer only
+	*
+	* @param render
+	*/
+	void MorseTones(MorseRender& render);
+
+	/**
+	* Hand a rendered block to the player, the first one starts playback
 	*
-	* @param code
+	* @param block
+	* @param frames
+	*/
+	void Publish(const int16_t* block, size_t frames);
+
+	/**
+	* Print summary and open media player, unless the player plays it
 	*/
-	void MorseTones(const char* code);
+	void Report();
 };
 
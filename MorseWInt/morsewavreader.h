@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+* C++ MorseWavReader Class
+*
+* Reads wav files block by block as mono, stereo is mixed down: 8, 16,
+* 24 or 32 bit PCM and 32 bit float, as normalized float or 16 bit
+* samples. The file is memory mapped one view of about VIEW_BYTES at a
+* time, so recordings of any size are read with a small working set.
+* Chunks other than fmt and data (LIST, fact, ...) are skipped, a data
+* size of 0xFFFFFFFF (a streamed wav, see MorseStream) or one past the
+* end of the file reads to end of file.
+*/
+class MorseWavReader
+{
+public:
+	static const size_t VIEW_BYTES = 16 << 20;  // mapped at a time
+	static const size_t CONVERT_FRAMES = 4096;  // float scratch of the 16 bit Read
+
+private:
+	void* File = nullptr;        // file HANDLE
+	void* Mapping = nullptr;     // file mapping HANDLE
+	uint64_t FileSize = 0;
+	uint64_t Granularity = 0;    // view offsets are multiples of this
+	const uint8_t* View = nullptr;
+	uint64_t ViewStart = 0;      // file offsets of View
+	uint64_t ViewEnd = 0;
+
+	int NumChannels = 0;         // channels in the file
+	int Bits = 0;                // 8, 16, 24 or 32
+	bool Float = false;          // 32 bit IEEE float
+	double Sps = 0.0;            // samples per second
+	size_t FrameBytes = 0;
+	uint64_t Frames = 0;         // frames in the data chunk, to end of file when streamed
+	uint64_t DataStart = 0;      // file offsets of the samples
+	uint64_t DataEnd = 0;
+	uint64_t Position = 0;       // file offset of the next frame
+	std::vector<float> convert;
+
+public:
+	/**
+	* Constructor, maps the file and reads the header
+	*
+	* @param path
+	*/
+	MorseWavReader(const std::string& path);
+	~MorseWavReader();
+	MorseWavReader(const MorseWavReader&) = delete;
+	MorseWavReader& operator=(const MorseWavReader&) = delete;
+
+	/**
+	* Read up to frames mono samples, -1.0 to 1.0
+	*
+	* @param out
+	* @param frames
+	* @return size_t - frames read, 0 at end of data
+	*/
+	size_t Read(float* out, size_t frames);
+
+	/**
+	* Read up to frames mono samples, 16 bit
+	*
+	* @param out
+	* @param frames
+	* @return size_t - frames read, 0 at end of data
+	*/
+	size_t Read(int16_t* out, size_t frames);
+
+	/**
+	* Go back to the first frame
+	*/
+	void Rewind();
+
+	int GetChannels() const;
+	int GetBits() const;
+	bool IsFloat() const;
+	double GetSps() const;
+	uint64_t GetFrameCount() const;
+
+private:
+	const uint8_t* Map(uint64_t offset, size_t bytes);
+	void Convert(const uint8_t* in, float* out, size_t frames) const;
+	void Close();
+};
@@ -0,0 +1,139 @@
+#include "morsetest.h"
+#include "../morse.h"
+#include "../morsebatch.h"
+#include "../morserender.h"
+#include "../morsesink.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+/**
+* C++ BatchTest
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+namespace fs = std::filesystem;
+
+/**
+* Write a message as a 16 bit mono wav
+*
+* @param path
+* @param text
+* @param sps
+* @param wpm
+*/
+static void WriteWav(const string& path, const string& text, double sps, double wpm)
+{
+    Morse m(true);
+    string code = m.morse_encode(text);
+    MorseTiming timing(code.c_str());
+    ToneTable table(700.0, sps, 0.5);
+    MorseRender render(timing, table, wpm, 1);
+    vector<int16_t> pcm(render.GetFrameCount() + static_cast<size_t>(sps / 2.0), 0);
+    render.Render(pcm.data(), render.GetFrameCount());
+    WavSink sink(path);
+    sink.Open(1, sps);
+    sink.Write(pcm.data(), pcm.size());
+    sink.Close();
+}
+
+/**
+* MorseBatch: results come out in file order whatever the number of
+* threads, each the same as a fresh decoder on that file, a broken file
+* reported in its place; with an output directory one text per file
+*
+* @return bool
+*/
+bool BatchTest()
+{
+    const double wpm = 20.0;
+    const double rates[] = { 8000.0, 16000.0, 44100.0, 48000.0 };
+    const fs::path dir = "batch";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    // result as printed: a header up to the audio length, then morse and
+    // text; the first file is long, so the other threads steal its queue mates
+    vector<string> files;
+    vector<pair<string, string>> want;
+    for (int i = 0; i < 16; ++i)
+    {
+        string text = "FILE " + to_string(i) + " CQ DE PA3XYZ K";
+        if (i == 0) for (int r = 0; r < 5; ++r) text += " THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG";
+        string path = (dir / ("f" + to_string(i) + ".wav")).string();
+        double sps = rates[i % 4];
+        WriteWav(path, text, sps, wpm);
+
+        MorseDecoder decoder(700.0, sps, wpm, true);
+        MorseWavReader reader(path);
+        decoder.Decode(reader);
+        files.push_back(path);
+        want.push_back({ "== " + path + " (700 Hz, " + to_string(static_cast<int>(decoder.GetWpm() + 0.5)) + " wpm, ",
+            "\n" + decoder.GetMorseCode() + "\n" + decoder.GetText() + "\n" });
+        if (i == 9)
+        {
+            string broken = (dir / "broken.wav").string();
+            ofstream(broken, ios::binary) << "RIFF";
+            files.push_back(broken);
+            want.push_back({ "== " + broken + ": ERROR", "" });
+        }
+    }
+
+    bool ok = true;
+    for (size_t threads : { 1, 4 })
+    {
+        MorseBatch batch(700.0, wpm, true);
+        ostringstream out;
+        auto start = chrono::steady_clock::now();
+        batch.Run(files, threads, out);
+        double seconds = Seconds(start);
+
+        // every result starts with "== path", in the order of the files
+        string all = out.str();
+        size_t at = 0;
+        int same = 0;
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            size_t next = all.find("\n== ", at);
+            string result = all.substr(at, (next == string::npos) ? string::npos : next + 1 - at);
+            at = (next == string::npos) ? all.size() : next + 1;
+            const string& head = want[i].first;
+            const string& body = want[i].second;
+            bool match = result.compare(0, head.size(), head) == 0 && result.size() >= body.size()
+                && result.compare(result.size() - body.size(), body.size(), body) == 0;
+            if (match) same++;
+            else printf("FAIL file %zu: %s", i, result.c_str());
+        }
+        printf("%zu threads: %d of %zu results in order and as decoded alone, %.1f ms\n", threads, same, files.size(), seconds * 1000.0);
+        if (same != static_cast<int>(files.size())) ok = false;
+    }
+
+    // one text per file in the output directory, nothing on the stream but the error
+    {
+        MorseBatch batch(700.0, wpm, true);
+        batch.SetOutDir((dir / "out").string());
+        ostringstream out;
+        batch.Run(files, 4, out);
+        int written = 0;
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            fs::path text = dir / "out" / (fs::path(files[i]).stem().string() + ".txt");
+            if (!fs::exists(text)) continue;
+            ifstream in(text);
+            string morse, decoded;
+            getline(in, morse);
+            getline(in, decoded);
+            if (!want[i].second.empty() && want[i].second == "\n" + morse + "\n" + decoded + "\n") written++;
+        }
+        bool error = out.str().find("broken.wav: ERROR") != string::npos;
+        printf("output directory: %d of %zu texts, broken file %s\n", written, files.size() - 1, error ? "reported" : "NOT REPORTED");
+        if (written != static_cast<int>(files.size()) - 1 || !error) ok = false;
+    }
+    fs::remove_all(dir);
+    return ok;
+}
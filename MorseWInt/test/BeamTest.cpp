@@ -0,0 +1,163 @@
+#include "morsetest.h"
+#include "../morse.h"
+#include "../morsebeam.h"
+#include "../morseclassifier.h"
+#include "../morsetiming.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/**
+* C++ BeamTest
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Key runs of a timeline with log normal jitter, character and word gaps
+* squeezed to charGap and wordGap units
+*
+* @param timing
+* @param unit - dit length
+* @param sigma - jitter, log units
+* @param charGap
+* @param wordGap
+* @param random
+* @return vector - lengths, key down at even indices
+*/
+static vector<double> Jitter(const MorseTiming& timing, double unit, double sigma, double charGap, double wordGap, mt19937& random)
+{
+    normal_distribution<double> normal(0.0, sigma);
+    vector<double> runs;
+    for (const KeyRun& r : timing.GetRuns())
+    {
+        double units = r.units;
+        if (!r.key && r.units == 3) units = charGap;
+        else if (!r.key && r.units >= 7) units = wordGap;
+        runs.push_back(units * unit * exp(normal(random)));
+    }
+    return runs;
+}
+
+/**
+* Greedy decode with MorseClassifier, as MorseDecoder does without a beam
+*
+* @param runs
+* @param unit
+* @param m
+* @return string
+*/
+static string Greedy(const vector<double>& runs, double unit, Morse& m)
+{
+    MorseClassifier classifier(unit);
+    string text, word, elements;
+    int gap;
+    auto drain = [&]()
+    {
+        while (classifier.Next(elements, gap))
+        {
+            if (!word.empty()) word += ' ';
+            word += elements;
+            if (gap == RUN_WORD_GAP)
+            {
+                text += m.morse_decode(word) + " ";
+                word.clear();
+            }
+        }
+    };
+    for (size_t i = 0; i < runs.size(); ++i)
+    {
+        classifier.Add(i % 2 == 0, runs[i]);
+        drain();
+    }
+    classifier.Flush();
+    drain();
+    if (!word.empty()) text += m.morse_decode(word);
+    while (!text.empty() && text.back() == ' ') text.pop_back();
+    return text;
+}
+
+/**
+* MorseBeam against the greedy classifier on jittered runs: never worse,
+* far better when the gaps are squeezed, and well above real time
+*
+* @return bool
+*/
+bool BeamTest()
+{
+    struct Case
+    {
+        double sigma;
+        double charGap;
+        double wordGap;
+    };
+    const Case cases[] =
+    {
+        { 0.10, 3.0, 7.0 },
+        { 0.20, 3.0, 7.0 },
+        { 0.20, 2.0, 4.0 },
+    };
+    const char* texts[] =
+    {
+        "CQ CQ DE PA3XYZ PA3XYZ K",
+        "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG",
+        "UR RST 599 NAME RAY QTH AMSTERDAM HW CPY",
+    };
+    const int TRIALS = 6;
+    const double unit = 60.0; // 20 wpm at 8 kHz
+
+    Morse m(true);
+    bool ok = true;
+    for (const Case& c : cases)
+    {
+        mt19937 random(38);
+        double greedyErrors = 0.0, beamErrors = 0.0, characters = 0.0, seconds = 0.0, samples = 0.0;
+        size_t runs = 0;
+        MorseBeam beam(unit, true);
+        for (const char* text : texts)
+        {
+            string code = m.morse_encode(text);
+            MorseTiming timing(code.c_str());
+            for (int trial = 0; trial < TRIALS; ++trial)
+            {
+                vector<double> jittered = Jitter(timing, unit, c.sigma, c.charGap, c.wordGap, random);
+                string greedy = Greedy(jittered, unit, m);
+
+                auto start = chrono::steady_clock::now();
+                beam.Reset(unit);
+                for (size_t i = 0; i < jittered.size(); ++i) beam.Add(i % 2 == 0, jittered[i]);
+                beam.Flush();
+                seconds += Seconds(start);
+                string got = beam.GetText();
+                while (!got.empty() && got.back() == ' ') got.pop_back();
+
+                double n = static_cast<double>(string(text).size());
+                greedyErrors += Cer(greedy, text) * n;
+                beamErrors += Cer(got, text) * n;
+                characters += n;
+                runs += jittered.size();
+                for (double r : jittered) samples += r;
+            }
+        }
+        double greedyCer = greedyErrors / characters;
+        double beamCer = beamErrors / characters;
+        double realtime = samples / 8000.0 / seconds;
+        printf("sigma %.2f gaps %.0f / %.0f: greedy CER %5.1f%%, beam CER %5.1f%%, %.2fM runs/s, %.0fx real time\n",
+            c.sigma, c.charGap, c.wordGap, greedyCer, beamCer, runs / seconds / 1e6, realtime);
+        if (beamCer > greedyCer || realtime < 100.0)
+        {
+            printf("FAIL beam worse than greedy or below 100x real time\n");
+            ok = false;
+        }
+        if (c.charGap < 3.0 && beamCer > 0.5 * greedyCer)
+        {
+            printf("FAIL beam not twice as good as greedy on squeezed gaps\n");
+            ok = false;
+        }
+    }
+    return ok;
+}
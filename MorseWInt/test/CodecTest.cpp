@@ -0,0 +1,301 @@
+#define _USE_MATH_DEFINES // Required for MSVC/Windows
+#include "morsetest.h"
+#include "../morsecodec.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/**
+* C++ CodecTest
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* G.711 mu-law code to 16 bit, as ulaw2linear of the reference g711.c
+*
+* @param u
+* @return int
+*/
+static int MuLawDecode(uint8_t u)
+{
+    u = static_cast<uint8_t>(~u);
+    int t = ((u & 0x0F) << 3) + 0x84;
+    t <<= (u & 0x70) >> 4;
+    return (u & 0x80) ? (0x84 - t) : (t - 0x84);
+}
+
+/**
+* G.711 A-law code to 16 bit, as alaw2linear of the reference g711.c
+*
+* @param a
+* @return int
+*/
+static int ALawDecode(uint8_t a)
+{
+    a ^= 0x55;
+    int t = (a & 0x0F) << 4;
+    int seg = (a & 0x70) >> 4;
+    if (seg == 0) t += 8;
+    else if (seg == 1) t += 0x108;
+    else t = (t + 0x108) << (seg - 1);
+    return (a & 0x80) ? t : -t;
+}
+
+static const int IMA_STEP[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+static const int IMA_INDEX[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+/**
+* IMA ADPCM decoder state of one channel
+*/
+struct ImaChannel
+{
+    int pred = 0;
+    int index = 0;
+
+    int Next(int nibble)
+    {
+        int step = IMA_STEP[index];
+        int diff = step >> 3;
+        if (nibble & 4) diff += step;
+        if (nibble & 2) diff += step >> 1;
+        if (nibble & 1) diff += step >> 2;
+        pred += (nibble & 8) ? -diff : diff;
+        if (pred > 32767) pred = 32767;
+        else if (pred < -32768) pred = -32768;
+        index += IMA_INDEX[nibble];
+        if (index < 0) index = 0;
+        else if (index > 88) index = 88;
+        return pred;
+    }
+};
+
+/**
+* Decode one wav IMA ADPCM block the way the Microsoft layout reads:
+* a 4 byte header per channel, low nibble first, stereo data in runs
+* of 4 bytes per channel
+*
+* @param block
+* @param block_align
+* @param channels
+* @param state - index checked against the header
+* @param out - interleaved
+* @return bool - false when a header index is not where the stream was
+*/
+static bool ImaDecode(const uint8_t* block, size_t block_align, int channels, ImaChannel state[2], vector<int>& out)
+{
+    size_t perBlock = MorseCodec::ImaSamplesPerBlock(block_align, channels);
+    vector<int> x[2];
+    bool ok = true;
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        const uint8_t* h = block + ch * 4;
+        state[ch].pred = static_cast<int16_t>(h[0] | (h[1] << 8));
+        if (h[2] != state[ch].index || h[3] != 0) ok = false;
+        x[ch].push_back(state[ch].pred);
+    }
+    const uint8_t* data = block + channels * 4;
+    const uint8_t* end = block + block_align;
+    while (data < end)
+    {
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            size_t run = (channels == 2) ? 4 : 1;
+            for (size_t b = 0; b < run; ++b, ++data)
+            {
+                x[ch].push_back(state[ch].Next(*data & 0x0F));
+                x[ch].push_back(state[ch].Next(*data >> 4));
+            }
+        }
+    }
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        if (x[ch].size() != perBlock) ok = false;
+    }
+    for (size_t i = 0; i < perBlock; ++i)
+    {
+        for (int ch = 0; ch < channels; ++ch) out.push_back(x[ch][i]);
+    }
+    return ok;
+}
+
+/**
+* G.711 codes against reference values and the reference decoder
+*
+* @return bool
+*/
+static bool G711Check()
+{
+    bool ok = true;
+    struct Known
+    {
+        int16_t pcm;
+        uint8_t mu;
+        uint8_t a;
+    };
+    // silence, the extremes and the first step either side of zero
+    const Known known[] =
+    {
+        { 0, 0xFF, 0xD5 },
+        { -1, 0x7E, 0x55 },
+        { 8, 0xFE, 0xD5 },
+        { 16, 0xFD, 0xD4 },
+        { 32767, 0x80, 0xAA },
+        { -32768, 0x00, 0x2A },
+        { 1000, 0xCE, 0xFA },
+        { -1000, 0x4E, 0x7A },
+    };
+    for (const Known& k : known)
+    {
+        uint8_t mu;
+        uint8_t a;
+        MorseCodec::MuLaw(&k.pcm, &mu, 1);
+        MorseCodec::ALaw(&k.pcm, &a, 1);
+        if (mu != k.mu || a != k.a)
+        {
+            printf("FAIL G.711 of %d: mu-law %02X want %02X, A-law %02X want %02X\n", k.pcm, mu, k.mu, a, k.a);
+            ok = false;
+        }
+    }
+
+    // every code comes back from its own decoded value (mu-law 0x7F is a second zero)
+    int roundTrip = 0;
+    for (int c = 0; c < 256; ++c)
+    {
+        int16_t pcm[2] = { static_cast<int16_t>(MuLawDecode(static_cast<uint8_t>(c))), static_cast<int16_t>(ALawDecode(static_cast<uint8_t>(c))) };
+        uint8_t mu;
+        uint8_t a;
+        MorseCodec::MuLaw(&pcm[0], &mu, 1);
+        MorseCodec::ALaw(&pcm[1], &a, 1);
+        if (mu == c || (c == 0x7F && mu == 0xFF)) roundTrip++;
+        if (a == c) roundTrip++;
+    }
+    if (roundTrip != 512)
+    {
+        printf("FAIL G.711: %d of 512 codes encode from their decoded value\n", roundTrip);
+        ok = false;
+    }
+
+    // every 16 bit sample: quantized in order, within a step of the segment
+    int lastMu = -32768;
+    int lastA = -32768;
+    int worst = 0;
+    for (int x = -32768; x <= 32767; ++x)
+    {
+        int16_t s = static_cast<int16_t>(x);
+        uint8_t mu;
+        uint8_t a;
+        MorseCodec::MuLaw(&s, &mu, 1);
+        MorseCodec::ALaw(&s, &a, 1);
+        int ym = MuLawDecode(mu);
+        int ya = ALawDecode(a);
+        if (ym < lastMu || ya < lastA) ok = false;
+        lastMu = ym;
+        lastA = ya;
+        // the step doubles per segment, 1/16 of the value from the third segment on
+        int limit = max(16, abs(x) / 16 + 16);
+        worst = max(worst, max(abs(ym - x), abs(ya - x)) - limit);
+    }
+    if (worst > 0)
+    {
+        printf("FAIL G.711 error %d over the step\n", worst);
+        ok = false;
+    }
+    printf("G.711: %zu reference values, 512 codes, 65536 samples %s\n", sizeof(known) / sizeof(known[0]), ok ? "ok" : "FAILED");
+    return ok;
+}
+
+/**
+* IMA ADPCM block layout and a decode of a tone, mono and stereo
+*
+* @return bool
+*/
+static bool ImaCheck()
+{
+    bool ok = true;
+    if (MorseCodec::ImaBlockAlign(1, 8000.0) != 256 || MorseCodec::ImaSamplesPerBlock(256, 1) != 505 ||
+        MorseCodec::ImaBlockAlign(2, 8000.0) != 512 || MorseCodec::ImaSamplesPerBlock(512, 2) != 505 ||
+        MorseCodec::ImaBlockAlign(1, 44100.0) != 1024 || MorseCodec::ImaSamplesPerBlock(1024, 1) != 2041)
+    {
+        printf("FAIL IMA ADPCM block sizes\n");
+        ok = false;
+    }
+
+    for (int channels = 1; channels <= 2; ++channels)
+    {
+        const double sps = 8000.0;
+        size_t align = MorseCodec::ImaBlockAlign(channels, sps);
+        size_t perBlock = MorseCodec::ImaSamplesPerBlock(align, channels);
+        // 4 blocks and a short one, left and right at different tones and levels
+        size_t frames = perBlock * 4 + 100;
+        vector<int16_t> pcm(frames * channels);
+        for (size_t i = 0; i < frames; ++i)
+        {
+            pcm[i * channels] = static_cast<int16_t>(20000.0 * sin(2.0 * M_PI * 700.0 * i / sps));
+            if (channels == 2) pcm[i * 2 + 1] = static_cast<int16_t>(6000.0 * sin(2.0 * M_PI * 450.0 * i / sps));
+        }
+
+        MorseCodec codec(channels);
+        ImaChannel state[2];
+        vector<uint8_t> block(align);
+        vector<int> decoded;
+        bool headers = true;
+        for (size_t at = 0; at < frames; at += perBlock)
+        {
+            size_t n = min(perBlock, frames - at);
+            codec.ImaBlock(pcm.data() + at * channels, n, block.data(), align);
+            // the header carries the first sample as it is
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                if (static_cast<int16_t>(block[ch * 4] | (block[ch * 4 + 1] << 8)) != pcm[at * channels + ch]) headers = false;
+            }
+            if (!ImaDecode(block.data(), align, channels, state, decoded)) headers = false;
+        }
+        if (!headers)
+        {
+            printf("FAIL IMA ADPCM %d ch: block header\n", channels);
+            ok = false;
+        }
+
+        // a wrong nibble order or interleave decodes to noise
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            double signal = 0.0;
+            double error = 0.0;
+            for (size_t i = 0; i < frames; ++i)
+            {
+                double x = pcm[i * channels + ch];
+                double e = decoded[i * channels + ch] - x;
+                signal += x * x;
+                error += e * e;
+            }
+            double snr = 10.0 * log10(signal / max(error, 1.0));
+            printf("IMA ADPCM %d ch, channel %d: %zu bytes per block, %zu samples, SNR %.1f dB\n", channels, ch, align, perBlock, snr);
+            if (snr < 20.0) ok = false;
+        }
+    }
+    return ok;
+}
+
+/**
+* MorseCodec: G.711 tables and IMA ADPCM block layout
+*
+* @return bool
+*/
+bool CodecTest()
+{
+    bool g711 = G711Check();
+    bool ima = ImaCheck();
+    return g711 && ima;
+}
@@ -0,0 +1,89 @@
+#include "morsetest.h"
+#include "../morsedecimator.h"
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <vector>
+
+/**
+* C++ DecimatorTest
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Baseband level of a sine at frequency after MorseDecimator, the mean
+* power once both stages are filled
+*
+* @param tone
+* @param sps
+* @param frequency
+* @return double - power in dB
+*/
+static double Level(double tone, double sps, double frequency)
+{
+    const double PI = 3.14159265358979323846;
+    MorseDecimator decimator(tone, sps);
+    vector<int16_t> pcm(static_cast<size_t>(sps));
+    for (size_t i = 0; i < pcm.size(); ++i)
+    {
+        pcm[i] = static_cast<int16_t>(lround(10000.0 * sin(2.0 * PI * frequency * i / sps)));
+    }
+    vector<complex<float>> out;
+    decimator.Process(pcm.data(), pcm.size(), out);
+    size_t skip = static_cast<size_t>(decimator.GetDelay() / decimator.GetFactor()) + MorseDecimator::HALF_BAND_TAPS;
+    double power = 0.0;
+    for (size_t i = skip; i < out.size(); ++i) power += norm(out[i]);
+    return 10.0 * log10(power / (out.size() - skip) + 1e-20);
+}
+
+/**
+* MorseDecimator: flat within 0.6 dB to 400 Hz off the tone, and what
+* folds onto 100 Hz off the tone from above the output rate down at
+* least 25 dB
+*
+* @return bool
+*/
+bool DecimatorTest()
+{
+    const double MAX_RIPPLE = 0.6; // dB
+    const double MIN_ALIAS = 25.0; // dB
+    bool ok = true;
+    for (double sps : { 48000.0, 44100.0, 16000.0 })
+    {
+        for (double tone : { 700.0, 3000.0 })
+        {
+            MorseDecimator d(tone, sps);
+            double rate = d.GetRate();
+            double reference = Level(tone, sps, tone);
+
+            double ripple = 0.0;
+            for (double offset : { -400.0, -200.0, -100.0, 100.0, 200.0, 400.0 })
+            {
+                ripple = max(ripple, fabs(Level(tone, sps, tone + offset) - reference));
+            }
+
+            // every image of tone + 100 Hz that falls below Nyquist
+            double alias = 1e9;
+            double worst = 0.0;
+            for (int k = -40; k <= 40; ++k)
+            {
+                double f = tone + 100.0 + k * rate;
+                if (k == 0 || f <= 50.0 || f >= sps / 2.0 - 50.0) continue;
+                double a = reference - Level(tone, sps, f);
+                if (a < alias)
+                {
+                    alias = a;
+                    worst = f;
+                }
+            }
+            printf("%5.0f sps %4.0f Hz: factor %2zu to %6.1f sps, ripple %.2f dB to +-400 Hz, aliases down %5.1f dB (worst %5.0f Hz)\n",
+                sps, tone, d.GetFactor(), rate, ripple, alias, worst);
+            if (ripple > MAX_RIPPLE || alias < MIN_ALIAS) ok = false;
+        }
+    }
+    return ok;
+}
@@ -0,0 +1,128 @@
+#include "morsetest.h"
+#include "../morse.h"
+#include "../morsewav.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+
+/**
+* C++ FirstSoundTest
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* NullSink in real time that notes when the first frames reach it
+*/
+class FirstSoundSink : public NullSink
+{
+public:
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    atomic<int64_t> first{ -1 }; // microseconds from start, -1 = no sound yet
+
+    FirstSoundSink() : NullSink(true) {}
+
+    size_t Write(const int16_t* frames, size_t n) override
+    {
+        n = NullSink::Write(frames, n);
+        if (n > 0 && first.load() < 0)
+        {
+            first.store(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count());
+        }
+        return n;
+    }
+};
+
+/**
+* Compare the samples of a 16 bit wav file with a whole-text render
+*
+* @param path
+* @param code
+* @param sps
+* @return bool
+*/
+static bool SameSamples(const string& path, const string& code, double sps)
+{
+    MorseTiming timing(code.c_str());
+    ToneTable table(700.0, sps, 0.8);
+    MorseRender render(timing, table, 25.0, 1);
+    vector<int16_t> want(render.GetFrameCount());
+    render.Render(want.data(), want.size());
+
+    ifstream in(path, ios::binary);
+    vector<char> bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    const size_t header = 12 + 8 + sizeof(WAVEFORMATEX) + 8;
+    if (bytes.size() != header + want.size() * sizeof(int16_t)) return false;
+    return memcmp(bytes.data() + header, want.data(), want.size() * sizeof(int16_t)) == 0;
+}
+
+/**
+* MorseWav PCM16 played while it is written: the first frames reach the
+* sink within 50 ms whatever the length of the message, and the file is
+* the same as without a player
+*
+* @return bool
+*/
+bool FirstSoundTest()
+{
+    const double sps = 48000.0;
+    const double MAX_FIRST = 50.0; // ms
+    Morse m(true);
+    bool ok = true;
+    for (int words : { 10, 150 })
+    {
+        string text;
+        for (int i = 0; text.size() < static_cast<size_t>(words) * 6; ++i) text += (i % 2) ? "PARIS " : "CQ DE PA3XYZ ";
+        string code = m.morse_encode(text);
+        for (int play = 0; play < 2; ++play)
+        {
+            FirstSoundSink sink;
+            MorsePlayer player(sink);
+            string path;
+            double seconds;
+            {
+                // MorseWav reports every file on cout and the save directory on cerr
+                ostringstream report;
+                streambuf* console = cout.rdbuf(report.rdbuf());
+                streambuf* errors = cerr.rdbuf(report.rdbuf());
+                sink.start = chrono::steady_clock::now();
+                MorseWav wav(code.c_str(), 700.0, 25.0, sps, 1, play != 0, nullptr, FORMAT_PCM16, nullptr, nullptr, play ? &player : nullptr);
+                seconds = Seconds(sink.start);
+                cerr.rdbuf(errors);
+                cout.rdbuf(console);
+                path = wav.GetFullPath();
+            }
+            // a short file can be written before the output thread's first
+            // write, give it time rather than stopping it first
+            for (int i = 0; play && sink.first.load() < 0 && i < 1000; ++i) this_thread::sleep_for(chrono::milliseconds(1));
+            player.Stop();
+            double first = sink.first.load() / 1000.0;
+            bool same = SameSamples(path, code, sps);
+            remove(path.c_str());
+
+            MorseTiming timing(code.c_str());
+            double length = timing.GetUnits() * MorseTiming::SamplesPerUnit(25.0, sps) / sps;
+            if (play)
+            {
+                printf("%6.1f s message: first sound after %6.2f ms, file written after %7.1f ms, samples %s\n",
+                    length, first, seconds * 1000.0, same ? "exact" : "DIFFER");
+                if (first < 0.0 || first > MAX_FIRST) ok = false;
+            }
+            else
+            {
+                printf("%6.1f s message: no player,                     file written after %7.1f ms, samples %s\n",
+                    length, seconds * 1000.0, same ? "exact" : "DIFFER");
+            }
+            if (!same) ok = false;
+        }
+    }
+    return ok;
+}
@@ -0,0 +1,352 @@
+#include "morsetest.h"
+#include "../flacencoder.h"
+#include "../morse.h"
+#include "../morserender.h"
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <vector>
+
+/**
+* C++ FlacRoundTrip
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* MSB first bit reader over a FLAC stream
+*/
+struct BitReader
+{
+    const uint8_t* data;
+    size_t size;
+    size_t bit = 0;
+
+    uint32_t Get(int bits)
+    {
+        uint32_t value = 0;
+        for (int i = 0; i < bits; ++i)
+        {
+            size_t byte = bit >> 3;
+            uint32_t b = (byte < size) ? (data[byte] >> (7 - (bit & 7))) & 1 : 0;
+            value = (value << 1) | b;
+            bit++;
+        }
+        return value;
+    }
+
+    int32_t GetSigned(int bits)
+    {
+        uint32_t value = Get(bits);
+        if (bits < 32 && (value >> (bits - 1))) value |= ~0u << bits;
+        return static_cast<int32_t>(value);
+    }
+
+    uint32_t GetUnary()
+    {
+        uint32_t q = 0;
+        while (Get(1) == 0) q++;
+        return q;
+    }
+
+    void Align()
+    {
+        bit = (bit + 7) & ~static_cast<size_t>(7);
+    }
+
+    bool Ended() const
+    {
+        return (bit >> 3) >= size;
+    }
+};
+
+/**
+* CRC-16 of the frame, polynomial x^16 + x^15 + x^2 + 1
+*
+* @param data
+* @param size
+* @return uint16_t
+*/
+static uint16_t Crc16(const uint8_t* data, size_t size)
+{
+    uint16_t crc = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc ^= static_cast<uint16_t>(data[i] << 8);
+        for (int b = 0; b < 8; ++b) crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x8005) : static_cast<uint16_t>(crc << 1);
+    }
+    return crc;
+}
+
+/**
+* Rice coded residual of one subframe
+*
+* @param in
+* @param r - residual, r[order] onward
+* @param n
+* @param order
+* @return bool
+*/
+static bool ReadResidual(BitReader& in, int32_t* r, uint32_t n, int order)
+{
+    uint32_t method = in.Get(2);
+    if (method > 1) return false;
+    int paramBits = (method == 0) ? 4 : 5;
+    uint32_t escape = (1u << paramBits) - 1;
+    uint32_t partitionOrder = in.Get(4);
+    uint32_t parts = 1u << partitionOrder;
+    uint32_t size = n >> partitionOrder;
+    for (uint32_t p = 0; p < parts; ++p)
+    {
+        uint32_t from = (p == 0) ? order : p * size;
+        uint32_t to = (p + 1) * size;
+        uint32_t k = in.Get(paramBits);
+        if (k == escape)
+        {
+            int bits = static_cast<int>(in.Get(5));
+            for (uint32_t i = from; i < to; ++i) r[i] = bits ? in.GetSigned(bits) : 0;
+            continue;
+        }
+        for (uint32_t i = from; i < to; ++i)
+        {
+            uint32_t u = (in.GetUnary() << k) | in.Get(k);
+            r[i] = static_cast<int32_t>(u >> 1) ^ -static_cast<int32_t>(u & 1);
+        }
+    }
+    return true;
+}
+
+/**
+* One subframe, every type a 16 bit stream may use
+*
+* @param in
+* @param x
+* @param n
+* @param bps
+* @return bool
+*/
+static bool ReadSubframe(BitReader& in, int32_t* x, uint32_t n, int bps)
+{
+    if (in.Get(1) != 0) return false;
+    uint32_t type = in.Get(6);
+    int wasted = 0;
+    if (in.Get(1))
+    {
+        wasted = static_cast<int>(in.GetUnary()) + 1;
+        bps -= wasted;
+    }
+    if (type == 0)
+    {
+        int32_t v = in.GetSigned(bps);
+        for (uint32_t i = 0; i < n; ++i) x[i] = v;
+    }
+    else if (type == 1)
+    {
+        for (uint32_t i = 0; i < n; ++i) x[i] = in.GetSigned(bps);
+    }
+    else if (type >= 8 && type <= 12)
+    {
+        int order = static_cast<int>(type - 8);
+        for (int i = 0; i < order; ++i) x[i] = in.GetSigned(bps);
+        if (!ReadResidual(in, x, n, order)) return false;
+        for (uint32_t i = order; i < n; ++i)
+        {
+            switch (order)
+            {
+            case 1: x[i] += x[i - 1]; break;
+            case 2: x[i] += 2 * x[i - 1] - x[i - 2]; break;
+            case 3: x[i] += 3 * x[i - 1] - 3 * x[i - 2] + x[i - 3]; break;
+            case 4: x[i] += 4 * x[i - 1] - 6 * x[i - 2] + 4 * x[i - 3] - x[i - 4]; break;
+            default: break;
+            }
+        }
+    }
+    else if (type >= 32)
+    {
+        int order = static_cast<int>(type - 31);
+        for (int i = 0; i < order; ++i) x[i] = in.GetSigned(bps);
+        int precision = static_cast<int>(in.Get(4)) + 1;
+        int shift = in.GetSigned(5);
+        int32_t qlp[32];
+        for (int i = 0; i < order; ++i) qlp[i] = in.GetSigned(precision);
+        if (!ReadResidual(in, x, n, order)) return false;
+        for (uint32_t i = order; i < n; ++i)
+        {
+            int64_t sum = 0;
+            for (int j = 0; j < order; ++j) sum += static_cast<int64_t>(qlp[j]) * x[i - 1 - j];
+            x[i] += static_cast<int32_t>(sum >> shift);
+        }
+    }
+    else
+    {
+        return false;
+    }
+    if (wasted) for (uint32_t i = 0; i < n; ++i) x[i] <<= wasted;
+    return true;
+}
+
+/**
+* Decode a 16 bit FLAC stream with its STREAMINFO, frame CRCs checked
+*
+* @param flac
+* @param channels - from STREAMINFO
+* @param sps - from STREAMINFO
+* @param total - samples per channel from STREAMINFO
+* @param pcm - interleaved
+* @return bool - false on any format error
+*/
+static bool Decode(const string& flac, int& channels, uint32_t& sps, uint64_t& total, vector<int16_t>& pcm)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(flac.data());
+    BitReader in{ data, flac.size() };
+    if (flac.compare(0, 4, "fLaC") != 0) return false;
+    in.bit = 32;
+    bool last = false;
+    while (!last)
+    {
+        last = in.Get(1) != 0;
+        uint32_t type = in.Get(7);
+        uint32_t length = in.Get(24);
+        size_t next = in.bit + length * 8;
+        if (type == 0)
+        {
+            in.Get(16 + 16 + 24 + 24);
+            sps = in.Get(20);
+            channels = static_cast<int>(in.Get(3)) + 1;
+            if (in.Get(5) != 15) return false;
+            total = static_cast<uint64_t>(in.Get(4)) << 32;
+            total |= in.Get(32);
+        }
+        in.bit = next;
+    }
+
+    pcm.clear();
+    vector<int32_t> x[2];
+    while (!in.Ended())
+    {
+        size_t start = in.bit >> 3;
+        if (in.Get(14) != 0x3FFE) return false;
+        in.Get(2);
+        uint32_t sizeCode = in.Get(4);
+        uint32_t rateCode = in.Get(4);
+        uint32_t assignment = in.Get(4);
+        in.Get(3 + 1);
+        // frame number, utf-8 style
+        uint32_t lead = in.Get(8);
+        int extra = 0;
+        while (extra < 7 && (lead & (0x80 >> extra))) extra++;
+        for (int i = 1; i < extra; ++i) in.Get(8);
+        uint32_t n = 0;
+        if (sizeCode == 1) n = 192;
+        else if (sizeCode >= 2 && sizeCode <= 5) n = 576u << (sizeCode - 2);
+        else if (sizeCode == 6) n = in.Get(8) + 1;
+        else if (sizeCode == 7) n = in.Get(16) + 1;
+        else if (sizeCode >= 8) n = 256u << (sizeCode - 8);
+        if (rateCode == 12) in.Get(8);
+        else if (rateCode == 13 || rateCode == 14) in.Get(16);
+        in.Get(8); // crc-8
+
+        int count = (assignment <= 7) ? static_cast<int>(assignment) + 1 : 2;
+        if (count != channels) return false;
+        for (int c = 0; c < count; ++c)
+        {
+            x[c].resize(n);
+            // the side channel has one bit more
+            int bps = 16 + ((assignment == 8 && c == 1) || (assignment == 9 && c == 0) || (assignment == 10 && c == 1) ? 1 : 0);
+            if (!ReadSubframe(in, x[c].data(), n, bps)) return false;
+        }
+        in.Align();
+        size_t end = in.bit >> 3;
+        if (in.Get(16) != Crc16(data + start, end - start)) return false;
+
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            int32_t a = x[0][i];
+            int32_t b = (count == 2) ? x[1][i] : 0;
+            if (assignment == 8) b = a - b;
+            else if (assignment == 9) a = a + b;
+            else if (assignment == 10)
+            {
+                int32_t mid = (a << 1) | (b & 1);
+                a = (mid + b) >> 1;
+                b = (mid - b) >> 1;
+            }
+            pcm.push_back(static_cast<int16_t>(a));
+            if (count == 2) pcm.push_back(static_cast<int16_t>(b));
+        }
+    }
+    return true;
+}
+
+/**
+* Encode rendered morse with FlacEncoder, decode it again and compare
+* every sample and the STREAMINFO
+*
+* @return bool
+*/
+bool FlacRoundTrip()
+{
+    const double rates[] = { 8000.0, 44100.0 };
+    const int channels[] = { 1, 2 };
+    const size_t chunks[] = { 1000, 4096 }; // frames per Write, not a block multiple
+
+    Morse m(true);
+    string code = m.morse_encode("CQ CQ DE PA3XYZ 73");
+    mt19937 random(29);
+    uniform_int_distribution<int> noise(-300, 300);
+    int cases = 0;
+    int failed = 0;
+    for (double sps : rates)
+    {
+        for (int ch : channels)
+        {
+            for (int noisy = 0; noisy < 2; ++noisy)
+            {
+                MorseTiming timing(code.c_str());
+                ToneTable table(700.0, sps, 0.8);
+                MorseRender render(timing, table, 25.0, ch);
+                vector<int16_t> pcm(render.GetFrameCount() * ch);
+                render.Render(pcm.data(), render.GetFrameCount());
+                // noise on the left only gives stereo frames with distinct channels
+                if (noisy)
+                {
+                    for (size_t i = 0; i < pcm.size(); i += ch) pcm[i] = static_cast<int16_t>(pcm[i] + noise(random));
+                }
+                size_t frames = pcm.size() / ch;
+
+                for (size_t chunk : chunks)
+                {
+                    stringstream out(ios::in | ios::out | ios::binary);
+                    FlacEncoder flac(out, ch, static_cast<uint32_t>(sps), frames);
+                    for (size_t at = 0; at < frames; at += chunk)
+                    {
+                        flac.Write(pcm.data() + at * ch, min(chunk, frames - at));
+                    }
+                    flac.Finish();
+                    string bytes = out.str();
+
+                    int gotChannels = 0;
+                    uint32_t gotSps = 0;
+                    uint64_t total = 0;
+                    vector<int16_t> got;
+                    bool decoded = Decode(bytes, gotChannels, gotSps, total, got);
+                    cases++;
+                    if (!decoded || gotChannels != ch || gotSps != sps || total != frames || got != pcm)
+                    {
+                        failed++;
+                        printf("FAIL %g sps %d ch%s, chunk %zu: %s\n", sps, ch, noisy ? " noisy" : "", chunk, decoded ? "samples differ" : "format error");
+                    }
+                    else if (chunk == chunks[0])
+                    {
+                        printf("%6g sps %d ch%-6s %7zu frames, %5.1f%% of PCM\n", sps, ch, noisy ? " noisy" : "", frames, 100.0 * bytes.size() / (pcm.size() * 2));
+                    }
+                }
+            }
+        }
+    }
+    printf("%d of %d FLAC streams decode bit exact\n", cases - failed, cases);
+    return failed == 0;
+}
@@ -0,0 +1,114 @@
+#include "morsetest.h"
+#include "../morse.h"
+#include "../morserender.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+/**
+* C++ ImpairTest
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Render a timeline through an impairment in blocks of block frames,
+* 0 = all in one go
+*
+* @param timing
+* @param table
+* @param settings
+* @param channels
+* @param block
+* @return vector
+*/
+static vector<int16_t> Render(const MorseTiming& timing, const ToneTable& table, const Impairment& settings, int channels, size_t block)
+{
+    MorseRender render(timing, table, 25.0, channels);
+    MorseImpair impair(settings, timing, table.GetTone(), 25.0, table.GetSps(), 0.3);
+    if (settings.IsActive()) render.SetImpairment(&impair);
+    vector<int16_t> pcm(render.GetFrameCount() * channels);
+    size_t frames = 0;
+    while (!render.Done())
+    {
+        size_t n = block ? min(block, pcm.size() / channels - frames) : pcm.size() / channels;
+        frames += render.Render(pcm.data() + frames * channels, n);
+    }
+    return pcm;
+}
+
+/**
+* MorseImpair: the same seed gives the same samples whatever the block
+* sizes, the noise has the power of its SNR
+*
+* @return bool
+*/
+bool ImpairTest()
+{
+    Morse m(true);
+    string code = m.morse_encode("CQ CQ DE PA3XYZ PA3XYZ K 73");
+    MorseTiming timing(code.c_str());
+    ToneTable table(700.0, 8000.0, 0.3);
+    bool ok = true;
+
+    Impairment noisy;
+    noisy.noise = true;
+    noisy.snr = 6.0;
+    noisy.jitter = 0.1;
+    Impairment all = noisy;
+    all.fading = FADING_RICIAN;
+    all.qsbDepth = 10.0;
+    all.drift = 30.0;
+    const Impairment* cases[] = { &noisy, &all };
+    const size_t blocks[] = { 1000, 37, MorseImpair::NOISE_RUN };
+    for (const Impairment* settings : cases)
+    {
+        for (int channels = 1; channels <= 2; ++channels)
+        {
+            vector<int16_t> whole = Render(timing, table, *settings, channels, 0);
+            int same = 0;
+            for (size_t block : blocks)
+            {
+                if (Render(timing, table, *settings, channels, block) == whole) same++;
+            }
+            Impairment other = *settings;
+            other.seed++;
+            bool differs = Render(timing, table, other, channels, 0) != whole;
+            printf("%-50s %d ch: %d of %zu block sizes the same, other seed %s\n", settings->GetName().c_str(), channels,
+                same, sizeof(blocks) / sizeof(blocks[0]), differs ? "differs" : "THE SAME");
+            if (same != sizeof(blocks) / sizeof(blocks[0]) || !differs) ok = false;
+        }
+    }
+
+    // noise only keys the clean tone, so the noise is the difference;
+    // the SNR is key down tone power over noise power
+    vector<int16_t> clean = Render(timing, table, Impairment(), 1, 0);
+    const double amp = 0.3 * 32767.0;
+    for (double snr : { 0.0, 6.0, 20.0 })
+    {
+        Impairment settings;
+        settings.noise = true;
+        settings.snr = snr;
+        vector<int16_t> pcm = Render(timing, table, settings, 1, 0);
+        double sum = 0.0;
+        double power = 0.0;
+        for (size_t i = 0; i < pcm.size(); ++i)
+        {
+            double e = pcm[i] - clean[i];
+            sum += e;
+            power += e * e;
+        }
+        double mean = sum / pcm.size();
+        double measured = 10.0 * log10(0.5 * amp * amp / (power / pcm.size()));
+        printf("snr %4.1f dB: measured %5.2f dB, noise mean %+.2f over %zu frames\n", snr, measured, mean, pcm.size());
+        if (fabs(measured - snr) > 0.2 || fabs(mean) > 0.05 * sqrt(power / pcm.size()))
+        {
+            printf("FAIL snr %.1f dB\n", snr);
+            ok = false;
+        }
+    }
+    return ok;
+}
@@ -0,0 +1,175 @@
+#include "morsetest.h"
+#include "../morselive.h"
+#include "../morserender.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+* C++ LiveLatency
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+// allocations of threads other than the test's own, while counting is on
+static atomic<bool> counting{ false };
+static atomic<uint64_t> allocations{ 0 };
+static thread_local bool harness = false;
+
+void* operator new(size_t n)
+{
+    if (counting.load(memory_order_relaxed) && !harness) allocations.fetch_add(1, memory_order_relaxed);
+    void* p = malloc(n ? n : 1);
+    if (!p) throw bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+
+/**
+* Feed rendered audio to MorseLive in 10 ms chunks at real time pace and
+* time every character from the end of its last mark to the reader
+*
+* @param sps
+* @param wpm
+* @param snr - dB in 2.5 kHz
+* @param matched
+* @return bool
+*/
+static bool Run(double sps, double wpm, double snr, bool matched)
+{
+    const string text = "CQ CQ DE PA3XYZ PA3XYZ K THE QUICK BROWN FOX 599 73";
+    const double tone = 700.0;
+    const double amplitude = 0.25 * 32767.0;
+    typedef chrono::steady_clock clock;
+
+    Morse m(true);
+    string code = m.morse_encode(text);
+    MorseTiming timing(code.c_str());
+    ToneTable table(tone, sps, 0.25);
+    MorseRender render(timing, table, wpm, 1);
+    vector<int16_t> pcm(render.GetFrameCount() + static_cast<size_t>(2.0 * sps), 0);
+    render.Render(pcm.data(), render.GetFrameCount());
+    mt19937 random(5);
+    normal_distribution<double> normal(0.0, amplitude / sqrt(2.0 * pow(10.0, snr / 10.0) * 2500.0 / (sps / 2.0)));
+    for (int16_t& s : pcm) s = static_cast<int16_t>(max(-32768.0, min(32767.0, s + normal(random))));
+
+    // sample where the last mark of each character ends
+    const uint64_t unit = MorseTiming::SamplesPerUnit(wpm, sps);
+    vector<uint64_t> ends;
+    uint64_t at = 0;
+    bool inCharacter = false;
+    for (const KeyRun& run : timing.GetRuns())
+    {
+        if (run.key)
+        {
+            if (!inCharacter) ends.push_back(0);
+            inCharacter = true;
+            ends.back() = at + run.units * unit;
+        }
+        else if (run.units >= 3)
+        {
+            inCharacter = false;
+        }
+        at += static_cast<uint64_t>(run.units) * unit;
+    }
+
+    harness = true;
+    MorseLive live(tone, sps, wpm, true, matched);
+    const size_t chunk = static_cast<size_t>(sps / 100.0);
+    const size_t chunks = (pcm.size() + chunk - 1) / chunk;
+    vector<clock::time_point> pushed(chunks);
+    allocations.store(0);
+
+    // input thread, a chunk when it is due; allocations count after the first second
+    clock::time_point start = clock::now();
+    thread producer([&]()
+    {
+        harness = true;
+        for (size_t c = 0; c < chunks; ++c)
+        {
+            this_thread::sleep_until(start + chrono::microseconds(static_cast<int64_t>(1e6 * (c + 1) * chunk / sps)));
+            size_t first = c * chunk;
+            size_t n = min(chunk, pcm.size() - first);
+            pushed[c] = clock::now();
+            size_t taken = 0;
+            while (taken < n) taken += live.Push(pcm.data() + first + taken, n - taken);
+            if (c == 100) counting.store(true);
+        }
+        counting.store(false);
+        live.End();
+    });
+
+    // reader, the first character waits for the speed lock and is not timed
+    vector<double> latency;
+    string got;
+    size_t chars = 0;
+    CharRecord record;
+    for (;;)
+    {
+        bool done = live.IsDone();
+        while (live.Next(record))
+        {
+            clock::time_point now = clock::now();
+            got += record.text;
+            if (record.space) got += ' ';
+            if (chars > 0 && chars < ends.size())
+            {
+                size_t c = static_cast<size_t>(ends[chars] / chunk);
+                double late = chrono::duration<double, milli>(now - pushed[c]).count();
+                latency.push_back(late + 1000.0 * ((c + 1) * chunk - ends[chars]) / sps);
+            }
+            chars++;
+        }
+        if (done) break;
+        this_thread::sleep_for(chrono::microseconds(200));
+    }
+    producer.join();
+    harness = false;
+
+    sort(latency.begin(), latency.end());
+    auto percentile = [&](double p) { return latency.empty() ? 0.0 : latency[min(latency.size() - 1, static_cast<size_t>(p * latency.size()))]; };
+    double unitMs = 1000.0 * unit / sps;
+    // word flush, a unit of detector delay and scheduling
+    double limit = (MorseDecoder::WORD_FLUSH_UNITS + 1.0) * unitMs + 50.0;
+    while (!got.empty() && got.back() == ' ') got.pop_back();
+
+    printf("%6g sps %g wpm %g dB%s: %zu/%zu characters\n", sps, wpm, snr, matched ? " -mf" : "", chars, ends.size());
+    printf("  latency after the last mark p50 %.0f p90 %.0f p99 %.0f max %.0f ms (limit %.0f)\n", percentile(0.5), percentile(0.9), percentile(0.99), latency.empty() ? 0.0 : latency.back(), limit);
+    printf("  %llu allocations after the first second, %llu dropped\n", static_cast<unsigned long long>(allocations.load()), static_cast<unsigned long long>(live.GetDropped()));
+
+    bool ok = got == text && allocations.load() == 0 && live.GetDropped() == 0 && percentile(0.99) <= limit;
+    if (!ok) printf("FAIL got \"%s\"\n", got.c_str());
+    return ok;
+}
+
+/**
+* MorseLive in real time, Goertzel and -mf
+*
+* @return bool
+*/
+bool LiveLatency()
+{
+    bool ok = true;
+    if (!Run(8000.0, 25.0, 10.0, false)) ok = false;
+    if (!Run(48000.0, 30.0, 10.0, false)) ok = false;
+    if (!Run(44100.0, 20.0, 3.0, true)) ok = false;
+    return ok;
+}
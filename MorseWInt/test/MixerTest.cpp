@@ -0,0 +1,125 @@
+#include "morsetest.h"
+#include "../morse.h"
+#include "../morsemixer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/**
+* C++ MixerTest
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Mix of messages in double precision: amplitude * sin(phase + 2 PI tone t)
+* while a message is key down
+*
+* @param messages
+* @param sps
+* @param frames
+* @return vector
+*/
+static vector<double> Reference(const vector<MorseMixer::Message>& messages, double sps, size_t frames)
+{
+    const double PI = 3.14159265358979323846;
+    Morse m(true);
+    vector<double> out(frames, 0.0);
+    for (const MorseMixer::Message& message : messages)
+    {
+        string code = m.morse_encode(message.text);
+        MorseTiming timing(code.c_str());
+        uint64_t unit = MorseTiming::SamplesPerUnit(message.wpm, sps);
+        uint64_t at = static_cast<uint64_t>(message.start * sps + 0.5);
+        for (const KeyRun& r : timing.GetRuns())
+        {
+            uint64_t end = at + r.units * unit;
+            for (uint64_t k = at; r.key && k < end && k < frames; ++k)
+            {
+                out[k] += message.amplitude * sin(message.phase * PI / 180.0 + 2.0 * PI * message.tone * k / sps);
+            }
+            at = end;
+        }
+    }
+    return out;
+}
+
+/**
+* MorseMixer: the float mix of overlapping messages is their sum to float
+* precision, in blocks of any size, and the cost per frame grows
+* linearly with the number of messages
+*
+* @return bool
+*/
+bool MixerTest()
+{
+    const double sps = 48000.0;
+    const double MAX_ERROR = 1e-6;    // full scale 1.0
+    const double MAX_GROWTH = 1.5;    // per message cost at 256 messages over that at 64
+    bool ok = true;
+
+    // three messages that overlap, started mid block at odd phases
+    vector<MorseMixer::Message> messages =
+    {
+        { 700.0, 20.0, 0.3, 0.0, 0.0, "CQ CQ DE PA3XYZ K" },
+        { 1234.5, 33.0, 0.25, 0.37, 90.0, "TEST DE DL1ABC" },
+        { 3100.0, 12.0, 0.2, 1.01, 217.0, "QRL? 599" },
+    };
+    for (size_t block : { static_cast<size_t>(0), static_cast<size_t>(100), static_cast<size_t>(4097) })
+    {
+        MorseMixer mixer(sps, true);
+        for (const MorseMixer::Message& message : messages) mixer.Add(message);
+        vector<float> mix(mixer.GetFrameCount());
+        for (size_t at = 0; at < mix.size();)
+        {
+            at += mixer.Mix(mix.data() + at, block ? min(block, mix.size() - at) : mix.size());
+        }
+        vector<double> want = Reference(messages, sps, mix.size());
+        double error = 0.0;
+        for (size_t i = 0; i < mix.size(); ++i) error = max(error, fabs(mix[i] - want[i]));
+        printf("%zu messages, blocks of %4zu: %zu frames, max error %.2g of full scale\n",
+            messages.size(), block ? block : mix.size(), mix.size(), error);
+        if (error > MAX_ERROR) ok = false;
+    }
+
+    // random messages at 48 kHz, the same first ones for every count;
+    // best of five dithered renders
+    mt19937 random(44);
+    uniform_real_distribution<double> tone(300.0, 3500.0), wpm(12.0, 40.0), phase(0.0, 360.0);
+    vector<MorseMixer::Message> many;
+    for (int i = 0; i < 256; ++i)
+    {
+        many.push_back({ tone(random), wpm(random), 0.9 / 256.0, 0.0, phase(random), "CQ CQ DE PA3XYZ PA3XYZ K" });
+    }
+    double perMessage[3] = { 0.0 };
+    const int counts[] = { 16, 64, 256 };
+    for (int c = 0; c < 3; ++c)
+    {
+        MorseMixer mixer(sps, true);
+        for (int i = 0; i < counts[c]; ++i) mixer.Add(many[i]);
+        vector<int16_t> pcm(mixer.GetFrameCount());
+        double seconds = 0.0;
+        for (int pass = 0; pass < 5; ++pass)
+        {
+            mixer.Rewind();
+            auto start = chrono::steady_clock::now();
+            mixer.Render(pcm.data(), pcm.size(), true);
+            double t = Seconds(start);
+            if (pass == 0 || t < seconds) seconds = t;
+        }
+        double ns = seconds * 1e9 / pcm.size();
+        perMessage[c] = ns / counts[c];
+        printf("%3d messages: %6.1f ns/frame, %.2f ns/frame/message\n", counts[c], ns, perMessage[c]);
+    }
+    if (perMessage[2] > MAX_GROWTH * perMessage[1])
+    {
+        printf("FAIL cost per message grows from 64 to 256 messages\n");
+        ok = false;
+    }
+    return ok;
+}
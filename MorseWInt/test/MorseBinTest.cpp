@@ -0,0 +1,101 @@
+#include "morsetest.h"
+#include "../morsebin.h"
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+/**
+* C++ MorseBinTest
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Seek by word and by character in one container, every start and a
+* few lengths, against the text itself
+*
+* @param name
+* @param text - upper case, single spaces
+* @return bool
+*/
+static bool Seek(const char* name, const string& text)
+{
+    MorseBin encoded(true);
+    encoded.Encode(text);
+    // read back from the serialized container, as a loaded file
+    vector<uint8_t> bytes = encoded.GetBytes();
+    MorseBin bin(true);
+    bin.SetBytes(bytes.data(), bytes.size());
+
+    vector<string> words;
+    istringstream split(text);
+    for (string w; split >> w;) words.push_back(w);
+
+    int checks = 0;
+    int failed = 0;
+    if (bin.Decode() != text || bin.GetSymbolCount() != text.size() || bin.GetWordCount() != words.size())
+    {
+        failed++;
+        printf("FAIL %s: whole text\n", name);
+    }
+    for (uint32_t first = 0; first < words.size(); ++first)
+    {
+        for (uint32_t count : { 1u, 2u, 5u })
+        {
+            string want;
+            for (uint32_t w = first; w < words.size() && w < first + count; ++w)
+            {
+                if (!want.empty()) want += ' ';
+                want += words[w];
+            }
+            string got = bin.DecodeWords(first, count);
+            checks++;
+            if (got != want)
+            {
+                if (failed++ < 5) printf("FAIL %s: word %u count %u\n     want \"%s\"\n     got  \"%s\"\n", name, first, count, want.c_str(), got.c_str());
+            }
+        }
+    }
+    for (uint32_t first = 0; first < text.size(); ++first)
+    {
+        for (uint32_t count : { 1u, 7u, 300u })
+        {
+            // a character seek may start or end at a word space, the decode trims nothing else
+            string want = text.substr(first, count);
+            string got = bin.DecodeChars(first, count);
+            checks++;
+            if (got != want)
+            {
+                if (failed++ < 5) printf("FAIL %s: char %u count %u\n     want \"%s\"\n     got  \"%s\"\n", name, first, count, want.c_str(), got.c_str());
+            }
+        }
+    }
+    printf("%-28s %5zu symbols %3zu words %2zu index entries: %d of %d seeks exact\n", name, text.size(), words.size(),
+        (text.size() + MorseBin::INDEX_INTERVAL - 1) / MorseBin::INDEX_INTERVAL, checks - failed, checks);
+    return failed == 0;
+}
+
+/**
+* MorseBin: decode by word and by character through the sparse index,
+* with words that cross an index entry
+*
+* @return bool
+*/
+bool MorseBinTest()
+{
+    bool ok = true;
+    // the second word crosses symbol 256, the index entry there is inside it
+    ok &= Seek("long first word", string(250, 'E') + " ABCDEFGHIJKLMNOPQRST XYZ");
+
+    string qso;
+    while (qso.size() < 3 * MorseBin::INDEX_INTERVAL)
+    {
+        qso += "CQ CQ DE PA3XYZ PA3XYZ K UR RST 599 5NN NAME RAY QTH AMSTERDAM HW ? ";
+    }
+    qso += "73 SK";
+    ok &= Seek("qso, three index entries", qso);
+    return ok;
+}
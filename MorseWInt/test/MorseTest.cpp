@@ -0,0 +1,101 @@
+#include "morsetest.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/**
+* C++ MorseTest console program
+*
+* Runs every suite, or the ones named on the command line:
+* MorseTest.exe roundtrip wpm
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+struct Suite
+{
+    const char* name;
+    bool (*run)();
+};
+
+static const Suite suites[] =
+{
+    { "roundtrip", &RoundTripTest },
+    { "wpm", &WpmBenchmark },
+    { "snr", &SnrSweep },
+    { "live", &LiveLatency },
+    { "flac", &FlacRoundTrip },
+    { "codec", &CodecTest },
+    { "mbin", &MorseBinTest },
+    { "impair", &ImpairTest },
+    { "ramp", &RampTest },
+    { "firstsound", &FirstSoundTest },
+    { "sidetone", &SidetoneTest },
+    { "skimmer", &SkimmerTest },
+    { "beam", &BeamTest },
+    { "decimator", &DecimatorTest },
+    { "records", &RecordTest },
+    { "batch", &BatchTest },
+    { "mixer", &MixerTest },
+    { "player", &PlayerTest },
+};
+
+/**
+* Character error rate in percent
+*
+* @param got
+* @param want
+* @return double
+*/
+double Cer(const string& got, const string& want)
+{
+    vector<size_t> d(got.size() + 1);
+    for (size_t j = 0; j <= got.size(); ++j) d[j] = j;
+    for (size_t i = 1; i <= want.size(); ++i)
+    {
+        size_t diagonal = d[0];
+        d[0] = i;
+        for (size_t j = 1; j <= got.size(); ++j)
+        {
+            size_t up = d[j];
+            d[j] = min({ d[j] + 1, d[j - 1] + 1, diagonal + (want[i - 1] != got[j - 1] ? 1 : 0) });
+            diagonal = up;
+        }
+    }
+    return want.empty() ? 0.0 : 100.0 * d[got.size()] / want.size();
+}
+
+/**
+* Seconds since start
+*
+* @param start
+* @return double
+*/
+double Seconds(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    int failed = 0;
+    for (const Suite& s : suites)
+    {
+        bool chosen = (argc < 2);
+        for (int i = 1; i < argc; ++i)
+        {
+            if (strcmp(argv[i], s.name) == 0) chosen = true;
+        }
+        if (!chosen) continue;
+
+        printf("== %s\n", s.name);
+        bool ok = s.run();
+        printf("== %s: %s\n\n", s.name, ok ? "passed" : "FAILED");
+        if (!ok) failed++;
+    }
+    return failed;
+}
@@ -0,0 +1,116 @@
+#include "morsetest.h"
+#include "../morse.h"
+#include "../morseplayer.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+/**
+* C++ PlayerTest
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* MorsePlayer into a device paced NullSink: the clock holds still while
+* paused and goes on at real time pace after Resume, Stop ends playback
+* at once and early, a message played out reaches the sink whole; into a
+* WavSink the samples are those of a MorseRender
+*
+* @return bool
+*/
+bool PlayerTest()
+{
+    const double sps = 48000.0;
+    const double wpm = 25.0;
+    const double MAX_STOP = 20.0; // ms
+    Morse m(true);
+    string code = m.morse_encode("CQ CQ DE PA3XYZ PA3XYZ K");
+    bool ok = true;
+
+    // pause, resume and stop half way
+    {
+        NullSink sink(true);
+        MorsePlayer player(sink);
+        player.Play(code, 700.0, wpm, sps, 1);
+        this_thread::sleep_for(chrono::milliseconds(300));
+        player.Pause();
+        this_thread::sleep_for(chrono::milliseconds(20));
+        uint64_t held = player.GetPlayed();
+        this_thread::sleep_for(chrono::milliseconds(200));
+        uint64_t still = player.GetPlayed();
+        bool paused = player.IsPaused() && player.IsPlaying();
+
+        player.Resume();
+        auto resumed = chrono::steady_clock::now();
+        this_thread::sleep_for(chrono::milliseconds(200));
+        double pace = (player.GetPlayed() - still) / sps / Seconds(resumed);
+
+        auto start = chrono::steady_clock::now();
+        player.Stop();
+        double stop = Seconds(start) * 1000.0;
+        uint64_t played = player.GetPlayed();
+        printf("pause: %llu frames played, %lld more while paused; resume at %.2fx real time; stop in %.2f ms at %llu of %llu frames\n",
+            static_cast<unsigned long long>(held), static_cast<long long>(still - held), pace, stop,
+            static_cast<unsigned long long>(played), static_cast<unsigned long long>(player.GetFrameCount()));
+        if (!paused || held == 0 || still != held || pace < 0.5 || pace > 1.5)
+        {
+            printf("FAIL pause and resume\n");
+            ok = false;
+        }
+        if (stop > MAX_STOP || player.IsPlaying() || played >= player.GetFrameCount())
+        {
+            printf("FAIL stop\n");
+            ok = false;
+        }
+    }
+
+    // played out: every frame reaches the sink in about the length of the message
+    {
+        string shortCode = m.morse_encode("TEST");
+        NullSink sink(true);
+        MorsePlayer player(sink);
+        auto start = chrono::steady_clock::now();
+        player.Play(shortCode, 700.0, wpm, sps, 2);
+        player.Wait();
+        double seconds = Seconds(start);
+        double length = player.GetFrameCount() / sps;
+        printf("played out: %llu of %llu frames in %.3f s for %.3f s, %llu underruns\n",
+            static_cast<unsigned long long>(player.GetPlayed()), static_cast<unsigned long long>(player.GetFrameCount()),
+            seconds, length, static_cast<unsigned long long>(player.GetUnderruns()));
+        if (player.GetPlayed() != player.GetFrameCount() || seconds < length || player.IsPlaying()) ok = false;
+    }
+
+    // a file sink gets the samples of a whole render
+    {
+        const string path = "player.wav";
+        {
+            WavSink sink(path);
+            MorsePlayer player(sink);
+            player.Play(code, 700.0, wpm, sps, 1);
+            player.Wait();
+        }
+        MorseTiming timing(code.c_str());
+        ToneTable table(700.0, sps, 0.8);
+        MorseRender render(timing, table, wpm, 1);
+        vector<int16_t> want(render.GetFrameCount());
+        render.Render(want.data(), want.size());
+
+        ifstream in(path, ios::binary);
+        vector<char> bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        in.close();
+        remove(path.c_str());
+        const size_t header = 44;
+        bool same = bytes.size() == header + want.size() * sizeof(int16_t)
+            && memcmp(bytes.data() + header, want.data(), want.size() * sizeof(int16_t)) == 0;
+        printf("wav sink: %zu frames, samples %s\n", want.size(), same ? "exact" : "DIFFER");
+        if (!same) ok = false;
+    }
+    return ok;
+}
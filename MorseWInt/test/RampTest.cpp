@@ -0,0 +1,119 @@
+#include "morsetest.h"
+#include "../morse.h"
+#include "../morserender.h"
+#include <cstdio>
+#include <vector>
+
+/**
+* C++ RampTest
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Render a timeline in blocks of block frames, 0 = all in one go; the
+* renderer is rewound and run again, the best time of five counts
+*
+* @param timing
+* @param table
+* @param ramp - nullptr = hard keying
+* @param wpm
+* @param channels
+* @param block
+* @param seconds - best time of a render
+* @return vector
+*/
+static vector<int16_t> Render(const MorseTiming& timing, const ToneTable& table, const KeyRamp* ramp, double wpm, int channels, size_t block, double& seconds)
+{
+    MorseRender render(timing, table, wpm, channels);
+    render.SetRamp(ramp);
+    vector<int16_t> pcm(render.GetFrameCount() * channels);
+    size_t frames = pcm.size() / channels;
+    seconds = 0.0;
+    for (int pass = 0; pass < 5; ++pass)
+    {
+        render.Rewind();
+        auto start = chrono::steady_clock::now();
+        for (size_t at = 0; !render.Done();)
+        {
+            at += render.Render(pcm.data() + at * channels, block ? min(block, frames - at) : frames);
+        }
+        double t = Seconds(start);
+        if (pass == 0 || t < seconds) seconds = t;
+    }
+    return pcm;
+}
+
+/**
+* KeyRamp through MorseRender: shaped output is hard keying times the
+* ramp, bit for bit, whatever the block sizes and whether the edges come
+* from the edge cache or are multiplied
+*
+* @return bool
+*/
+bool RampTest()
+{
+    struct Case
+    {
+        const char* name;
+        double tone;
+        double sps;
+        double wpm;
+        int shape;
+        double rise;
+    };
+    const Case cases[] =
+    {
+        { "cached edges", 700.0, 8000.0, 20.0, RAMP_COSINE, 5.0 },
+        { "cached edges", 700.0, 48000.0, 40.0, RAMP_BLACKMAN, 5.0 },
+        { "short marks, coarse ramp", 700.0, 8000.0, 40.0, RAMP_COSINE, 20.0 },
+        { "more phases than MAX_EDGES", 701.0, 48000.0, 13.0, RAMP_COSINE, 5.0 },
+        { "no period table", 700.123456, 44100.0, 25.0, RAMP_BLACKMAN, 5.0 },
+    };
+    const size_t blocks[] = { 1000, 37 };
+
+    Morse m(true);
+    string text;
+    for (int i = 0; i < 4; ++i) text += "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789 CQ DE PA3XYZ ";
+    string code = m.morse_encode(text);
+    MorseTiming timing(code.c_str());
+    bool ok = true;
+    for (const Case& c : cases)
+    {
+        ToneTable table(c.tone, c.sps, 0.8);
+        Envelope envelope;
+        envelope.shape = c.shape;
+        envelope.rise = c.rise;
+        KeyRamp ramp(envelope, c.sps);
+        for (int channels = 1; channels <= 2; ++channels)
+        {
+            // hard keying, then every mark multiplied by the ramp on its own
+            double hardTime;
+            vector<int16_t> want = Render(timing, table, nullptr, c.wpm, channels, 0, hardTime);
+            uint64_t unit = MorseTiming::SamplesPerUnit(c.wpm, c.sps);
+            uint64_t at = 0;
+            for (const KeyRun& r : timing.GetRuns())
+            {
+                uint64_t length = r.units * unit;
+                if (r.key) ramp.Apply(want.data() + at * channels, 0, length, static_cast<size_t>(length), channels);
+                at += length;
+            }
+
+            double shapedTime;
+            int same = (Render(timing, table, &ramp, c.wpm, channels, 0, shapedTime) == want) ? 1 : 0;
+            for (size_t block : blocks)
+            {
+                double t;
+                if (Render(timing, table, &ramp, c.wpm, channels, block, t) == want) same++;
+            }
+            int renders = 1 + static_cast<int>(sizeof(blocks) / sizeof(blocks[0]));
+            printf("%-28s %-18s %5.0f sps %2.0f wpm %d ch: %d of %d renders exact, %+4.0f%% time over hard keying\n",
+                c.name, envelope.GetName().c_str(), c.sps, c.wpm, channels, same, renders, 100.0 * (shapedTime / hardTime - 1.0));
+            if (same != renders) ok = false;
+        }
+    }
+    return ok;
+}
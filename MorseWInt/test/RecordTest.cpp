@@ -0,0 +1,161 @@
+#include "morsetest.h"
+#include "../morse.h"
+#include "../morsedecoder.h"
+#include "../morserender.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+/**
+* C++ RecordTest
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Render code at 700 Hz after lead samples of silence, one second of
+* silence after the end
+*
+* @param timing
+* @param sps
+* @param wpm
+* @param lead
+* @return vector
+*/
+static vector<int16_t> Render(const MorseTiming& timing, double sps, double wpm, size_t lead)
+{
+    ToneTable table(700.0, sps, 0.5);
+    MorseRender render(timing, table, wpm, 1);
+    vector<int16_t> pcm(lead + render.GetFrameCount() + static_cast<size_t>(sps), 0);
+    render.Render(pcm.data() + lead, render.GetFrameCount());
+    return pcm;
+}
+
+/**
+* Decode in READ_FRAMES pieces, taking the records as they come
+*
+* @param decoder
+* @param pcm
+* @param records - nullptr = no records kept
+* @return double - seconds
+*/
+static double Decode(MorseDecoder& decoder, const vector<int16_t>& pcm, vector<CharRecord>* records)
+{
+    decoder.Reset(700.0);
+    decoder.KeepRecords(records != nullptr);
+    CharRecord r;
+    auto start = chrono::steady_clock::now();
+    for (size_t at = 0; at < pcm.size(); at += MorseDecoder::READ_FRAMES)
+    {
+        decoder.Process(pcm.data() + at, min(MorseDecoder::READ_FRAMES, pcm.size() - at));
+        while (records && decoder.NextRecord(r)) records->push_back(r);
+    }
+    decoder.Finish();
+    while (records && decoder.NextRecord(r)) records->push_back(r);
+    return Seconds(start);
+}
+
+/**
+* MorseDecoder character records: the right characters, marks within a
+* detector block of where they were sent, high confidence on a clean signal, a
+* JSON line each in the log, and at most a few percent slower
+*
+* @return bool
+*/
+bool RecordTest()
+{
+    const double wpm = 20.0;
+    const double MAX_OVERHEAD = 5.0; // percent
+    // a mark is found to a detector block, a quarter unit at MAX_WPM, and
+    // the delays of the front end are taken off to within a sample or so
+    const double MAX_ERROR = 1000.0 * 1.2 / MorseDecoder::MAX_WPM / MorseDecoder::BLOCKS_PER_UNIT + 1.5; // ms
+    const string text = "CQ CQ DE PA3XYZ PA3XYZ K THE QUICK BROWN FOX 599";
+    Morse m(true);
+    string code = m.morse_encode(text);
+    MorseTiming timing(code.c_str());
+    bool ok = true;
+
+    for (double sps : { 8000.0, 48000.0 })
+    {
+        size_t lead = static_cast<size_t>(sps / 2.0);
+        vector<int16_t> pcm = Render(timing, sps, wpm, lead);
+
+        // characters as sent: first mark start to last mark end
+        vector<pair<uint64_t, uint64_t>> sent;
+        uint64_t unit = MorseTiming::SamplesPerUnit(wpm, sps);
+        uint64_t at = lead;
+        bool open = false;
+        for (const KeyRun& r : timing.GetRuns())
+        {
+            if (r.key && !open) sent.push_back({ at, 0 });
+            if (r.key) sent.back().second = at + r.units * unit;
+            open = r.key || (open && r.units < 3);
+            at += r.units * unit;
+        }
+
+        MorseDecoder decoder(700.0, sps, wpm, true);
+        vector<CharRecord> records;
+        Decode(decoder, pcm, &records);
+
+        string got;
+        double error = 0.0, confidence = 0.0;
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            got += records[i].text;
+            confidence += records[i].confidence;
+            if (i < sent.size())
+            {
+                error = max(error, fabs(static_cast<double>(records[i].start) - sent[i].first));
+                error = max(error, fabs(static_cast<double>(records[i].end) - sent[i].second));
+            }
+        }
+        string want = text;
+        want.erase(remove(want.begin(), want.end(), ' '), want.end());
+        error *= 1000.0 / sps;
+        confidence /= max<size_t>(records.size(), 1);
+        printf("%5.0f sps: %zu of %zu characters, text %s, timing error max %.2f ms, confidence %.2f\n",
+            sps, records.size(), sent.size(), (got == want) ? "exact" : "DIFFERS", error, confidence);
+        if (got != want || records.size() != sent.size() || error > MAX_ERROR || confidence < 0.9) ok = false;
+
+        // one JSON line per record
+        const string path = "records.jsonl";
+        {
+            MorseCharLog log(path, CHARLOG_JSONL, sps);
+            for (const CharRecord& r : records) log.Add(r);
+        }
+        ifstream in(path);
+        size_t lines = count(istreambuf_iterator<char>(in), istreambuf_iterator<char>(), '\n');
+        in.close();
+        remove(path.c_str());
+        if (lines != records.size())
+        {
+            printf("FAIL %zu JSON lines for %zu records\n", lines, records.size());
+            ok = false;
+        }
+
+        // overhead on half an hour: runs with and without records in turn,
+        // the median of nine pairs, so a slow moment spoils one pair only
+        vector<int16_t> longer;
+        while (longer.size() < static_cast<size_t>(1800.0 * sps)) longer.insert(longer.end(), pcm.begin(), pcm.end());
+        vector<double> ratios;
+        double plain = 0.0;
+        for (int pass = 0; pass < 9; ++pass)
+        {
+            records.clear();
+            double t = Decode(decoder, longer, nullptr);
+            ratios.push_back(Decode(decoder, longer, &records) / t);
+            if (pass == 0 || t < plain) plain = t;
+        }
+        nth_element(ratios.begin(), ratios.begin() + ratios.size() / 2, ratios.end());
+        double overhead = 100.0 * (ratios[ratios.size() / 2] - 1.0);
+        printf("%5.0f sps: 30 min decoded in %.1f ms, with %zu records %+.1f%%\n",
+            sps, plain * 1000.0, records.size(), overhead);
+        if (overhead > MAX_OVERHEAD) ok = false;
+    }
+    return ok;
+}
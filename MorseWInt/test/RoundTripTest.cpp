@@ -0,0 +1,130 @@
+#include "morsetest.h"
+#include "../morsewav.h"
+#include "../morsestream.h"
+#include "../morsedecoder.h"
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+/**
+* C++ RoundTripTest
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Render every text with MorseWav at every rate, speed and channel count,
+* read the file back with MorseDecoder and compare text and morse code
+*
+* @return bool
+*/
+bool RoundTripTest()
+{
+    const char* texts[] =
+    {
+        "PARIS PARIS",
+        "CQ CQ DE PA3XYZ PA3XYZ K",
+        "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789 ?/=",
+    };
+    const double rates[] = { 8000.0, 44100.0, 48000.0 };
+    const double speeds[] = { 5.0, 12.0, 20.0, 35.0, 50.0 };
+    const int channels[] = { 1, 2 };
+    const double tone = 880.0;
+    const double MIN_SPEED = 100.0; // decoder speed, times real time
+
+    Morse m(true);
+    int cases = 0;
+    int failed = 0;
+    int slow = 0;
+    for (double sps : rates)
+    {
+        for (double wpm : speeds)
+        {
+            double audio = 0.0;
+            double elapsed = 0.0;
+            for (int ch : channels)
+            {
+                for (const char* text : texts)
+                {
+                    string code = m.morse_encode(text);
+                    string path;
+                    {
+                        // MorseWav reports every file on cout and the save directory on cerr
+                        ostringstream report;
+                        streambuf* console = cout.rdbuf(report.rdbuf());
+                        streambuf* errors = cerr.rdbuf(report.rdbuf());
+                        MorseWav wav(code.c_str(), tone, wpm, sps, ch, false);
+                        cerr.rdbuf(errors);
+                        cout.rdbuf(console);
+                        path = wav.GetFullPath();
+                    }
+                    string gotText;
+                    string gotCode;
+                    {
+                        MorseWavReader reader(path);
+                        MorseDecoder decoder(tone, reader.GetSps(), wpm, true);
+                        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+                        decoder.Decode(reader);
+                        elapsed += Seconds(start);
+                        audio += reader.GetFrameCount() / sps;
+                        gotText = decoder.GetText();
+                        gotCode = decoder.GetMorseCode();
+                    }
+                    remove(path.c_str());
+
+                    cases++;
+                    if (gotText != text || gotCode != code)
+                    {
+                        failed++;
+                        printf("FAIL %g sps %g wpm %d ch: \"%s\"\n     got \"%s\"\n", sps, wpm, ch, text, gotText.c_str());
+                    }
+                }
+            }
+            double speed = audio / elapsed;
+            printf("%6g sps %3g wpm: %.0fx real time\n", sps, wpm, speed);
+            if (speed < MIN_SPEED)
+            {
+                slow++;
+                printf("FAIL %g sps %g wpm: decoded below %gx real time\n", sps, wpm, MIN_SPEED);
+            }
+        }
+    }
+
+    // -stdout: an open ended data chunk, read to the end of the file
+    for (int ch : channels)
+    {
+        string code = m.morse_encode(texts[1]);
+        const char* path = "roundtrip_stream.wav";
+        uint64_t written = 0;
+        FILE* out = fopen(path, "wb");
+        if (out)
+        {
+            MorseStream stream(code.c_str(), tone, 20.0, 8000.0, ch, false, out);
+            written = stream.GetPcmCount();
+            fclose(out);
+        }
+        uint64_t frames = 0;
+        string gotText;
+        {
+            MorseWavReader reader(path);
+            MorseDecoder decoder(tone, reader.GetSps(), 20.0, true);
+            frames = reader.GetFrameCount();
+            decoder.Decode(reader);
+            gotText = decoder.GetText();
+        }
+        remove(path);
+
+        cases++;
+        if (written == 0 || frames != written || gotText != texts[1])
+        {
+            failed++;
+            printf("FAIL streamed wav %d ch: %llu of %llu frames, got \"%s\"\n", ch,
+                static_cast<unsigned long long>(frames), static_cast<unsigned long long>(written), gotText.c_str());
+        }
+    }
+    printf("%d of %d round trips exact\n", cases - failed, cases);
+    return failed == 0 && slow == 0;
+}
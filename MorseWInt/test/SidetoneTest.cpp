@@ -0,0 +1,88 @@
+#include "morsetest.h"
+#include "../morse.h"
+#include "../morsesidetone.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+/**
+* C++ SidetoneTest
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* MorseSidetone: keystroke to first sample under 10 ms into a device
+* paced sink, and the characters sent one by one are the samples of a
+* whole-text render
+*
+* @return bool
+*/
+bool SidetoneTest()
+{
+    const double sps = 48000.0;
+    const double wpm = 30.0;
+    const double MAX_LATENCY = 10.0; // ms
+    const string text = "CQ DE PA3XYZ K";
+    Morse m(true);
+    bool ok = true;
+
+    // typed one at a time with pauses, and typed ahead in one go; the
+    // device buffer holds 10 ms like a small sound card buffer
+    for (int ahead = 0; ahead < 2; ++ahead)
+    {
+        NullSink sink(true, static_cast<size_t>(sps / 100.0));
+        MorseSidetone sidetone(sink, 700.0, wpm, sps, true);
+        sidetone.Start();
+        for (char c : text)
+        {
+            sidetone.Key(c);
+            if (!ahead)
+            {
+                sidetone.Drain();
+                this_thread::sleep_for(chrono::milliseconds(5));
+            }
+        }
+        sidetone.Drain();
+        sidetone.Stop();
+        printf("%-11s %2llu of %zu characters sent, latency last %5.2f ms, max %5.2f ms\n", ahead ? "typed ahead" : "typed",
+            static_cast<unsigned long long>(sidetone.GetSent()), text.size(), sidetone.GetLastLatency(), sidetone.GetMaxLatency());
+        if (sidetone.GetSent() != text.size() || sidetone.GetMaxLatency() >= MAX_LATENCY) ok = false;
+    }
+
+    // the file has what a MorseRender of the whole text gives, every
+    // character followed by its letter space
+    const string path = "sidetone.wav";
+    {
+        WavSink sink(path);
+        MorseSidetone sidetone(sink, 700.0, wpm, sps, true);
+        sidetone.Start();
+        for (char c : text) sidetone.Key(c);
+        sidetone.Drain();
+        sidetone.Stop();
+    }
+    string code = m.morse_encode(text) + " ";
+    MorseTiming timing(code.c_str());
+    ToneTable table(700.0, sps, 0.8);
+    MorseRender render(timing, table, wpm, 1);
+    vector<int16_t> want(render.GetFrameCount());
+    render.Render(want.data(), want.size());
+
+    ifstream in(path, ios::binary);
+    vector<char> bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    in.close();
+    remove(path.c_str());
+    const size_t header = 44;
+    bool same = bytes.size() == header + want.size() * sizeof(int16_t)
+        && memcmp(bytes.data() + header, want.data(), want.size() * sizeof(int16_t)) == 0;
+    printf("wav capture %zu frames, whole-text render %zu frames, samples %s\n",
+        bytes.size() > header ? (bytes.size() - header) / sizeof(int16_t) : 0, want.size(), same ? "exact" : "DIFFER");
+    if (!same) ok = false;
+    return ok;
+}
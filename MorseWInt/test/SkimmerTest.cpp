@@ -0,0 +1,96 @@
+#include "morsetest.h"
+#include "../morsemixer.h"
+#include "../morseskimmer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/**
+* C++ SkimmerTest
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* MorseSkimmer on 50 hard keyed signals 150 Hz apart at 48 kHz with white
+* noise: every signal found on its tone, decoded with a low character
+* error rate, at many times real time on one core
+*
+* @return bool
+*/
+bool SkimmerTest()
+{
+    const double sps = 48000.0;
+    const int SIGNALS = 50;
+    const double MAX_CER = 3.0;        // percent, over all signals
+    const double MIN_REALTIME = 10.0;  // times real time
+    const char* calls[] = { "PA3XYZ", "DL1ABC", "G4KLM", "W1AW", "JA1XYZ", "VK2DEF", "F5GHI", "OH2JKL", "SM5MNO", "I2PQR" };
+
+    MorseMixer mixer(sps, true);
+    vector<string> want(SIGNALS);
+    vector<double> tones(SIGNALS);
+    for (int i = 0; i < SIGNALS; ++i)
+    {
+        MorseMixer::Message message;
+        message.tone = 400.0 + 150.0 * i;
+        message.wpm = 15.0 + (i * 7) % 26;
+        message.amplitude = 0.015;
+        message.start = 0.1 * (i % 10);
+        message.phase = 37.0 * i;
+        message.text = string("CQ CQ DE ") + calls[i % 10] + " " + calls[i % 10] + " K";
+        mixer.Add(message);
+        want[i] = message.text;
+        tones[i] = message.tone;
+    }
+    vector<int16_t> pcm(mixer.GetFrameCount() + static_cast<size_t>(sps), 0);
+    mixer.Render(pcm.data(), mixer.GetFrameCount(), false);
+    mt19937 random(50);
+    normal_distribution<double> normal(0.0, 0.002 * 32767.0);
+    for (int16_t& s : pcm) s = static_cast<int16_t>(max(-32768.0, min(32767.0, s + normal(random))));
+    double length = pcm.size() / sps;
+
+    // best of three, the signals come from the last pass
+    double seconds = 0.0;
+    vector<MorseSkimmer::Signal> signals;
+    for (int pass = 0; pass < 3; ++pass)
+    {
+        MorseSkimmer skimmer(sps, 25.0, true);
+        auto start = chrono::steady_clock::now();
+        for (size_t at = 0; at < pcm.size(); at += MorseSkimmer::READ_FRAMES)
+        {
+            skimmer.Process(pcm.data() + at, min(MorseSkimmer::READ_FRAMES, pcm.size() - at));
+        }
+        skimmer.Finish();
+        double t = Seconds(start);
+        if (pass == 0 || t < seconds) seconds = t;
+        signals = skimmer.GetSignals();
+    }
+
+    // every tone must be found within half a channel, its text scored
+    int found = 0;
+    double errors = 0.0;
+    size_t characters = 0;
+    for (int i = 0; i < SIGNALS; ++i)
+    {
+        const MorseSkimmer::Signal* hit = nullptr;
+        for (const MorseSkimmer::Signal& s : signals)
+        {
+            if (fabs(s.tone - tones[i]) < 0.5 * MorseSkimmer::BIN_HZ) hit = &s;
+        }
+        string got = hit ? hit->text : "";
+        if (hit) found++;
+        else printf("FAIL %.0f Hz not found\n", tones[i]);
+        errors += Cer(got, want[i]) * want[i].size();
+        characters += want[i].size();
+    }
+    double cer = errors / characters;
+    double realtime = length / seconds;
+    printf("%d signals, %.1f s at %.0f sps: %d found, %zu reported, CER %.2f%%, %.0fx real time\n",
+        SIGNALS, length, sps, found, signals.size(), cer, realtime);
+    return found == SIGNALS && signals.size() == static_cast<size_t>(SIGNALS) && cer <= MAX_CER && realtime >= MIN_REALTIME;
+}
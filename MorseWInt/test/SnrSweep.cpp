@@ -0,0 +1,155 @@
+#include "morsetest.h"
+#include "../morserender.h"
+#include "../morsedecoder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+/**
+* C++ SnrSweep
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Render text at 700 Hz with white noise of snr dB in 2.5 kHz, one second
+* of noise after the end
+*
+* @param text
+* @param sps
+* @param wpm
+* @param snr
+* @param random
+* @return vector<int16_t>
+*/
+static vector<int16_t> Noisy(const string& text, double sps, double wpm, double snr, mt19937& random)
+{
+    const double amplitude = 0.25 * 32767.0;
+    Morse m(true);
+    string code = m.morse_encode(text);
+    MorseTiming timing(code.c_str());
+    ToneTable table(700.0, sps, 0.25);
+    MorseRender render(timing, table, wpm, 1);
+    vector<int16_t> pcm(render.GetFrameCount() + static_cast<size_t>(sps), 0);
+    render.Render(pcm.data(), render.GetFrameCount());
+
+    // noise power over the whole band, scaled from the 2.5 kHz the snr is given in
+    double sigma = amplitude / sqrt(2.0 * pow(10.0, snr / 10.0) * 2500.0 / (sps / 2.0));
+    normal_distribution<double> normal(0.0, sigma);
+    for (int16_t& s : pcm)
+    {
+        s = static_cast<int16_t>(max(-32768.0, min(32767.0, s + normal(random))));
+    }
+    return pcm;
+}
+
+/**
+* Decode with the Goertzel blocks or the matched filter
+*
+* @param pcm
+* @param sps
+* @param wpm
+* @param matched
+* @return string
+*/
+static string Decode(const vector<int16_t>& pcm, double sps, double wpm, bool matched)
+{
+    MorseDecoder decoder(700.0, sps, wpm, true, matched);
+    decoder.Process(pcm.data(), pcm.size());
+    decoder.Finish();
+    return decoder.GetText();
+}
+
+/**
+* Character error rate against SNR, Goertzel and -mf, at 8 kHz and at
+* 44.1 kHz where both run on the decimated baseband
+*
+* @return bool
+*/
+bool SnrSweep()
+{
+    const char* texts[] =
+    {
+        "CQ CQ DE PA3XYZ PA3XYZ K",
+        "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 1234567890",
+        "UR RST 579 579 NAME RAY QTH AMSTERDAM HW CPY",
+        "TNX FER QSO 73 ES GL DE K1ABC SK",
+    };
+    const int TRIALS = 3;
+    const double wpm = 20.0;
+
+    // highest character error rate in percent allowed at an SNR and above,
+    // with room for another normal_distribution
+    struct Limit
+    {
+        double snr;
+        double goertzel;
+        double matched;
+    };
+    const Limit limits[] = { { 6.0, 2.0, 2.0 }, { 0.0, 100.0, 5.0 }, { -4.0, 100.0, 10.0 } };
+
+    bool ok = true;
+    for (double sps : { 8000.0, 44100.0 })
+    {
+        // the same noise for every run of the sweep
+        mt19937 random(3);
+        printf("%g sps %g wpm\n SNR(2.5 kHz)  Goertzel     -mf\n", sps, wpm);
+        for (double snr = 10.0; snr >= -10.0; snr -= 2.0)
+        {
+            size_t chars = 0;
+            double goertzel = 0.0;
+            double matched = 0.0;
+            for (int trial = 0; trial < TRIALS; ++trial)
+            {
+                for (const char* text : texts)
+                {
+                    vector<int16_t> pcm = Noisy(text, sps, wpm, snr, random);
+                    size_t n = strlen(text);
+                    goertzel += min(100.0, Cer(Decode(pcm, sps, wpm, false), text)) * n;
+                    matched += min(100.0, Cer(Decode(pcm, sps, wpm, true), text)) * n;
+                    chars += n;
+                }
+            }
+            goertzel /= chars;
+            matched /= chars;
+            printf(" %8.0f dB   %6.1f%%  %6.1f%%\n", snr, goertzel, matched);
+            for (const Limit& limit : limits)
+            {
+                if (snr >= limit.snr && (goertzel > limit.goertzel || matched > limit.matched))
+                {
+                    printf("FAIL above the limit of %.0f dB\n", limit.snr);
+                    ok = false;
+                    break;
+                }
+            }
+        }
+
+        // throughput on 10 minutes of 10 dB signal, in blocks as dw reads them
+        vector<int16_t> audio;
+        while (audio.size() < sps * 600.0)
+        {
+            vector<int16_t> pcm = Noisy(texts[1], sps, wpm, 10.0, random);
+            audio.insert(audio.end(), pcm.begin(), pcm.end());
+        }
+        for (bool mf : { false, true })
+        {
+            MorseDecoder decoder(700.0, sps, wpm, true, mf);
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            for (size_t at = 0; at < audio.size(); at += MorseDecoder::READ_FRAMES)
+            {
+                decoder.Process(audio.data() + at, min(MorseDecoder::READ_FRAMES, audio.size() - at));
+            }
+            decoder.Finish();
+            double elapsed = Seconds(start);
+            printf("%s: %.0fx real time, %.2f s per hour\n", mf ? "-mf" : "Goertzel", audio.size() / sps / elapsed, elapsed * 3600.0 * sps / audio.size());
+        }
+        printf("\n");
+    }
+    return ok;
+}
@@ -0,0 +1,154 @@
+#define _USE_MATH_DEFINES // Required for MSVC/Windows
+#include "morsetest.h"
+#include "../morserender.h"
+#include "../morsedecoder.h"
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+/**
+* C++ WpmBenchmark
+*
+* @author Ray Colt <ray_colt@pentagon.mil>
+* @copyright Copyright (c) 1978, 2026 Ray Colt
+* @license MIT License
+**/
+using namespace std;
+
+/**
+* Key morse code at a speed that changes with time, each run stretched by
+* a random factor around 1 (hand keying), MorseWav spacing
+*
+* @param code
+* @param sps
+* @param tone
+* @param wpmAt - speed at a time in seconds
+* @param jitter - standard deviation of the run length, 0.1 = 10%
+* @param random
+* @return vector<int16_t>
+*/
+static vector<int16_t> Key(const string& code, double sps, double tone, const function<double(double)>& wpmAt, double jitter, mt19937& random)
+{
+    vector<int16_t> pcm;
+    normal_distribution<double> normal;
+    double phase = 0.0;
+    const double step = 2.0 * M_PI * tone / sps;
+    auto run = [&](bool down, double units)
+    {
+        double wpm = wpmAt(pcm.size() / sps);
+        double stretch = max(0.3, 1.0 + jitter * normal(random));
+        size_t n = static_cast<size_t>(units * stretch * 1.2 / wpm * sps);
+        for (size_t i = 0; i < n; ++i)
+        {
+            pcm.push_back(down ? static_cast<int16_t>(26000.0 * sin(phase)) : 0);
+            if (down) phase += step;
+        }
+    };
+    run(false, 7.0);
+    for (char c : code)
+    {
+        if (c == '.') { run(true, 1.0); run(false, 1.0); }
+        else if (c == '-') { run(true, 3.0); run(false, 1.0); }
+        else run(false, 2.0);
+    }
+    run(false, 7.0);
+    return pcm;
+}
+
+/**
+* Decode pcm, print character error rate and speed
+*
+* @param name
+* @param pcm
+* @param sps
+* @param hint - starting speed given to the decoder
+* @param text
+* @param end - set to the speed the decoder ended at
+* @return double - character error rate in percent
+*/
+static double Measure(const char* name, const vector<int16_t>& pcm, double sps, double hint, const string& text, double& end)
+{
+    MorseDecoder decoder(700.0, sps, hint, true);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    decoder.Process(pcm.data(), pcm.size());
+    decoder.Finish();
+    double elapsed = Seconds(start);
+    double cer = Cer(decoder.GetText(), text);
+    end = decoder.GetWpm();
+    printf("%6g sps %-30s CER %5.1f%%  %6.0fx real time  end %4.1f wpm\n", sps, name, cer, pcm.size() / sps / elapsed, end);
+    return cer;
+}
+
+/**
+* Decoder speed tracking: fixed speeds with right and wrong -wpm hints,
+* ramps, sinusoidal drift and jittered hand keying
+*
+* @return bool
+*/
+bool WpmBenchmark()
+{
+    const string text = "CQ CQ DE PA3XYZ PARIS 73 THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789 ?/= THE END";
+    const double rates[] = { 8000.0, 44100.0 };
+
+    Morse m(true);
+    string code = m.morse_encode(text);
+    mt19937 random(5);
+    bool ok = true;
+
+    for (double sps : rates)
+    {
+        // fixed speeds, rendered by MorseRender, must decode without errors
+        for (double wpm : { 5.0, 10.0, 20.0, 33.0, 50.0 })
+        {
+            MorseTiming timing(code.c_str());
+            ToneTable table(700.0, sps, 0.8);
+            MorseRender render(timing, table, wpm, 1);
+            vector<int16_t> pcm(render.GetFrameCount());
+            render.Render(pcm.data(), pcm.size());
+            for (double hint : { 5.0, 20.0, 50.0 })
+            {
+                char name[64];
+                snprintf(name, sizeof(name), "fixed %g wpm, hint %g", wpm, hint);
+                double end;
+                if (Measure(name, pcm, sps, hint, text, end) > 0.0) ok = false;
+            }
+        }
+
+        // length of the text at 20 wpm, the time scale of the changes
+        double T = Key(code, sps, 700.0, [](double) { return 20.0; }, 0.0, random).size() / sps;
+        struct Case
+        {
+            const char* name;
+            function<double(double)> wpmAt;
+            double jitter;
+            double maxCer; // percent, above it the case fails
+            double endWpm; // speed at the end of the text, 0 = not checked
+        };
+        // the jitter comes from the library's normal_distribution, the
+        // limits leave room for another implementation
+        const Case cases[] =
+        {
+            { "ramp 5 -> 50 wpm", [T](double t) { return 5.0 + 45.0 * min(1.0, t / (T * 0.4)); }, 0.0, 2.0, 50.0 },
+            { "ramp 50 -> 5 wpm", [T](double t) { return 50.0 - 45.0 * min(1.0, t / (T * 0.4)); }, 0.0, 2.0, 5.0 },
+            { "sine 10 .. 45 wpm", [](double t) { return 27.5 + 17.5 * sin(t * 0.5); }, 0.0, 8.0, 0.0 },
+            { "hand 20 wpm, jitter 10%", [](double) { return 20.0; }, 0.10, 4.0, 20.0 },
+            { "hand 25 wpm, jitter 20%", [](double) { return 25.0; }, 0.20, 20.0, 25.0 },
+            { "hand 12 -> 40 wpm, jitter 15%", [T](double t) { return 12.0 + 28.0 * min(1.0, t / (T * 0.6)); }, 0.15, 8.0, 40.0 },
+        };
+        for (const Case& c : cases)
+        {
+            vector<int16_t> pcm = Key(code, sps, 700.0, c.wpmAt, c.jitter, random);
+            double end;
+            if (Measure(c.name, pcm, sps, 20.0, text, end) > c.maxCer) ok = false;
+            // the speed estimate must have followed the keying, within 10%
+            if (c.endWpm > 0.0 && fabs(end - c.endWpm) > 0.1 * c.endWpm)
+            {
+                printf("FAIL %s: ended at %.1f wpm, keyed %g wpm\n", c.name, end, c.endWpm);
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
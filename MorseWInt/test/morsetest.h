@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+/**
+* MorseTest: console checks and benchmarks of the portable sources, no
+* GUI and no Main.cpp. Every suite prints its figures and returns false
+* when a check fails.
+*/
+
+/**
+* MorseWav render and MorseDecoder read back, text must be exact
+*/
+bool RoundTripTest();
+
+/**
+* Decoder speed tracking, character error rate and speed per case
+*/
+bool WpmBenchmark();
+
+/**
+* Goertzel and matched filter character error rate against SNR
+*/
+bool SnrSweep();
+
+/**
+* MorseLive fed at real time pace: latency percentiles, allocations, drops
+*/
+bool LiveLatency();
+
+/**
+* FlacEncoder stream decoded again, samples and STREAMINFO must be exact
+*/
+bool FlacRoundTrip();
+
+/**
+* MorseCodec G.711 codes and IMA ADPCM block layout
+*/
+bool CodecTest();
+
+/**
+* MorseBin seeks by word and by character across index entries
+*/
+bool MorseBinTest();
+
+/**
+* MorseImpair samples the same across block sizes, noise power at its SNR
+*/
+bool ImpairTest();
+
+/**
+* KeyRamp shaped marks bit exact against hard keying times the ramp
+*/
+bool RampTest();
+
+/**
+* MorseWav PCM16 played while written: time to first sound, file samples
+*/
+bool FirstSoundTest();
+
+/**
+* MorseSidetone keystroke to first sample latency, samples against a whole render
+*/
+bool SidetoneTest();
+
+/**
+* MorseSkimmer on 50 signals: tones found, character error rate, speed
+*/
+bool SkimmerTest();
+
+/**
+* MorseBeam against the greedy classifier on jittered runs, character error rate
+*/
+bool BeamTest();
+
+/**
+* MorseDecimator passband ripple and alias rejection
+*/
+bool DecimatorTest();
+
+/**
+* MorseDecoder character records: timing error, confidence, overhead
+*/
+bool RecordTest();
+
+/**
+* MorseBatch results in file order and as decoded alone, per thread count
+*/
+bool BatchTest();
+
+/**
+* MorseMixer sum against a double reference, cost against the number of messages
+*/
+bool MixerTest();
+
+/**
+* MorsePlayer pause, resume and stop against the sink clock, samples played
+*/
+bool PlayerTest();
+
+/**
+* Character error rate in percent, Levenshtein distance over the length of want
+*
+* @param got
+* @param want
+*/
+double Cer(const std::string& got, const std::string& want);
+
+/**
+* Seconds since start
+*
+* @param start
+*/
+double Seconds(std::chrono::steady_clock::time_point start);